@@ -40,22 +40,39 @@
 
 #define MAX_OPENCNT       (255)                  /* Limit of uint8_t */
 
+#define BCH_NOSECTOR      ((size_t)-1)           /* Unused cache entry */
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
+/* One entry of the sector cache */
+
+struct bch_sector_s
+{
+  size_t sector;           /* The sector in the buffer */
+  uint32_t stamp;          /* LRU clock value of the last access */
+  bool dirty;              /* true: Data has been written to the buffer */
+  FAR uint8_t *buffer;     /* One sector buffer */
+};
+
 struct bchlib_s
 {
   FAR struct inode *inode; /* I-node of the block driver */
   uint32_t sectsize;       /* The size of one sector on the device */
   size_t nsectors;         /* Number of sectors supported by the device */
-  size_t sector;           /* The current sector in the buffer */
   mutex_t lock;            /* For atomic accesses to this structure */
   uint8_t refs;            /* Number of references */
-  bool dirty;              /* true: Data has been written to the buffer */
   bool readonly;           /* true: Only read operations are supported */
   bool unlinked;           /* true: The driver has been unlinked */
-  FAR uint8_t *buffer;     /* One sector buffer */
+  FAR struct bch_sector_s *cur;   /* The most recently accessed sector */
+  FAR struct bch_sector_s *cache; /* The sector cache */
+  FAR uint8_t *buffer;     /* Sector buffers of the cache entries */
+  size_t ncache;           /* Number of entries in the sector cache */
+  size_t lastmiss;         /* Last sector read from the media */
+  uint32_t stamp;          /* LRU clock */
+  uint32_t hits;           /* Number of cache hits */
+  uint32_t misses;         /* Number of cache misses */
 
 #if defined(CONFIG_BCH_ENCRYPTION)
   uint8_t key[CONFIG_BCH_ENCRYPTION_KEY_SIZE];  /* Encryption key */
@@ -82,7 +99,12 @@ EXTERN const struct file_operations g_bch_fops;
  ****************************************************************************/
 
 EXTERN int  bchlib_flushsector(FAR struct bchlib_s *bch, bool discard);
+EXTERN int  bchlib_flushrange(FAR struct bchlib_s *bch, size_t sector,
+                              size_t nsectors);
+EXTERN void bchlib_discardrange(FAR struct bchlib_s *bch, size_t sector,
+                                size_t nsectors);
 EXTERN int  bchlib_readsector(FAR struct bchlib_s *bch, size_t sector);
+EXTERN int  bchlib_setcache(FAR struct bchlib_s *bch, size_t ncache);
 
 #undef EXTERN
 #if defined(__cplusplus)
@@ -428,6 +428,43 @@ static int bch_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         }
         break;
 
+      /* Resize the sector cache */
+
+      case BIOC_CACHESIZE:
+        {
+          ret = nxmutex_lock(&bch->lock);
+          if (ret >= 0)
+            {
+              ret = bchlib_setcache(bch, (size_t)arg);
+              nxmutex_unlock(&bch->lock);
+            }
+        }
+        break;
+
+      /* Return the sector cache statistics */
+
+      case BIOC_CACHESTAT:
+        {
+          FAR struct bch_cachestat_s *stat =
+            (FAR struct bch_cachestat_s *)((uintptr_t)arg);
+
+          if (stat == NULL)
+            {
+              ret = -EINVAL;
+              break;
+            }
+
+          ret = nxmutex_lock(&bch->lock);
+          if (ret >= 0)
+            {
+              stat->nsectors = bch->ncache;
+              stat->hits     = bch->hits;
+              stat->misses   = bch->misses;
+              nxmutex_unlock(&bch->lock);
+            }
+        }
+        break;
+
 #ifdef CONFIG_BCH_ENCRYPTION
       /* This is a request to set the encryption key? */
 
@@ -26,10 +26,13 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <limits.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
 
+#include <nuttx/kmalloc.h>
+
 #include "bch.h"
 
 #if defined(CONFIG_BCH_ENCRYPTION)
@@ -59,10 +62,11 @@ static void bch_xor(uint32_t *R, uint32_t *A, uint32_t *B)
  ****************************************************************************/
 
 #if defined(CONFIG_BCH_ENCRYPTION)
-static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
+static int bch_cypher(FAR struct bchlib_s *bch,
+                      FAR struct bch_sector_s *entry, int encrypt)
 {
   int blocks = bch->sectsize / 16;
-  FAR uint32_t *buffer = (FAR uint32_t *)bch->buffer;
+  FAR uint32_t *buffer = (FAR uint32_t *)entry->buffer;
   int i;
 
   for (i = 0; i < blocks; i++, buffer += 16 / sizeof(uint32_t) )
@@ -70,7 +74,7 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
       uint32_t T[4];
       uint32_t X[4] =
       {
-        bch->sector, 0, 0, i
+        entry->sector, 0, 0, i
       };
 
       aes_cypher(X, X, 16, NULL, bch->key, CONFIG_BCH_ENCRYPTION_KEY_SIZE,
@@ -89,74 +93,356 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
 #endif
 
 /****************************************************************************
- * Public Functions
+ * Name: bch_findsector
+ *
+ * Description:
+ *   Return the cache entry that holds a sector or NULL if the sector is not
+ *   cached.
+ *
  ****************************************************************************/
 
+static FAR struct bch_sector_s *bch_findsector(FAR struct bchlib_s *bch,
+                                               size_t sector)
+{
+  size_t i;
+
+  for (i = 0; i < bch->ncache; i++)
+    {
+      if (bch->cache[i].sector == sector)
+        {
+          return &bch->cache[i];
+        }
+    }
+
+  return NULL;
+}
+
 /****************************************************************************
- * Name: bchlib_flushsector
+ * Name: bch_victim
  *
  * Description:
- *   Flush the current contents of the sector buffer (if dirty)
+ *   Select the cache entry to be replaced: An unused entry if there is one,
+ *   otherwise the least recently used entry.
  *
- * Assumptions:
- *   Caller must assume mutual exclusion
+ ****************************************************************************/
+
+static FAR struct bch_sector_s *bch_victim(FAR struct bchlib_s *bch)
+{
+  FAR struct bch_sector_s *victim = &bch->cache[0];
+  uint32_t age = 0;
+  size_t i;
+
+  for (i = 0; i < bch->ncache; i++)
+    {
+      FAR struct bch_sector_s *entry = &bch->cache[i];
+
+      if (entry->sector == BCH_NOSECTOR)
+        {
+          return entry;
+        }
+
+      /* The unsigned difference stays correct when the clock wraps */
+
+      if (bch->stamp - entry->stamp > age)
+        {
+          age    = bch->stamp - entry->stamp;
+          victim = entry;
+        }
+    }
+
+  return victim;
+}
+
+/****************************************************************************
+ * Name: bch_isold
+ *
+ * Description:
+ *   Return true if the cache entry is unused or is one of the 'nold' least
+ *   recently used entries.
  *
  ****************************************************************************/
 
-int bchlib_flushsector(FAR struct bchlib_s *bch, bool discard)
+#if CONFIG_BCH_CACHE_READAHEAD > 0
+static bool bch_isold(FAR struct bchlib_s *bch,
+                      FAR struct bch_sector_s *entry, size_t nold)
 {
-  FAR struct inode *inode;
-  ssize_t ret = OK;
+  uint32_t age = bch->stamp - entry->stamp;
+  size_t nolder = 0;
+  size_t i;
+
+  if (entry->sector == BCH_NOSECTOR)
+    {
+      return true;
+    }
+
+  /* Count the entries that would be replaced before this one */
+
+  for (i = 0; i < bch->ncache && nolder < nold; i++)
+    {
+      if (bch->cache[i].sector == BCH_NOSECTOR ||
+          bch->stamp - bch->cache[i].stamp > age)
+        {
+          nolder++;
+        }
+    }
+
+  return nolder < nold;
+}
+#endif
+
+/****************************************************************************
+ * Name: bch_readahead
+ *
+ * Description:
+ *   Return the number of sectors to read into the cache starting at the
+ *   entry 'victim' when 'sector' is missing in the cache.  Read-ahead is
+ *   only done when the miss continues a sequential run of misses and it is
+ *   limited to the entries following the victim so that the sectors can be
+ *   transferred with a single request.  Of these, only clean entries that
+ *   are among the least recently used ones are replaced.
+ *
+ ****************************************************************************/
+
+static size_t bch_readahead(FAR struct bchlib_s *bch,
+                            FAR struct bch_sector_s *victim, size_t sector)
+{
+  size_t nsectors = 1;
+
+#if CONFIG_BCH_CACHE_READAHEAD > 0
+  size_t limit;
+
+  if (sector != bch->lastmiss + 1)
+    {
+      return 1;
+    }
 
-  /* Check if the sector has been modified and is out of synch with the
-   * media.
+  limit = 1 + CONFIG_BCH_CACHE_READAHEAD;
+  if (limit > (size_t)(bch->cache + bch->ncache - victim))
+    {
+      limit = bch->cache + bch->ncache - victim;
+    }
+
+  if (limit > bch->nsectors - sector)
+    {
+      limit = bch->nsectors - sector;
+    }
+
+  /* Stop at the first sector that is already cached so that no sector is
+   * ever held by two entries.  Stop as well at an entry that is dirty or
+   * that is used more recently than the entries that read-ahead replaces
+   * otherwise, so that read-ahead never writes back or evicts hot sectors.
    */
 
-  if (bch->dirty)
+  while (nsectors < limit && !victim[nsectors].dirty &&
+         bch_isold(bch, &victim[nsectors], limit) &&
+         bch_findsector(bch, sector + nsectors) == NULL)
     {
-      inode = bch->inode;
+      nsectors++;
+    }
+#endif
+
+  return nsectors;
+}
+
+/****************************************************************************
+ * Name: bch_writeback
+ *
+ * Description:
+ *   Write a dirty cache entry back to the media.  The following entries are
+ *   written with the same request as long as they are dirty and hold the
+ *   next sectors.
+ *
+ ****************************************************************************/
+
+static int bch_writeback(FAR struct bchlib_s *bch,
+                         FAR struct bch_sector_s *entry)
+{
+  FAR struct bch_sector_s *end = bch->cache + bch->ncache;
+  FAR struct inode *inode = bch->inode;
+  size_t nsectors = 1;
+  ssize_t ret;
+  size_t i;
+
+  DEBUGASSERT(entry->dirty);
+
+  while (entry + nsectors < end && entry[nsectors].dirty &&
+         entry[nsectors].sector == entry->sector + nsectors)
+    {
+      nsectors++;
+    }
 
 #if defined(CONFIG_BCH_ENCRYPTION)
-      /* Encrypt data as necessary */
+  /* Encrypt data as necessary */
 
-      bch_cypher(bch, CYPHER_ENCRYPT);
+  for (i = 0; i < nsectors; i++)
+    {
+      bch_cypher(bch, &entry[i], CYPHER_ENCRYPT);
+    }
 #endif
 
-      /* Write the sector to the media */
+  /* Write the sectors to the media */
 
-      ret = inode->u.i_bops->write(inode, bch->buffer, bch->sector, 1);
-      if (ret < 0)
-        {
-          ferr("Write failed: %zd\n", ret);
-          return (int)ret;
-        }
+  ret = inode->u.i_bops->write(inode, entry->buffer, entry->sector,
+                               nsectors);
 
 #if defined(CONFIG_BCH_ENCRYPTION)
-      /* Computation overhead to save memory for extra sector buffer
-       * TODO: Add configuration switch for extra sector buffer
-       */
+  /* Computation overhead to save memory for extra sector buffer
+   * TODO: Add configuration switch for extra sector buffer
+   */
 
-      bch_cypher(bch, CYPHER_DECRYPT);
+  for (i = 0; i < nsectors; i++)
+    {
+      bch_cypher(bch, &entry[i], CYPHER_DECRYPT);
+    }
 #endif
 
-      /* The sector is now in sync with the media */
+  if (ret < 0)
+    {
+      ferr("Write failed: %zd\n", ret);
+      return (int)ret;
+    }
+
+  /* The sectors are now in sync with the media */
+
+  for (i = 0; i < nsectors; i++)
+    {
+      entry[i].dirty = false;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bchlib_flushsector
+ *
+ * Description:
+ *   Flush all dirty sectors in the cache in ascending sector order and
+ *   optionally discard the cache contents.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_flushsector(FAR struct bchlib_s *bch, bool discard)
+{
+  FAR struct bch_sector_s *first;
+  size_t i;
+  int ret;
+
+  for (; ; )
+    {
+      /* Find the dirty sector with the lowest sector number */
+
+      first = NULL;
+      for (i = 0; i < bch->ncache; i++)
+        {
+          if (bch->cache[i].dirty &&
+              (first == NULL || bch->cache[i].sector < first->sector))
+            {
+              first = &bch->cache[i];
+            }
+        }
 
-      bch->dirty = false;
+      if (first == NULL)
+        {
+          break;
+        }
+
+      ret = bch_writeback(bch, first);
+      if (ret < 0)
+        {
+          return ret;
+        }
     }
 
   if (discard)
     {
-      bch->sector = (size_t)-1;
+      for (i = 0; i < bch->ncache; i++)
+        {
+          bch->cache[i].sector = BCH_NOSECTOR;
+        }
     }
 
-  return (int)ret;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bchlib_flushrange
+ *
+ * Description:
+ *   Flush the dirty cached sectors in the range [sector, sector+nsectors)
+ *   so that the media can be read directly.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_flushrange(FAR struct bchlib_s *bch, size_t sector,
+                      size_t nsectors)
+{
+  FAR struct bch_sector_s *entry;
+  size_t i;
+  int ret;
+
+  for (i = 0; i < bch->ncache; i++)
+    {
+      entry = &bch->cache[i];
+      if (entry->dirty && entry->sector >= sector &&
+          entry->sector - sector < nsectors)
+        {
+          ret = bch_writeback(bch, entry);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bchlib_discardrange
+ *
+ * Description:
+ *   Drop the cached sectors in the range [sector, sector+nsectors) after
+ *   they have been overwritten on the media.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+void bchlib_discardrange(FAR struct bchlib_s *bch, size_t sector,
+                         size_t nsectors)
+{
+  FAR struct bch_sector_s *entry;
+  size_t i;
+
+  for (i = 0; i < bch->ncache; i++)
+    {
+      entry = &bch->cache[i];
+      if (entry->sector != BCH_NOSECTOR && entry->sector >= sector &&
+          entry->sector - sector < nsectors)
+        {
+          entry->sector = BCH_NOSECTOR;
+          entry->dirty  = false;
+        }
+    }
 }
 
 /****************************************************************************
  * Name: bchlib_readsector
  *
  * Description:
- *   Read the current sector contents into buffer
+ *   Make the sector contents available in the cache.  On return, bch->cur
+ *   refers to the cache entry that holds the sector.
  *
  * Assumptions:
  *   Caller must assume mutual exclusion
@@ -165,32 +451,141 @@ int bchlib_flushsector(FAR struct bchlib_s *bch, bool discard)
 
 int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
 {
+  FAR struct bch_sector_s *entry;
   FAR struct inode *inode;
-  ssize_t ret = OK;
+  size_t nsectors;
+  ssize_t ret;
+  size_t i;
 
-  if (bch->sector != sector)
+  entry = bch_findsector(bch, sector);
+  if (entry != NULL)
+    {
+      bch->hits++;
+    }
+  else
     {
       inode = bch->inode;
+      entry = bch_victim(bch);
+      nsectors = bch_readahead(bch, entry, sector);
 
-      ret = bchlib_flushsector(bch, true);
-      if (ret < 0)
+      /* Write back the victim if it is dirty.  Read-ahead only replaces
+       * clean entries.
+       */
+
+      if (entry->dirty)
         {
-          ferr("Flush failed: %zd\n", ret);
-          return (int)ret;
+          ret = bch_writeback(bch, entry);
+          if (ret < 0)
+            {
+              ferr("Flush failed: %zd\n", ret);
+              return (int)ret;
+            }
+        }
+
+      for (i = 0; i < nsectors; i++)
+        {
+          entry[i].sector = BCH_NOSECTOR;
         }
 
-      ret = inode->u.i_bops->read(inode, bch->buffer, sector, 1);
+      ret = inode->u.i_bops->read(inode, entry->buffer, sector, nsectors);
       if (ret < 0)
         {
           ferr("Read failed: %zd\n", ret);
           return (int)ret;
         }
 
-      bch->sector = sector;
+      /* The read-ahead sectors are aged as if they had been accessed just
+       * before the requested sector.
+       */
+
+      for (i = 0; i < nsectors; i++)
+        {
+          entry[i].sector = sector + i;
+          entry[i].stamp  = bch->stamp;
 #if defined(CONFIG_BCH_ENCRYPTION)
-      bch_cypher(bch, CYPHER_DECRYPT);
+          bch_cypher(bch, &entry[i], CYPHER_DECRYPT);
 #endif
+        }
+
+      bch->lastmiss = sector + nsectors - 1;
+      bch->misses++;
     }
 
-  return (int)ret;
+  entry->stamp = ++bch->stamp;
+  bch->cur     = entry;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bchlib_setcache
+ *
+ * Description:
+ *   (Re-)allocate the sector cache with room for 'ncache' sectors.  Any
+ *   dirty sectors in the old cache are flushed first.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_setcache(FAR struct bchlib_s *bch, size_t ncache)
+{
+  FAR struct bch_sector_s *cache;
+  FAR uint8_t *buffer;
+  size_t i;
+  int ret;
+
+  if (ncache == 0 || ncache > SIZE_MAX / bch->sectsize)
+    {
+      return -EINVAL;
+    }
+
+  cache = kmm_zalloc(ncache * sizeof(struct bch_sector_s));
+  if (cache == NULL)
+    {
+      ferr("ERROR: Failed to allocate sector cache\n");
+      return -ENOMEM;
+    }
+
+#if CONFIG_BCH_BUFFER_ALIGNMENT != 0
+  buffer = kmm_memalign(CONFIG_BCH_BUFFER_ALIGNMENT,
+                        ncache * bch->sectsize);
+#else
+  buffer = kmm_malloc(ncache * bch->sectsize);
+#endif
+  if (buffer == NULL)
+    {
+      ferr("ERROR: Failed to allocate sector buffer\n");
+      kmm_free(cache);
+      return -ENOMEM;
+    }
+
+  /* Write back the old cache contents before they are released */
+
+  ret = bchlib_flushsector(bch, true);
+  if (ret < 0)
+    {
+      kmm_free(buffer);
+      kmm_free(cache);
+      return ret;
+    }
+
+  for (i = 0; i < ncache; i++)
+    {
+      cache[i].sector = BCH_NOSECTOR;
+      cache[i].buffer = buffer + i * bch->sectsize;
+    }
+
+  if (bch->cache != NULL)
+    {
+      kmm_free(bch->buffer);
+      kmm_free(bch->cache);
+    }
+
+  bch->cache    = cache;
+  bch->buffer   = buffer;
+  bch->ncache   = ncache;
+  bch->cur      = NULL;
+  bch->lastmiss = BCH_NOSECTOR - 1;
+  return OK;
 }
@@ -118,7 +118,7 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset,
           nbytes = len;
         }
 
-      memcpy(buffer, &bch->buffer[sectoffset], nbytes);
+      memcpy(buffer, &bch->cur->buffer[sectoffset], nbytes);
 
       /* Adjust pointers and counts */
 
@@ -146,6 +146,17 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset,
           nsectors = bch->nsectors - sector;
         }
 
+      /* Write back any cached sectors in the range that are newer than the
+       * media.
+       */
+
+      ret = bchlib_flushrange(bch, sector, nsectors);
+      if (ret < 0)
+        {
+          ferr("ERROR: Flush failed: %d\n", ret);
+          return ret;
+        }
+
       ret = bch->inode->u.i_bops->read(bch->inode, (FAR uint8_t *)buffer,
                                        sector, nsectors);
       if (ret < 0)
@@ -183,7 +194,7 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset,
 
       /* Copy the head end of the sector to the user buffer */
 
-      memcpy(buffer, bch->buffer, len);
+      memcpy(buffer, bch->cur->buffer, len);
 
       /* Adjust counts */
 
@@ -108,20 +108,14 @@ int bchlib_setup(const char *blkdev, bool readonly, FAR void **handle)
   nxmutex_init(&bch->lock);
   bch->nsectors = geo.geo_nsectors;
   bch->sectsize = geo.geo_sectorsize;
-  bch->sector   = (size_t)-1;
   bch->readonly = readonly;
 
-  /* Allocate the sector I/O buffer */
+  /* Allocate the sector cache */
 
-#if CONFIG_BCH_BUFFER_ALIGNMENT != 0
-  bch->buffer = kmm_memalign(CONFIG_BCH_BUFFER_ALIGNMENT, bch->sectsize);
-#else
-  bch->buffer = kmm_malloc(bch->sectsize);
-#endif
-  if (!bch->buffer)
+  ret = bchlib_setcache(bch, CONFIG_BCH_CACHE_NSECTORS);
+  if (ret < 0)
     {
-      ferr("ERROR: Failed to allocate sector buffer\n");
-      ret = -ENOMEM;
+      nxmutex_destroy(&bch->lock);
       goto errout_with_bch;
     }
 
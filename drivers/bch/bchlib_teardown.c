@@ -70,9 +70,10 @@ int bchlib_teardown(FAR void *handle)
 
   /* Free the BCH state structure */
 
-  if (bch->buffer)
+  if (bch->cache)
     {
       kmm_free(bch->buffer);
+      kmm_free(bch->cache);
     }
 
   nxmutex_destroy(&bch->lock);
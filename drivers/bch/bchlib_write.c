@@ -102,8 +102,8 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
           nbytes = len;
         }
 
-      memcpy(&bch->buffer[sectoffset], buffer, nbytes);
-      bch->dirty = true;
+      memcpy(&bch->cur->buffer[sectoffset], buffer, nbytes);
+      bch->cur->dirty = true;
 
       /* Adjust pointers and counts */
 
@@ -131,10 +131,11 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
           nsectors = bch->nsectors - sector;
         }
 
-      /* Flush the dirty sector to keep the sector sequence */
+      /* Flush the dirty cached sectors that are about to be overwritten
+       * to keep the sector sequence.
+       */
 
-      ret = bchlib_flushsector(bch, sector <= bch->sector &&
-                               bch->sector < (sector + nsectors));
+      ret = bchlib_flushrange(bch, sector, nsectors);
       if (ret < 0)
         {
           ferr("ERROR: Flush failed: %d\n", ret);
@@ -151,6 +152,10 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
           return ret;
         }
 
+      /* The cached copies of the written sectors are stale now */
+
+      bchlib_discardrange(bch, sector, nsectors);
+
       /* Adjust pointers and counts */
 
       sector       += nsectors;
@@ -180,8 +185,8 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
 
       /* Copy the head end of the sector from the user buffer */
 
-      memcpy(bch->buffer, buffer, len);
-      bch->dirty = true;
+      memcpy(bch->cur->buffer, buffer, len);
+      bch->cur->dirty = true;
 
       /* Adjust counts */
 
@@ -25,19 +25,24 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <inttypes.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
 #include <time.h>
 #include <assert.h>
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/wqueue.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
 #include <nuttx/drivers/rwbuffer.h>
 
 #if defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD)
@@ -56,6 +61,61 @@
 #  error "Worker thread support is required (CONFIG_SCHED_WORKQUEUE)"
 #endif
 
+/* Statistics ***************************************************************/
+
+#ifdef CONFIG_DRVR_RWBUFFER_STATS
+#  define rwb_stats(r,f,n) ((r)->stats.f += (n))
+#else
+#  define rwb_stats(r,f,n)
+#endif
+
+/* /proc/rwbuffer output format, one line per buffer:
+ *
+ *   DEVICE   BLKSZ   RDBLKS   RDHITS  RHLOADS   RHBLKS ...
+ *   XXXXXXXX DDDDD DDDDDDDD DDDDDDDD DDDDDDDD DDDDDDDD ...
+ *
+ * followed by WRBLKS, FLUSHES and FLBLKS.  The width of the DEVICE field
+ * follows the size of an address.
+ */
+
+#define RWB_HDR_FMT "%-*s BLKSZ   RDBLKS   RDHITS  RHLOADS   RHBLKS" \
+                    "   WRBLKS  FLUSHES   FLBLKS\n"
+#define RWB_FMT     "%0*lx %5u %8lu %8lu %8lu %8lu %8lu %8lu %8lu\n"
+
+#define RWB_ADDRWIDTH ((int)(2 * sizeof(uintptr_t)))
+#define RWB_LINELEN   112
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#if defined(CONFIG_DRVR_RWBUFFER_STATS) && defined(CONFIG_FS_PROCFS)
+/* Snapshot of one buffer */
+
+struct rwb_procfs_entry_s
+{
+  FAR void          *dev;         /* Device state of the buffer */
+  uint16_t           blocksize;   /* The size of one block */
+  struct rwb_stats_s stats;       /* Buffer statistics */
+};
+
+/* This structure describes one open "file".  The statistics of all buffers
+ * are captured when the file is opened.
+ */
+
+struct rwb_procfs_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  char line[RWB_LINELEN];         /* Pre-allocated buffer for formatted lines */
+  unsigned int nentries;          /* Number of entries in the snapshot */
+  struct rwb_procfs_entry_s entry[1]; /* Snapshot (variable length) */
+};
+
+#define SIZEOF_RWB_PROCFS_FILE_S(n) \
+  (sizeof(struct rwb_procfs_file_s) + \
+   ((n) - 1) * sizeof(struct rwb_procfs_entry_s))
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -63,6 +123,53 @@
 static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
                          size_t nblocks, FAR uint8_t *rdbuffer);
 
+#if defined(CONFIG_DRVR_RWBUFFER_STATS) && defined(CONFIG_FS_PROCFS)
+static int     rwb_procfs_open(FAR struct file *filep,
+                 FAR const char *relpath, int oflags, mode_t mode);
+static int     rwb_procfs_close(FAR struct file *filep);
+static ssize_t rwb_procfs_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     rwb_procfs_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     rwb_procfs_stat(FAR const char *relpath,
+                 FAR struct stat *buf);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_RWBUFFER_STATS
+/* All initialized buffers, for /proc/rwbuffer */
+
+static FAR struct rwbuffer_s *g_rwb_list;
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#if defined(CONFIG_DRVR_RWBUFFER_STATS) && defined(CONFIG_FS_PROCFS)
+/* See fs_procfs.c -- this structure is explicitly extern'ed there. */
+
+const struct procfs_operations g_rwbuffer_operations =
+{
+  rwb_procfs_open,     /* open */
+  rwb_procfs_close,    /* close */
+  rwb_procfs_read,     /* read */
+  NULL,                /* write */
+
+  rwb_procfs_dup,      /* dup */
+
+  NULL,                /* opendir */
+  NULL,                /* closedir */
+  NULL,                /* readdir */
+  NULL,                /* rewinddir */
+
+  rwb_procfs_stat      /* stat */
+};
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -110,6 +217,76 @@ static inline bool rwb_overlap(off_t blockstart1, size_t nblocks1,
     }
 }
 
+/****************************************************************************
+ * Name: rwb_copyoverlap
+ *
+ * Description:
+ *   Copy the blocks that lie in both the source and the destination region
+ *   from the source buffer to the destination buffer.
+ *
+ ****************************************************************************/
+
+static void rwb_copyoverlap(FAR struct rwbuffer_s *rwb,
+                            FAR uint8_t *dest, off_t deststart,
+                            size_t destblocks, FAR const uint8_t *src,
+                            off_t srcstart, size_t srcblocks)
+{
+  off_t start = deststart > srcstart ? deststart : srcstart;
+  off_t end   = deststart + destblocks < srcstart + srcblocks ?
+                deststart + destblocks : srcstart + srcblocks;
+
+  if (start < end)
+    {
+      memcpy(dest + (start - deststart) * rwb->blocksize,
+             src + (start - srcstart) * rwb->blocksize,
+             (end - start) * rwb->blocksize);
+    }
+}
+
+/****************************************************************************
+ * Name: rwb_rhupdate
+ *
+ * Description:
+ *   Copy blocks that are written to the media into the read-ahead buffers
+ *   that hold them, so that the read-ahead buffers stay valid.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_READAHEAD
+static int rwb_rhupdate(FAR struct rwbuffer_s *rwb,
+                        FAR const uint8_t *buffer, off_t startblock,
+                        size_t nblocks)
+{
+  FAR struct rwb_rhslot_s *slot;
+  int ret;
+  int i;
+
+  if (rwb->rhmaxblocks == 0)
+    {
+      return OK;
+    }
+
+  ret = rwb_lock(&rwb->rhlock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (i = 0; i < CONFIG_DRVR_READAHEAD_NSTREAMS; i++)
+    {
+      slot = &rwb->rhslot[i];
+      if (slot->nblocks > 0)
+        {
+          rwb_copyoverlap(rwb, slot->buffer, slot->blockstart,
+                          slot->nblocks, buffer, startblock, nblocks);
+        }
+    }
+
+  rwb_unlock(&rwb->rhlock);
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: rwb_resetwrbuffer
  ****************************************************************************/
@@ -117,15 +294,49 @@ static inline bool rwb_overlap(off_t blockstart1, size_t nblocks1,
 #ifdef CONFIG_DRVR_WRITEBUFFER
 static inline void rwb_resetwrbuffer(FAR struct rwbuffer_s *rwb)
 {
+  int i;
+
   /* We assume that the caller holds the wrlock */
 
-  rwb->wrnblocks    = 0;
-  rwb->wrblockstart = -1;
+  for (i = 0; i < CONFIG_DRVR_WRITEBUFFER_NSLOTS; i++)
+    {
+      rwb->wrslot[i].nblocks    = 0;
+      rwb->wrslot[i].blockstart = -1;
+    }
 }
 #endif
 
 /****************************************************************************
- * Name: rwb_wrflush
+ * Name: rwb_wrpending
+ *
+ * Description:
+ *   Return true if any block is waiting in the write buffer.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static bool rwb_wrpending(FAR struct rwbuffer_s *rwb)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_DRVR_WRITEBUFFER_NSLOTS; i++)
+    {
+      if (rwb->wrslot[i].nblocks > 0)
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wrflushslot
+ *
+ * Description:
+ *   Write the dirty blocks of one write slot to the media, padded out to
+ *   wralignblocks with the content of the media.
  *
  * Assumptions:
  *   The caller holds the wrlock mutex.
@@ -133,49 +344,111 @@ static inline void rwb_resetwrbuffer(FAR struct rwbuffer_s *rwb)
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
-static void rwb_wrflush(FAR struct rwbuffer_s *rwb)
+static void rwb_wrflushslot(FAR struct rwbuffer_s *rwb,
+                            FAR struct rwb_wrslot_s *slot)
 {
-  int ret;
+  off_t pagestart;
+  off_t dirtyend;
+  off_t start;
+  off_t end;
+  ssize_t ret;
 
-  if (rwb->wrnblocks > 0)
+  if (slot->nblocks == 0)
     {
-      size_t padblocks;
+      return;
+    }
 
-      finfo("Flushing: blockstart=0x%08lx nblocks=%d from buffer=%p\n",
-            (long)rwb->wrblockstart, rwb->wrnblocks, rwb->wrbuffer);
+  finfo("Flushing: blockstart=0x%08lx nblocks=%d from buffer=%p\n",
+        (long)slot->blockstart, slot->nblocks, slot->buffer);
 
-      padblocks = rwb->wrblockstart % rwb->wralignblocks;
-      if (padblocks)
-        {
-          memmove(rwb->wrbuffer + padblocks * rwb->blocksize,
-                  rwb->wrbuffer, rwb->wrnblocks * rwb->blocksize);
-          rwb->wrblockstart -= padblocks;
-          rwb->wrnblocks += padblocks;
-          rwb_read_(rwb, rwb->wrblockstart, padblocks, rwb->wrbuffer);
-        }
+  /* The page is aligned to wrmaxblocks, which is a multiple of
+   * wralignblocks, so the padded region never leaves the page.
+   */
+
+  pagestart = slot->blockstart - slot->blockstart % rwb->wrmaxblocks;
+  dirtyend  = slot->blockstart + slot->nblocks;
+  start     = slot->blockstart - slot->blockstart % rwb->wralignblocks;
+  end       = dirtyend + (rwb->wralignblocks - dirtyend % rwb->wralignblocks) %
+              rwb->wralignblocks;
+
+  if (start < slot->blockstart)
+    {
+      rwb_read_(rwb, start, slot->blockstart - start,
+                slot->buffer + (start - pagestart) * rwb->blocksize);
+    }
+
+  if (end > dirtyend)
+    {
+      rwb_read_(rwb, dirtyend, end - dirtyend,
+                slot->buffer + (dirtyend - pagestart) * rwb->blocksize);
+    }
+
+  /* Flush cache.  On success, the flush method will return the number
+   * of blocks written.  Anything other than the number requested is
+   * an error.
+   */
+
+  ret = rwb->wrflush(rwb->dev,
+                     slot->buffer + (start - pagestart) * rwb->blocksize,
+                     start, end - start);
+  if (ret != end - start)
+    {
+      ferr("ERROR: Error flushing write buffer: %zd\n", ret);
+    }
+
+#ifdef CONFIG_DRVR_READAHEAD
+  /* A read-ahead buffer may have been loaded with the old content of the
+   * dirty blocks from the media.
+   */
+
+  rwb_rhupdate(rwb, slot->buffer + (slot->blockstart - pagestart) *
+               rwb->blocksize, slot->blockstart, slot->nblocks);
+#endif
+
+  rwb_stats(rwb, wrflushes, 1);
+  rwb_stats(rwb, wrflushblocks, end - start);
+
+  slot->nblocks    = 0;
+  slot->blockstart = -1;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wrflush
+ *
+ * Description:
+ *   Write all dirty pages to the media in ascending block order.
+ *
+ * Assumptions:
+ *   The caller holds the wrlock mutex.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static void rwb_wrflush(FAR struct rwbuffer_s *rwb)
+{
+  FAR struct rwb_wrslot_s *next;
+  int i;
 
-      padblocks = rwb->wrnblocks % rwb->wralignblocks;
-      if (padblocks)
+  for (; ; )
+    {
+      next = NULL;
+      for (i = 0; i < CONFIG_DRVR_WRITEBUFFER_NSLOTS; i++)
         {
-          padblocks = rwb->wralignblocks - padblocks;
-          rwb_read_(rwb, rwb->wrblockstart + rwb->wrnblocks, padblocks,
-                    &rwb->wrbuffer[rwb->wrnblocks * rwb->blocksize]);
-          rwb->wrnblocks += padblocks;
+          if (rwb->wrslot[i].nblocks > 0 &&
+              (next == NULL ||
+               rwb->wrslot[i].blockstart < next->blockstart))
+            {
+              next = &rwb->wrslot[i];
+            }
         }
 
-      /* Flush cache.  On success, the flush method will return the number
-       * of blocks written.  Anything other than the number requested is
-       * an error.
-       */
-
-      ret = rwb->wrflush(rwb->dev, rwb->wrbuffer, rwb->wrblockstart,
-                         rwb->wrnblocks);
-      if (ret != rwb->wrnblocks)
+      if (next == NULL)
         {
-          ferr("ERROR: Error flushing write buffer: %d\n", ret);
+          break;
         }
 
-      rwb_resetwrbuffer(rwb);
+      rwb_wrflushslot(rwb, next);
     }
 }
 #endif
@@ -236,6 +509,71 @@ static inline void rwb_wrcanceltimeout(FAR struct rwbuffer_s *rwb)
 }
 #endif
 
+/****************************************************************************
+ * Name: rwb_wrfind
+ *
+ * Description:
+ *   Return the write slot holding dirty blocks of the page that contains
+ *   'block' or NULL if that page is not buffered.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static FAR struct rwb_wrslot_s *rwb_wrfind(FAR struct rwbuffer_s *rwb,
+                                           off_t block)
+{
+  off_t page = block / rwb->wrmaxblocks;
+  int i;
+
+  for (i = 0; i < CONFIG_DRVR_WRITEBUFFER_NSLOTS; i++)
+    {
+      if (rwb->wrslot[i].nblocks > 0 &&
+          rwb->wrslot[i].blockstart / rwb->wrmaxblocks == page)
+        {
+          return &rwb->wrslot[i];
+        }
+    }
+
+  return NULL;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wralloc
+ *
+ * Description:
+ *   Return an unused write slot, flushing the least recently used one if
+ *   all slots are in use.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static FAR struct rwb_wrslot_s *rwb_wralloc(FAR struct rwbuffer_s *rwb)
+{
+  FAR struct rwb_wrslot_s *victim = NULL;
+  FAR struct rwb_wrslot_s *slot;
+  int i;
+
+  for (i = 0; i < CONFIG_DRVR_WRITEBUFFER_NSLOTS; i++)
+    {
+      slot = &rwb->wrslot[i];
+      if (slot->nblocks == 0)
+        {
+          return slot;
+        }
+
+      if (victim == NULL ||
+          rwb->wrstamp - slot->stamp > rwb->wrstamp - victim->stamp)
+        {
+          victim = slot;
+        }
+    }
+
+  rwb_wrflushslot(rwb, victim);
+  return victim;
+}
+#endif
+
 /****************************************************************************
  * Name: rwb_writebuffer
  ****************************************************************************/
@@ -245,147 +583,120 @@ static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb,
                                off_t startblock, uint32_t nblocks,
                                FAR const uint8_t *wrbuffer)
 {
+  FAR struct rwb_wrslot_s *slot;
   uint32_t nwritten = nblocks;
+  ssize_t ret;
+  int i;
 
   /* Write writebuffer Logic */
 
   rwb_wrcanceltimeout(rwb);
+  rwb_stats(rwb, wrblocks, nblocks);
 
-  /* Is data saved in the write buffer? */
+  /* Use the block cache unless the buffer size is bigger than one page of
+   * the block cache.  In that case, update the buffered blocks that are
+   * overwritten and write the data directly.
+   */
 
-  if (rwb->wrnblocks > 0)
+  if (nblocks > rwb->wrmaxblocks)
     {
-      off_t wrbend;
-      off_t newend;
-
-      /* Now there are five cases:
-       *
-       * 1. We update the non-overlapping region
-       */
-
-      wrbend = rwb->wrblockstart + rwb->wrnblocks;
-      newend = startblock + nblocks;
-
-      if (wrbend < startblock || rwb->wrblockstart > newend)
+      for (i = 0; i < CONFIG_DRVR_WRITEBUFFER_NSLOTS; i++)
         {
-          /* Nothing to do */;
+          slot = &rwb->wrslot[i];
+          if (slot->nblocks > 0)
+            {
+              rwb_copyoverlap(rwb, slot->buffer + (slot->blockstart %
+                              rwb->wrmaxblocks) * rwb->blocksize,
+                              slot->blockstart, slot->nblocks,
+                              wrbuffer, startblock, nblocks);
+            }
         }
 
-      /* 2. We update the entire write buffer. */
-
-      else if (rwb->wrblockstart > startblock && wrbend < newend)
+      ret = rwb->wrflush(rwb->dev, wrbuffer, startblock, nblocks);
+      if (ret < 0)
         {
-          rwb->wrnblocks = 0;
+          return ret;
         }
 
-      /* We are going to update a subset of the write buffer.  Three
-       * more cases to consider:
-       *
-       * 3. We update a portion in the middle of the write buffer
-       */
-
-      else if (rwb->wrblockstart <= startblock && wrbend >= newend)
-        {
-          FAR uint8_t *dest;
-          size_t offset;
+      nblocks = 0;
+    }
 
-          /* Copy the data to the middle of write buffer */
+  /* Otherwise buffer the data page by page */
 
-          offset = startblock - rwb->wrblockstart;
-          dest   = rwb->wrbuffer + offset * rwb->blocksize;
-          memcpy(dest, wrbuffer, nblocks * rwb->blocksize);
+  while (nblocks > 0)
+    {
+      off_t pagestart = startblock - startblock % rwb->wrmaxblocks;
+      off_t newstart  = startblock;
+      off_t newend;
+      size_t ncopy;
 
-          nblocks = 0;
+      ncopy = pagestart + rwb->wrmaxblocks - startblock;
+      if (ncopy > nblocks)
+        {
+          ncopy = nblocks;
         }
 
-      /* 4. We update a portion at the end of the write buffer */
+      newend = startblock + ncopy;
 
-      else if (wrbend >= startblock && wrbend <= newend)
+      slot = rwb_wrfind(rwb, startblock);
+      if (slot != NULL)
         {
-          FAR uint8_t *dest;
-          size_t offset;
-          size_t ncopy;
+          off_t dirtyend = slot->blockstart + slot->nblocks;
 
-          /* Copy the data from the updating region to the end
-           * of the write buffer.
+          /* The dirty blocks of a page must stay contiguous.  Fill any
+           * hole between them and the new blocks from the media.
            */
 
-          offset = rwb->wrnblocks - (wrbend - startblock);
-          ncopy  = rwb->wrmaxblocks - offset;
-          if (ncopy > nblocks)
+          if (startblock > dirtyend)
             {
-              ncopy = nblocks;
+              ret = rwb_read_(rwb, dirtyend, startblock - dirtyend,
+                              slot->buffer + (dirtyend - pagestart) *
+                              rwb->blocksize);
+              if (ret < 0)
+                {
+                  return ret;
+                }
             }
-
-          dest = rwb->wrbuffer + offset * rwb->blocksize;
-          memcpy(dest, wrbuffer, ncopy * rwb->blocksize);
-
-          rwb->wrnblocks = offset + ncopy;
-          wrbuffer      += ncopy * rwb->blocksize;
-          startblock    += ncopy;
-          nblocks       -= ncopy;
-        }
-
-      /* 5. We update a portion at the beginning of the write buffer */
-
-      else /* if (rwb->wrblockstart >= startblock && wrbend >= newend) */
-        {
-          FAR uint8_t *dest;
-          FAR const uint8_t *src;
-          size_t ncopy;
-
-          DEBUGASSERT(rwb->wrblockstart >= startblock && wrbend >= newend);
-
-          /* Move the cached data to the end of the write buffer */
-
-          ncopy = rwb->wrblockstart - startblock;
-          if (ncopy > rwb->wrmaxblocks - rwb->wrnblocks)
+          else if (newend < slot->blockstart)
             {
-              ncopy = rwb->wrmaxblocks - rwb->wrnblocks;
+              ret = rwb_read_(rwb, newend, slot->blockstart - newend,
+                              slot->buffer + (newend - pagestart) *
+                              rwb->blocksize);
+              if (ret < 0)
+                {
+                  return ret;
+                }
             }
 
-          dest = rwb->wrbuffer + ncopy * rwb->blocksize;
-          memmove(dest, rwb->wrbuffer, ncopy * rwb->blocksize);
-
-          rwb->wrblockstart -= ncopy;
-          rwb->wrnblocks    += ncopy;
-
-          /* Copy the data from the updating region to the beginning
-           * of the write buffer.
-           */
-
-          ncopy = newend - rwb->wrblockstart;
-          src   = wrbuffer + (nblocks - ncopy) * rwb->blocksize;
-          memcpy(rwb->wrbuffer, src, ncopy * rwb->blocksize);
+          if (slot->blockstart < newstart)
+            {
+              newstart = slot->blockstart;
+            }
 
-          nblocks -= ncopy;
+          if (dirtyend > newend)
+            {
+              newend = dirtyend;
+            }
         }
-    }
-
-  /* Use the block cache unless the buffer size is bigger than block cache */
-
-  if (nblocks > rwb->wrmaxblocks)
-    {
-      ssize_t ret = rwb->wrflush(rwb->dev, wrbuffer, startblock, nblocks);
-      if (ret < 0)
+      else
         {
-          return ret;
+          slot = rwb_wralloc(rwb);
         }
-    }
-  else if (nblocks)
-    {
-      /* Flush the write buffer */
 
-      rwb_wrflush(rwb);
+      /* Buffer the data in the write slot */
 
-      /* Buffer the data in the write buffer */
+      memcpy(slot->buffer + (startblock - pagestart) * rwb->blocksize,
+             wrbuffer, ncopy * rwb->blocksize);
+      slot->blockstart = newstart;
+      slot->nblocks    = newend - newstart;
+      slot->stamp      = ++rwb->wrstamp;
 
-      memcpy(rwb->wrbuffer, wrbuffer, nblocks * rwb->blocksize);
-      rwb->wrblockstart = startblock;
-      rwb->wrnblocks    = nblocks;
+      startblock += ncopy;
+      wrbuffer   += ncopy * rwb->blocksize;
+      nblocks    -= ncopy;
     }
 
-  if (rwb->wrnblocks > 0)
+  if (rwb_wrpending(rwb))
     {
       rwb_wrstarttimeout(rwb);
     }
@@ -401,60 +712,71 @@ static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb,
 #ifdef CONFIG_DRVR_READAHEAD
 static inline void rwb_resetrhbuffer(FAR struct rwbuffer_s *rwb)
 {
+  int i;
+
   /* We assume that the caller holds the readAheadBufferSemaphore */
 
-  rwb->rhnblocks    = 0;
-  rwb->rhblockstart = -1;
+  for (i = 0; i < CONFIG_DRVR_READAHEAD_NSTREAMS; i++)
+    {
+      rwb->rhslot[i].nblocks    = 0;
+      rwb->rhslot[i].blockstart = -1;
+      rwb->rhslot[i].nextblock  = -1;
+      rwb->rhslot[i].window     = 0;
+    }
 }
 #endif
 
 /****************************************************************************
- * Name: rwb_bufferread
+ * Name: rwb_rhfind
+ *
+ * Description:
+ *   Return the read-ahead stream whose buffer holds 'block' or NULL if no
+ *   buffer holds it.
+ *
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_READAHEAD
-static inline void
-rwb_bufferread(FAR struct rwbuffer_s *rwb,  off_t startblock,
-               size_t nblocks, FAR uint8_t **rdbuffer)
+static FAR struct rwb_rhslot_s *rwb_rhfind(FAR struct rwbuffer_s *rwb,
+                                           off_t block)
 {
-  FAR uint8_t *rhbuffer;
-
-  /* We assume that:
-   * (1) the caller holds the readAheadBufferSemaphore, and
-   * (2) the caller already knows that all of the blocks are in the
-   *     read-ahead buffer.
-   */
-
-  /* Convert the units from blocks to bytes */
+  FAR struct rwb_rhslot_s *slot;
+  int i;
 
-  off_t  blockoffset = startblock - rwb->rhblockstart;
-  off_t  byteoffset  = rwb->blocksize * blockoffset;
-  size_t nbytes      = rwb->blocksize * nblocks;
-
-  /* Get the byte address in the read-ahead buffer */
-
-  rhbuffer           = rwb->rhbuffer + byteoffset;
-
-  /* Copy the data from the read-ahead buffer into the IO buffer */
-
-  memcpy(*rdbuffer, rhbuffer, nbytes);
-
-  /* Update the caller's copy for the next address */
+  for (i = 0; i < CONFIG_DRVR_READAHEAD_NSTREAMS; i++)
+    {
+      slot = &rwb->rhslot[i];
+      if (slot->nblocks > 0 && block >= slot->blockstart &&
+          block < slot->blockstart + slot->nblocks)
+        {
+          return slot;
+        }
+    }
 
-  *rdbuffer += nbytes;
+  return NULL;
 }
 #endif
 
 /****************************************************************************
  * Name: rwb_rhreload
+ *
+ * Description:
+ *   Load the blocks starting at 'startblock' into a read-ahead buffer.  A
+ *   read that continues a stream reloads the buffer of that stream;
+ *   otherwise the least recently used stream is replaced.
+ *
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_READAHEAD
-static int rwb_rhreload(FAR struct rwbuffer_s *rwb, off_t startblock)
+static int rwb_rhreload(FAR struct rwbuffer_s *rwb, off_t startblock,
+                        size_t remaining)
 {
+  FAR struct rwb_rhslot_s *stream = NULL;
+  FAR struct rwb_rhslot_s *slot;
   off_t  endblock;
+  size_t window;
   size_t nblocks;
   int    ret;
+  int    i;
 
   /* Check for attempts to read beyond the end of the media */
 
@@ -463,11 +785,63 @@ static int rwb_rhreload(FAR struct rwbuffer_s *rwb, off_t startblock)
       return -ESPIPE;
     }
 
+  /* Is this the continuation of a stream? */
+
+  for (i = 0; i < CONFIG_DRVR_READAHEAD_NSTREAMS; i++)
+    {
+      slot = &rwb->rhslot[i];
+      if (slot->nextblock == startblock ||
+          (slot->nblocks > 0 &&
+           slot->blockstart + slot->nblocks == startblock))
+        {
+          stream = slot;
+          break;
+        }
+    }
+
+  if (stream != NULL)
+    {
+      /* Sequential access: grow the window */
+
+      window = rwb->rhmaxblocks;
+#ifdef CONFIG_DRVR_READAHEAD_ADAPTIVE
+      window = 2 * stream->window;
+      if (window < remaining)
+        {
+          window = remaining;
+        }
+
+      if (window > rwb->rhmaxblocks)
+        {
+          window = rwb->rhmaxblocks;
+        }
+#endif
+    }
+  else
+    {
+      /* A new stream: replace the least recently used one */
+
+      for (i = 0; i < CONFIG_DRVR_READAHEAD_NSTREAMS; i++)
+        {
+          slot = &rwb->rhslot[i];
+          if (stream == NULL ||
+              rwb->rhstamp - slot->stamp > rwb->rhstamp - stream->stamp)
+            {
+              stream = slot;
+            }
+        }
+
+      window = rwb->rhmaxblocks;
+#ifdef CONFIG_DRVR_READAHEAD_ADAPTIVE
+      window = remaining < rwb->rhmaxblocks ? remaining : rwb->rhmaxblocks;
+#endif
+    }
+
   /* Get the block number +1 of the last block that will fit in the
    * read-ahead buffer
    */
 
-  endblock = startblock + rwb->rhmaxblocks;
+  endblock = startblock + window;
 
   /* Make sure that we don't read past the end of the device */
 
@@ -480,17 +854,23 @@ static int rwb_rhreload(FAR struct rwbuffer_s *rwb, off_t startblock)
 
   /* Reset the read buffer */
 
-  rwb_resetrhbuffer(rwb);
+  stream->nblocks    = 0;
+  stream->blockstart = -1;
+  stream->stamp      = ++rwb->rhstamp;
 
   /* Now perform the read */
 
-  ret = rwb->rhreload(rwb->dev, rwb->rhbuffer, startblock, nblocks);
+  ret = rwb->rhreload(rwb->dev, stream->buffer, startblock, nblocks);
   if (ret == nblocks)
     {
       /* Update information about what is in the read-ahead buffer */
 
-      rwb->rhnblocks    = nblocks;
-      rwb->rhblockstart = startblock;
+      stream->nblocks    = nblocks;
+      stream->blockstart = startblock;
+      stream->window     = window;
+
+      rwb_stats(rwb, rhloads, 1);
+      rwb_stats(rwb, rhblocks, nblocks);
 
       /* The return value is not the number of blocks we asked to be
        * loaded.
@@ -515,14 +895,15 @@ static int rwb_rhreload(FAR struct rwbuffer_s *rwb, off_t startblock)
 int rwb_invalidate_writebuffer(FAR struct rwbuffer_s *rwb,
                                off_t startblock, size_t blockcount)
 {
+  FAR struct rwb_wrslot_s *slot;
   int ret = OK;
+  int i;
 
-  /* Is there a write buffer?  Is data saved in the write buffer? */
+  /* Is there a write buffer? */
 
-  if (rwb->wrmaxblocks > 0 && rwb->wrnblocks > 0)
+  if (rwb->wrmaxblocks > 0)
     {
-      off_t wrbend;
-      off_t invend;
+      off_t invend = startblock + blockcount;
 
       finfo("startblock=%" PRIdOFF " blockcount=%zu\n",
             startblock, blockcount);
@@ -533,111 +914,80 @@ int rwb_invalidate_writebuffer(FAR struct rwbuffer_s *rwb,
           return ret;
         }
 
-      /* Now there are five cases:
-       *
-       * 1. We invalidate nothing
-       */
-
-      wrbend = rwb->wrblockstart + rwb->wrnblocks;
-      invend = startblock + blockcount;
-
-      if (wrbend <= startblock || rwb->wrblockstart >= invend)
-        {
-          ret = OK;
-        }
-
-      /* 2. We invalidate the entire write buffer. */
-
-      else if (rwb->wrblockstart >= startblock && wrbend <= invend)
-        {
-          rwb->wrnblocks = 0;
-          ret = OK;
-        }
-
-      /* We are going to invalidate a subset of the write buffer.  Three
-       * more cases to consider:
-       *
-       * 3. We invalidate a portion in the middle of the write buffer
-       */
-
-      else if (rwb->wrblockstart < startblock && wrbend > invend)
+      for (i = 0; i < CONFIG_DRVR_WRITEBUFFER_NSLOTS; i++)
         {
-          FAR uint8_t *src;
-          off_t block;
-          off_t offset;
-          size_t nblocks;
+          off_t wrbend;
 
-          /* Write the blocks at the end of the media to hardware */
+          slot   = &rwb->wrslot[i];
+          wrbend = slot->blockstart + slot->nblocks;
 
-          nblocks = wrbend - invend;
-          block   = invend;
-          offset  = block - rwb->wrblockstart;
-          src     = rwb->wrbuffer + offset * rwb->blocksize;
+          /* Now there are five cases:
+           *
+           * 1. We invalidate nothing
+           */
 
-          ret = rwb->wrflush(rwb->dev, src, block, nblocks);
-          if (ret < 0)
+          if (slot->nblocks == 0 || wrbend <= startblock ||
+              slot->blockstart >= invend)
             {
-              ferr("ERROR: wrflush failed: %d\n", ret);
+              continue;
             }
 
-          /* Keep the blocks at the beginning of the buffer up the
-           * start of the invalidated region.
-           */
+          /* 2. We invalidate the entire slot. */
 
-          else
+          else if (slot->blockstart >= startblock && wrbend <= invend)
             {
-              rwb->wrnblocks = startblock - rwb->wrblockstart;
-              ret = OK;
+              slot->nblocks    = 0;
+              slot->blockstart = -1;
             }
-        }
-
-      /* 4. We invalidate a portion at the end of the write buffer */
 
-      else if (wrbend > startblock && wrbend <= invend)
-        {
-          rwb->wrnblocks -= wrbend - startblock;
-          ret = OK;
-        }
+          /* We are going to invalidate a subset of the slot.  Three more
+           * cases to consider:
+           *
+           * 3. We invalidate a portion in the middle of the slot
+           */
 
-      /* 5. We invalidate a portion at the beginning of the write buffer */
+          else if (slot->blockstart < startblock && wrbend > invend)
+            {
+              FAR uint8_t *src;
 
-      else /* if (rwb->wrblockstart >= startblock && wrbend > invend) */
-        {
-          FAR uint8_t *src;
-          size_t ninval;
-          size_t nkeep;
+              /* Write the blocks at the end of the slot to hardware */
 
-          DEBUGASSERT(rwb->wrblockstart >= startblock && wrbend > invend);
+              src = slot->buffer + (invend % rwb->wrmaxblocks) *
+                    rwb->blocksize;
+              ret = rwb->wrflush(rwb->dev, src, invend, wrbend - invend);
+              if (ret < 0)
+                {
+                  ferr("ERROR: wrflush failed: %d\n", ret);
+                  break;
+                }
 
-          /* Copy the data from the uninvalidated region to the beginning
-           * of the write buffer.
-           *
-           * First calculate the source and destination of the transfer.
-           */
+              /* Keep the blocks at the beginning of the slot up the
+               * start of the invalidated region.
+               */
 
-          ninval = invend - rwb->wrblockstart;
-          src    = rwb->wrbuffer + ninval * rwb->blocksize;
+              slot->nblocks = startblock - slot->blockstart;
+              ret = OK;
+            }
 
-          /* Calculate the number of blocks we are keeping.  We keep
-           * the ones that we don't invalidate.
-           */
+          /* 4. We invalidate a portion at the end of the slot */
 
-          nkeep  = rwb->wrnblocks - ninval;
+          else if (wrbend > startblock && wrbend <= invend)
+            {
+              slot->nblocks = startblock - slot->blockstart;
+            }
 
-          /* Then move the data that we are keeping to the beginning
-           * the write buffer.
+          /* 5. We invalidate a portion at the beginning of the slot.  The
+           * blocks that we keep do not move because they are stored at
+           * their offset in the page.
            */
 
-          memcpy(rwb->wrbuffer, src, nkeep * rwb->blocksize);
-
-          /* Update the block info.  The first block is now the one just
-           * after the invalidation region and the number buffered blocks
-           * is the number that we kept.
-           */
+          else /* if (slot->blockstart >= startblock && wrbend > invend) */
+            {
+              DEBUGASSERT(slot->blockstart >= startblock && wrbend > invend);
 
-          rwb->wrblockstart = invend;
-          rwb->wrnblocks    = nkeep;
-          ret = OK;
+              slot->blockstart = invend;
+              slot->nblocks    = wrbend - invend;
+            }
         }
 
       rwb_unlock(&rwb->wrlock);
@@ -659,13 +1009,12 @@ int rwb_invalidate_writebuffer(FAR struct rwbuffer_s *rwb,
 int rwb_invalidate_readahead(FAR struct rwbuffer_s *rwb,
                              off_t startblock, size_t blockcount)
 {
+  FAR struct rwb_rhslot_s *slot;
   int ret = OK;
+  int i;
 
-  if (rwb->rhmaxblocks > 0 && rwb->rhnblocks > 0)
+  if (rwb->rhmaxblocks > 0)
     {
-      off_t rhbend;
-      off_t invend;
-
       finfo("startblock=%" PRIdOFF " blockcount=%zu\n",
             startblock, blockcount);
 
@@ -675,94 +1024,238 @@ int rwb_invalidate_readahead(FAR struct rwbuffer_s *rwb,
           return ret;
         }
 
-      /* Now there are five cases:
-       *
-       * 1. We invalidate nothing
+      /* The read-ahead buffers hold no dirty data, so simply drop every
+       * buffer that overlaps the invalidated region.
        */
 
-      rhbend = rwb->rhblockstart + rwb->rhnblocks;
-      invend = startblock + blockcount;
-
-      if (rhbend <= startblock || rwb->rhblockstart >= invend)
+      for (i = 0; i < CONFIG_DRVR_READAHEAD_NSTREAMS; i++)
         {
-          ret = OK;
+          slot = &rwb->rhslot[i];
+          if (slot->nblocks > 0 &&
+              rwb_overlap(slot->blockstart, slot->nblocks,
+                          startblock, blockcount))
+            {
+              slot->nblocks    = 0;
+              slot->blockstart = -1;
+            }
         }
 
-      /* 2. We invalidate the entire read-ahead buffer. */
+      rwb_unlock(&rwb->rhlock);
+    }
 
-      else if (rwb->rhblockstart >= startblock && rhbend <= invend)
-        {
-          rwb->rhnblocks = 0;
-          ret = OK;
-        }
+  return ret;
+}
+#endif
 
-      /* We are going to invalidate a subset of the read-ahead buffer.
-       * Three more cases to consider:
-       *
-       * 2. We invalidate a portion in the middle of the read-ahead buffer
-       */
+/****************************************************************************
+ * Name: rwb_procfs_open
+ ****************************************************************************/
 
-      else if (rwb->rhblockstart < startblock && rhbend > invend)
-        {
-          /* Keep the blocks at the beginning of the buffer up the
-           * start of the invalidated region.
-           */
+#if defined(CONFIG_DRVR_RWBUFFER_STATS) && defined(CONFIG_FS_PROCFS)
+static int rwb_procfs_open(FAR struct file *filep, FAR const char *relpath,
+                           int oflags, mode_t mode)
+{
+  FAR struct rwb_procfs_file_s *rwbfile;
+  FAR struct rwbuffer_s *rwb;
+  unsigned int nentries = 0;
+  irqstate_t flags;
 
-          rwb->rhnblocks = startblock - rwb->rhblockstart;
-          ret = OK;
-        }
+  finfo("Open '%s'\n", relpath);
 
-      /* 3. We invalidate a portion at the end of the read-ahead buffer */
+  /* This PROCFS file is read-only.  Any attempt to open with write access
+   * is not permitted.
+   */
 
-      else if (rhbend > startblock && rhbend <= invend)
-        {
-          rwb->rhnblocks -= rhbend - startblock;
-          ret = OK;
-        }
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
 
-      /* 4. We invalidate a portion at the begin of the read-ahead buffer */
+  /* Count the buffers and allocate room for a snapshot of all of them */
 
-      else /* if (rwb->rhblockstart >= startblock && rhbend > invend) */
-        {
-          FAR uint8_t *src;
-          size_t ninval;
-          size_t nkeep;
+  flags = enter_critical_section();
+  for (rwb = g_rwb_list; rwb != NULL; rwb = rwb->flink)
+    {
+      nentries++;
+    }
 
-          DEBUGASSERT(rwb->rhblockstart >= startblock && rhbend > invend);
-          /* Copy the data from the uninvalidated region to the beginning
-           * of the read buffer.
-           *
-           * First calculate the source and destination of the transfer.
-           */
+  leave_critical_section(flags);
 
-          ninval = invend - rwb->rhblockstart;
-          src    = rwb->rhbuffer + ninval * rwb->blocksize;
+  rwbfile = kmm_zalloc(SIZEOF_RWB_PROCFS_FILE_S(nentries + 1));
+  if (rwbfile == NULL)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
 
-          /* Calculate the number of blocks we are keeping.  We keep
-           * the ones that we don't invalidate.
-           */
+  /* Take the snapshot.  Buffers may have come and gone in between. */
 
-          nkeep  = rwb->rhnblocks - ninval;
+  flags = enter_critical_section();
+  for (rwb = g_rwb_list;
+       rwb != NULL && rwbfile->nentries <= nentries;
+       rwb = rwb->flink)
+    {
+      rwbfile->entry[rwbfile->nentries].dev       = rwb->dev;
+      rwbfile->entry[rwbfile->nentries].blocksize = rwb->blocksize;
+      rwbfile->entry[rwbfile->nentries].stats     = rwb->stats;
+      rwbfile->nentries++;
+    }
 
-          /* Then move the data that we are keeping to the beginning
-           * the read buffer.
-           */
+  leave_critical_section(flags);
 
-          memmove(rwb->rhbuffer, src, nkeep * rwb->blocksize);
+  /* Save the attributes as the open-specific state in filep->f_priv */
 
-          /* Update the block info.  The first block is now the one just
-           * after the invalidation region and the number buffered blocks
-           * is the number that we kept.
-           */
+  filep->f_priv = (FAR void *)rwbfile;
+  return OK;
+}
+#endif
 
-          rwb->rhblockstart = invend;
-          rwb->rhnblocks    = nkeep;
-        }
+/****************************************************************************
+ * Name: rwb_procfs_close
+ ****************************************************************************/
 
-      rwb_unlock(&rwb->rhlock);
+#if defined(CONFIG_DRVR_RWBUFFER_STATS) && defined(CONFIG_FS_PROCFS)
+static int rwb_procfs_close(FAR struct file *filep)
+{
+  FAR struct rwb_procfs_file_s *rwbfile;
+
+  /* Recover our private data from the struct file instance */
+
+  rwbfile = (FAR struct rwb_procfs_file_s *)filep->f_priv;
+  DEBUGASSERT(rwbfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(rwbfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_procfs_read
+ ****************************************************************************/
+
+#if defined(CONFIG_DRVR_RWBUFFER_STATS) && defined(CONFIG_FS_PROCFS)
+static ssize_t rwb_procfs_read(FAR struct file *filep, FAR char *buffer,
+                               size_t buflen)
+{
+  FAR struct rwb_procfs_file_s *rwbfile;
+  FAR struct rwb_procfs_entry_s *entry;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  unsigned int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  rwbfile = (FAR struct rwb_procfs_file_s *)filep->f_priv;
+  DEBUGASSERT(rwbfile);
+
+  offset = filep->f_pos;
+
+  /* The first line to output is the header */
+
+  linesize  = procfs_snprintf(rwbfile->line, RWB_LINELEN, RWB_HDR_FMT,
+                              RWB_ADDRWIDTH, "DEVICE");
+  copysize  = procfs_memcpy(rwbfile->line, linesize, buffer, buflen,
+                            &offset);
+  totalsize = copysize;
+
+  /* Then one line for each buffer */
+
+  for (i = 0; i < rwbfile->nentries && totalsize < buflen; i++)
+    {
+      entry = &rwbfile->entry[i];
+
+      linesize   = procfs_snprintf(rwbfile->line, RWB_LINELEN, RWB_FMT,
+                                   RWB_ADDRWIDTH,
+                                   (unsigned long)(uintptr_t)entry->dev,
+                                   entry->blocksize,
+                                   (unsigned long)entry->stats.rdblocks,
+                                   (unsigned long)entry->stats.rdhits,
+                                   (unsigned long)entry->stats.rhloads,
+                                   (unsigned long)entry->stats.rhblocks,
+                                   (unsigned long)entry->stats.wrblocks,
+                                   (unsigned long)entry->stats.wrflushes,
+                                   (unsigned long)
+                                   entry->stats.wrflushblocks);
+      copysize   = procfs_memcpy(rwbfile->line, linesize,
+                                 buffer + totalsize, buflen - totalsize,
+                                 &offset);
+      totalsize += copysize;
     }
 
-  return ret;
+  /* Update the file offset */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_procfs_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_DRVR_RWBUFFER_STATS) && defined(CONFIG_FS_PROCFS)
+static int rwb_procfs_dup(FAR const struct file *oldp,
+                          FAR struct file *newp)
+{
+  FAR struct rwb_procfs_file_s *oldattr;
+  FAR struct rwb_procfs_file_s *newattr;
+  size_t allocsize;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct rwb_procfs_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  allocsize = SIZEOF_RWB_PROCFS_FILE_S(oldattr->nentries + 1);
+  newattr   = kmm_malloc(allocsize);
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, allocsize);
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_procfs_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_DRVR_RWBUFFER_STATS) && defined(CONFIG_FS_PROCFS)
+static int rwb_procfs_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "rwbuffer" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
 }
 #endif
 
@@ -777,6 +1270,10 @@ int rwb_invalidate_readahead(FAR struct rwbuffer_s *rwb,
 int rwb_initialize(FAR struct rwbuffer_s *rwb)
 {
   uint32_t allocsize;
+#ifdef CONFIG_DRVR_RWBUFFER_STATS
+  irqstate_t flags;
+#endif
+  int i;
 
   /* Sanity checking */
 
@@ -816,19 +1313,27 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
       /* Initialize write buffer parameters */
 
       rwb_resetwrbuffer(rwb);
+      rwb->wrstamp = 0;
 
-      /* Allocate the write buffer */
+      /* Allocate the write buffer, one page for each slot */
 
       allocsize     = rwb->wrmaxblocks * rwb->blocksize;
-      rwb->wrbuffer = kmm_malloc(allocsize);
+      rwb->wrbuffer = kmm_malloc(allocsize * CONFIG_DRVR_WRITEBUFFER_NSLOTS);
       if (!rwb->wrbuffer)
         {
-          ferr("Write buffer kmm_malloc(%" PRIu32 ") failed\n", allocsize);
+          ferr("Write buffer kmm_malloc(%" PRIu32 ") failed\n",
+               allocsize * CONFIG_DRVR_WRITEBUFFER_NSLOTS);
           nxmutex_destroy(&rwb->wrlock);
           return -ENOMEM;
         }
 
-      finfo("Write buffer size: %" PRIu32 " bytes\n", allocsize);
+      for (i = 0; i < CONFIG_DRVR_WRITEBUFFER_NSLOTS; i++)
+        {
+          rwb->wrslot[i].buffer = rwb->wrbuffer + i * allocsize;
+        }
+
+      finfo("Write buffer size: %" PRIu32 " bytes\n",
+            allocsize * CONFIG_DRVR_WRITEBUFFER_NSLOTS);
     }
 #endif /* CONFIG_DRVR_WRITEBUFFER */
 
@@ -844,15 +1349,17 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
       /* Initialize read-ahead buffer parameters */
 
       rwb_resetrhbuffer(rwb);
+      rwb->rhstamp = 0;
 
-      /* Allocate the read-ahead buffer */
+      /* Allocate the read-ahead buffer, one for each stream */
 
       allocsize     = rwb->rhmaxblocks * rwb->blocksize;
-      rwb->rhbuffer = kmm_malloc(allocsize);
+      rwb->rhbuffer = kmm_malloc(allocsize *
+                                 CONFIG_DRVR_READAHEAD_NSTREAMS);
       if (!rwb->rhbuffer)
         {
           ferr("Read-ahead buffer kmm_malloc(%" PRIu32 ") failed\n",
-          allocsize);
+          allocsize * CONFIG_DRVR_READAHEAD_NSTREAMS);
           nxmutex_destroy(&rwb->rhlock);
 #ifdef CONFIG_DRVR_WRITEBUFFER
           if (rwb->wrmaxblocks > 0)
@@ -869,10 +1376,26 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
           return -ENOMEM;
         }
 
-      finfo("Read-ahead buffer size: %" PRIu32 " bytes\n", allocsize);
+      for (i = 0; i < CONFIG_DRVR_READAHEAD_NSTREAMS; i++)
+        {
+          rwb->rhslot[i].buffer = rwb->rhbuffer + i * allocsize;
+          rwb->rhslot[i].stamp  = 0;
+        }
+
+      finfo("Read-ahead buffer size: %" PRIu32 " bytes\n",
+            allocsize * CONFIG_DRVR_READAHEAD_NSTREAMS);
     }
 #endif /* CONFIG_DRVR_READAHEAD */
 
+#ifdef CONFIG_DRVR_RWBUFFER_STATS
+  memset(&rwb->stats, 0, sizeof(struct rwb_stats_s));
+
+  flags      = enter_critical_section();
+  rwb->flink = g_rwb_list;
+  g_rwb_list = rwb;
+  leave_critical_section(flags);
+#endif
+
   return OK;
 }
 
@@ -882,6 +1405,23 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
 
 void rwb_uninitialize(FAR struct rwbuffer_s *rwb)
 {
+#ifdef CONFIG_DRVR_RWBUFFER_STATS
+  FAR struct rwbuffer_s **curr;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  for (curr = &g_rwb_list; *curr != NULL; curr = &(*curr)->flink)
+    {
+      if (*curr == rwb)
+        {
+          *curr = rwb->flink;
+          break;
+        }
+    }
+
+  leave_critical_section(flags);
+#endif
+
 #ifdef CONFIG_DRVR_WRITEBUFFER
   if (rwb->wrmaxblocks > 0)
     {
@@ -919,7 +1459,9 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
 #ifdef CONFIG_DRVR_READAHEAD
   if (rwb->rhmaxblocks > 0)
     {
+      FAR struct rwb_rhslot_s *slot;
       size_t remaining;
+      bool reloaded = false;
 
       ret = rwb_lock(&rwb->rhlock);
       if (ret < 0)
@@ -931,38 +1473,44 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
 
       for (remaining = nblocks; remaining > 0; )
         {
-          /* Is there anything in the read-ahead buffer? */
+          /* Is the next block in one of the read-ahead buffers? */
 
-          if (rwb->rhnblocks > 0)
+          slot = rwb_rhfind(rwb, startblock);
+          if (slot != NULL)
             {
-              off_t bufferend;
-
-              /* How many blocks are available in this buffer? */
-
-              bufferend = rwb->rhblockstart + rwb->rhnblocks;
-              if (startblock >= rwb->rhblockstart && startblock < bufferend)
+              size_t rdblocks = slot->blockstart + slot->nblocks -
+                                startblock;
+              if (rdblocks > remaining)
                 {
-                  size_t rdblocks = bufferend - startblock;
-                  if (rdblocks > remaining)
-                    {
-                      rdblocks = remaining;
-                    }
+                  rdblocks = remaining;
+                }
 
-                  /* Then read the data from the read-ahead buffer */
+              /* Then read the data from the read-ahead buffer */
 
-                  rwb_bufferread(rwb, startblock, rdblocks, &rdbuffer);
-                  startblock += rdblocks;
-                  remaining  -= rdblocks;
+              memcpy(rdbuffer, slot->buffer + (startblock -
+                     slot->blockstart) * rwb->blocksize,
+                     rdblocks * rwb->blocksize);
+
+              if (!reloaded)
+                {
+                  rwb_stats(rwb, rdhits, rdblocks);
                 }
+
+              rdbuffer        += rdblocks * rwb->blocksize;
+              startblock      += rdblocks;
+              remaining       -= rdblocks;
+              slot->nextblock  = startblock;
+              slot->stamp      = ++rwb->rhstamp;
+              reloaded         = false;
             }
 
-          /* If we did not get all of the data from the buffer, then we have
-           * to refill the buffer and try again.
+          /* If we did not get all of the data from the buffers, then we
+           * have to refill a buffer and try again.
            */
 
-          if (remaining > 0)
+          else
             {
-              ret = rwb_rhreload(rwb, startblock);
+              ret = rwb_rhreload(rwb, startblock, remaining);
               if (ret < 0)
                 {
                   ferr("ERROR: Failed to fill the read-ahead buffer: %d\n",
@@ -971,6 +1519,8 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
                   rwb_unlock(&rwb->rhlock);
                   return ret;
                 }
+
+              reloaded = true;
             }
         }
 
@@ -1002,12 +1552,11 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
 ssize_t rwb_read(FAR struct rwbuffer_s *rwb, off_t startblock,
                  size_t nblocks, FAR uint8_t *rdbuffer)
 {
-  int ret = OK;
-  size_t readblocks = 0;
-
   finfo("startblock=%ld nblocks=%ld rdbuffer=%p\n",
         (long)startblock, (long)nblocks, rdbuffer);
 
+  rwb_stats(rwb, rdblocks, nblocks);
+
 #ifdef CONFIG_DRVR_WRITEBUFFER
   /* If the new read data overlaps any part of the write buffer, we
    * directly copy write buffer to read buffer. This boost performance.
@@ -1015,63 +1564,88 @@ ssize_t rwb_read(FAR struct rwbuffer_s *rwb, off_t startblock,
 
   if (rwb->wrmaxblocks > 0)
     {
+      FAR struct rwb_wrslot_s *slot = NULL;
+      size_t readblocks = 0;
+      int ret;
+
       ret = rwb_lock(&rwb->wrlock);
       if (ret < 0)
         {
           return ret;
         }
 
-      /* If the write buffer overlaps the block(s) requested */
-
-      if (rwb_overlap(rwb->wrblockstart, rwb->wrnblocks, startblock,
-                      nblocks))
+      while (readblocks < nblocks)
         {
-          size_t rdblocks = 0;
-          size_t wrnpass  = 0;
+          off_t  endblock = startblock + nblocks - readblocks;
+          size_t rdblocks;
+          int    i;
 
-          if (rwb->wrblockstart > startblock)
+          /* Find the write slot holding the next block or else the first
+           * write slot after the next block.
+           */
+
+          for (i = 0; i < CONFIG_DRVR_WRITEBUFFER_NSLOTS; i++)
             {
-              rdblocks = rwb->wrblockstart - startblock;
-              ret = rwb_read_(rwb, startblock, rdblocks, rdbuffer);
-              if (ret < 0)
+              slot = &rwb->wrslot[i];
+              if (slot->nblocks == 0)
                 {
-                  rwb_unlock(&rwb->wrlock);
-                  return ret;
+                  continue;
+                }
+
+              if (startblock >= slot->blockstart &&
+                  startblock < slot->blockstart + slot->nblocks)
+                {
+                  break;
                 }
 
-              startblock += ret;
-              nblocks    -= ret;
-              rdbuffer   += ret * rwb->blocksize;
-              readblocks += ret;
+              if (slot->blockstart > startblock &&
+                  slot->blockstart < endblock)
+                {
+                  endblock = slot->blockstart;
+                }
             }
 
-          if (rwb->wrblockstart < startblock)
+          if (i < CONFIG_DRVR_WRITEBUFFER_NSLOTS)
             {
-              wrnpass = startblock - rwb->wrblockstart;
+              /* Copy the buffered blocks */
+
+              rdblocks = slot->blockstart + slot->nblocks - startblock;
+              if (rdblocks > nblocks - readblocks)
+                {
+                  rdblocks = nblocks - readblocks;
+                }
+
+              memcpy(rdbuffer, slot->buffer + (startblock %
+                     rwb->wrmaxblocks) * rwb->blocksize,
+                     rdblocks * rwb->blocksize);
+              rwb_stats(rwb, rdhits, rdblocks);
             }
+          else
+            {
+              /* Read up to the next buffered block */
 
-          rdblocks = nblocks > (rwb->wrnblocks - wrnpass) ?
-                    (rwb->wrnblocks - wrnpass) : nblocks;
-          memcpy(rdbuffer, &rwb->wrbuffer[wrnpass * rwb->blocksize],
-                rdblocks * rwb->blocksize);
+              ret = rwb_read_(rwb, startblock, endblock - startblock,
+                              rdbuffer);
+              if (ret < 0)
+                {
+                  rwb_unlock(&rwb->wrlock);
+                  return ret;
+                }
+
+              rdblocks = ret;
+            }
 
           startblock += rdblocks;
-          nblocks    -= rdblocks;
           rdbuffer   += rdblocks * rwb->blocksize;
           readblocks += rdblocks;
         }
 
       rwb_unlock(&rwb->wrlock);
+      return readblocks;
     }
 #endif
 
-  ret = rwb_read_(rwb, startblock, nblocks, rdbuffer);
-  if (ret < 0)
-    {
-      return ret;
-    }
-
-  return readblocks + ret;
+  return rwb_read_(rwb, startblock, nblocks, rdbuffer);
 }
 
 /****************************************************************************
@@ -1084,39 +1658,14 @@ ssize_t rwb_write(FAR struct rwbuffer_s *rwb, off_t startblock,
   int ret = OK;
 
 #ifdef CONFIG_DRVR_READAHEAD
-  if (rwb->rhmaxblocks > 0)
-    {
-      /* If the new write data overlaps any part of the read buffer, then
-       * flush the data from the read buffer.  We could attempt some more
-       * exotic handling -- but this simple logic is well-suited for simple
-       * streaming applications.
-       */
-
-      ret = rwb_lock(&rwb->rhlock);
-      if (ret < 0)
-        {
-          return ret;
-        }
-
-      if (rwb_overlap(rwb->rhblockstart, rwb->rhnblocks, startblock,
-                      nblocks))
-        {
-#ifdef CONFIG_DRVR_INVALIDATE
-          /* Just invalidate the read buffer startblock + nblocks data */
-
-          ret = rwb_invalidate_readahead(rwb, startblock, nblocks);
-          if (ret < 0)
-            {
-              ferr("ERROR: rwb_invalidate_readahead failed: %d\n", ret);
-              rwb_unlock(&rwb->rhlock);
-              return ret;
-            }
-#else
-          rwb_resetrhbuffer(rwb);
-#endif
-        }
+  /* If the new write data overlaps any part of a read-ahead buffer, then
+   * update the read-ahead buffer with the new data so that it stays valid.
+   */
 
-      rwb_unlock(&rwb->rhlock);
+  ret = rwb_rhupdate(rwb, wrbuffer, startblock, nblocks);
+  if (ret < 0)
+    {
+      return ret;
     }
 #endif
 
@@ -1360,6 +1360,87 @@ bool netpkt_is_fragmented(FAR netpkt_t *pkt)
   return pkt->io_flink != NULL;
 }
 
+#ifdef CONFIG_NETDEV_CHECKSUM_OFFLOAD
+/****************************************************************************
+ * Name: netpkt_getcsum
+ *
+ * Description:
+ *   Check if the checksum of a TX packet is left to the device.
+ *
+ * Input Parameters:
+ *   dev    - The lower half device driver structure
+ *   pkt    - The net packet
+ *   start  - Returns the offset of netpkt where the checksum starts
+ *   offset - Returns the offset of the checksum field from 'start'
+ *
+ * Returned Value:
+ *   true if the device must complete the checksum.
+ *
+ ****************************************************************************/
+
+bool netpkt_getcsum(FAR struct netdev_lowerhalf_s *dev, FAR netpkt_t *pkt,
+                    FAR unsigned int *start, FAR unsigned int *offset)
+{
+  if ((pkt->io_csumflags & IOB_CSUM_PARTIAL) == 0)
+    {
+      return false;
+    }
+
+  *start  = pkt->io_csumstart + NET_LL_HDRLEN(&dev->netdev);
+  *offset = pkt->io_csumoffset;
+  return true;
+}
+
+/****************************************************************************
+ * Name: netpkt_setcsum_valid
+ *
+ * Description:
+ *   Mark the TCP or UDP checksum of an RX packet as verified by the device.
+ *
+ * Input Parameters:
+ *   dev    - The lower half device driver structure
+ *   pkt    - The net packet
+ *
+ ****************************************************************************/
+
+void netpkt_setcsum_valid(FAR struct netdev_lowerhalf_s *dev,
+                          FAR netpkt_t *pkt)
+{
+  pkt->io_csumflags = IOB_CSUM_VALID;
+}
+
+/****************************************************************************
+ * Name: netpkt_csum_complete
+ *
+ * Description:
+ *   Complete a partial checksum in software.
+ *
+ * Input Parameters:
+ *   dev    - The lower half device driver structure
+ *   pkt    - The net packet
+ *   start  - The offset of netpkt where the checksum starts
+ *   offset - The offset of the checksum field from 'start'
+ *
+ * Returned Value:
+ *   0:Success; negated errno on failure
+ *
+ ****************************************************************************/
+
+int netpkt_csum_complete(FAR struct netdev_lowerhalf_s *dev,
+                         FAR netpkt_t *pkt, unsigned int start,
+                         unsigned int offset)
+{
+  unsigned int llhdrlen = NET_LL_HDRLEN(&dev->netdev);
+
+  if (start < llhdrlen)
+    {
+      return -EINVAL;
+    }
+
+  return netdev_csum_complete(pkt, start - llhdrlen, offset);
+}
+#endif
+
 /****************************************************************************
  * Name: netpkt_to_iov
  *
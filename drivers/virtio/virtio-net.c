@@ -56,6 +56,16 @@
 #define VIRTIO_NET_MAX_NIOB \
     ((VIRTIO_NET_MAX_PKT_SIZE + CONFIG_IOB_BUFSIZE - 1) / CONFIG_IOB_BUFSIZE)
 
+/* Virtio net feature bits */
+
+#define VIRTIO_NET_F_CSUM           0  /* Device handles partial checksum */
+#define VIRTIO_NET_F_GUEST_CSUM     1  /* Driver handles partial checksum */
+
+/* Virtio net header flags */
+
+#define VIRTIO_NET_HDR_F_NEEDS_CSUM 1  /* csum_start and csum_offset valid */
+#define VIRTIO_NET_HDR_F_DATA_VALID 2  /* Checksum verified by the device */
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -232,6 +242,35 @@ static void virtio_net_rxfill(FAR struct netdev_lowerhalf_s *dev)
     }
 }
 
+#ifdef CONFIG_NETDEV_CHECKSUM_OFFLOAD
+/****************************************************************************
+ * Name: virtio_net_rxcsum
+ ****************************************************************************/
+
+static void virtio_net_rxcsum(FAR struct netdev_lowerhalf_s *dev,
+                              FAR struct virtio_net_llhdr_s *hdr)
+{
+  if ((hdr->vhdr.flags & VIRTIO_NET_HDR_F_NEEDS_CSUM) != 0)
+    {
+      /* Packets from the host itself may carry only the pseudo-header
+       * sum, complete it before the stack sees the packet.
+       */
+
+      if (netpkt_csum_complete(dev, hdr->pkt, hdr->vhdr.csum_start,
+                               hdr->vhdr.csum_offset) < 0)
+        {
+          return;
+        }
+
+      netpkt_setcsum_valid(dev, hdr->pkt);
+    }
+  else if ((hdr->vhdr.flags & VIRTIO_NET_HDR_F_DATA_VALID) != 0)
+    {
+      netpkt_setcsum_valid(dev, hdr->pkt);
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: virtio_net_txfree
  ****************************************************************************/
@@ -317,6 +356,10 @@ static int virtio_net_send(FAR struct netdev_lowerhalf_s *dev,
   FAR struct virtio_net_llhdr_s *hdr;
   struct virtqueue_buf vb[VIRTIO_NET_MAX_NIOB];
   struct iovec iov[VIRTIO_NET_MAX_NIOB];
+#ifdef CONFIG_NETDEV_CHECKSUM_OFFLOAD
+  unsigned int csum_start;
+  unsigned int csum_offset;
+#endif
   int iov_cnt;
   int i;
 
@@ -345,6 +388,17 @@ static int virtio_net_send(FAR struct netdev_lowerhalf_s *dev,
   hdr->pkt = pkt;
   memset(&hdr->vhdr, 0, sizeof(hdr->vhdr));
 
+#ifdef CONFIG_NETDEV_CHECKSUM_OFFLOAD
+  /* Let the device complete the checksum if the stack left it */
+
+  if (netpkt_getcsum(dev, pkt, &csum_start, &csum_offset))
+    {
+      hdr->vhdr.flags       = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+      hdr->vhdr.csum_start  = csum_start;
+      hdr->vhdr.csum_offset = csum_offset;
+    }
+#endif
+
   /* Buffer 0 is the virtio net header */
 
   vb[0].buf = &hdr->vhdr;
@@ -409,6 +463,10 @@ static netpkt_t *virtio_net_recv(FAR struct netdev_lowerhalf_s *dev)
   /* Set the received pkt length */
 
   netpkt_setdatalen(dev, hdr->pkt, len - VIRTIO_NET_HDRSIZE);
+#ifdef CONFIG_NETDEV_CHECKSUM_OFFLOAD
+  virtio_net_rxcsum(dev, hdr);
+#endif
+
   vrtinfo("Recv, hdr=%p, pkt=%p, len=%" PRIu32 "\n", hdr, hdr->pkt, len);
   return hdr->pkt;
 }
@@ -487,7 +545,12 @@ static int virtio_net_init(FAR struct virtio_net_priv_s *priv,
   /* Initialize the virtio device */
 
   virtio_set_status(vdev, VIRTIO_CONFIG_STATUS_DRIVER);
+#ifdef CONFIG_NETDEV_CHECKSUM_OFFLOAD
+  vdev->func->negotiate_features(vdev, (1 << VIRTIO_NET_F_CSUM) |
+                                       (1 << VIRTIO_NET_F_GUEST_CSUM));
+#else
   virtio_set_features(vdev, 0);
+#endif
   virtio_set_status(vdev, VIRTIO_CONFIG_FEATURES_OK);
 
   vqnames[VIRTIO_NET_RX]   = "virtio_net_rx";
@@ -551,6 +614,18 @@ static int virtio_net_probe(FAR struct virtio_device *vdev)
   netdev->quota[NETPKT_TX] = priv->bufnum;
   netdev->ops = &g_virtio_net_ops;
 
+#ifdef CONFIG_NETDEV_CHECKSUM_OFFLOAD
+  if ((vdev->features & (1 << VIRTIO_NET_F_CSUM)) != 0)
+    {
+      netdev->netdev.d_features |= NETDEV_F_TXCSUM;
+    }
+
+  if ((vdev->features & (1 << VIRTIO_NET_F_GUEST_CSUM)) != 0)
+    {
+      netdev->netdev.d_features |= NETDEV_F_RXCSUM;
+    }
+#endif
+
   /* Register the net deivce */
 
   ret = netdev_lower_register(netdev, NET_LL_ETHERNET);
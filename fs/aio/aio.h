@@ -48,6 +48,35 @@
 #  define CONFIG_FS_NAIOC 8
 #endif
 
+/* Number of dedicated AIO worker threads.  Zero selects the low priority
+ * work queue.
+ */
+
+#ifndef CONFIG_FS_AIO_NWORKERS
+#  define CONFIG_FS_AIO_NWORKERS 0
+#endif
+
+/* The low priority work queue is boosted to the priority of the waiting
+ * task by aio_queue() and must be restored by the worker function.  The
+ * dedicated AIO workers manage their priority by themselves.
+ */
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+#  if CONFIG_FS_AIO_NWORKERS > 0
+#    define aio_restorepriority(prio) UNUSED(prio)
+#  else
+#    define aio_restorepriority(prio) lpwork_restorepriority(prio)
+#  endif
+#endif
+
+/* The priority of the waiting task is needed for priority inheritance and
+ * to order the queue of the dedicated AIO workers.
+ */
+
+#if defined(CONFIG_PRIORITY_INHERITANCE) || CONFIG_FS_AIO_NWORKERS > 0
+#  define AIO_HAVE_PRIO 1
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -65,7 +94,7 @@ struct aio_container_s
   FAR struct file *aioc_filep;     /* File structure to use with the I/O */
   struct work_s aioc_work;         /* Used to defer I/O to the work thread */
   pid_t aioc_pid;                  /* ID of the waiting task */
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#ifdef AIO_HAVE_PRIO
   uint8_t aioc_prio;               /* Priority of the waiting task */
 #endif
 };
@@ -206,7 +235,8 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
  * Name: aio_queue
  *
  * Description:
- *   Schedule the asynchronous I/O on the low priority work queue
+ *   Schedule the asynchronous I/O on the low priority work queue or on the
+ *   dedicated AIO worker threads
  *
  * Input Parameters:
  *   arg - Worker argument.  In this case, a pointer to an instance of
@@ -220,6 +250,26 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
 
 int aio_queue(FAR struct aio_container_s *aioc, worker_t worker);
 
+/****************************************************************************
+ * Name: aio_dequeue
+ *
+ * Description:
+ *   Remove an asynchronous I/O from the queue if it has not been started.
+ *
+ * Input Parameters:
+ *   aioc - The AIO container of the I/O
+ *
+ * Returned Value:
+ *   Zero (OK) if the I/O was removed from the queue.  A negated errno value
+ *   is returned if the I/O is already running or has completed.
+ *
+ * Assumptions:
+ *   The caller holds the AIO lock.
+ *
+ ****************************************************************************/
+
+int aio_dequeue(FAR struct aio_container_s *aioc);
+
 /****************************************************************************
  * Name: aio_signal
  *
@@ -30,21 +30,212 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/kthread.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/wqueue.h>
 
 #include "aio/aio.h"
 
 #ifdef CONFIG_FS_AIO
 
+#if CONFIG_FS_AIO_NWORKERS > 0
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Asynchronous I/O waiting for a dedicated worker thread, highest
+ * priority first.  The queue is protected by the AIO lock.
+ */
+
+static dq_queue_t g_aio_workq;
+
+/* Counts the queued I/O and wakes up the workers */
+
+static sem_t g_aio_worksem = SEM_INITIALIZER(0);
+
+/* True once the worker threads have been started */
+
+static bool g_aio_started;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: aio_worker
+ *
+ * Description:
+ *   The main loop of one dedicated AIO worker thread.  I/O that was
+ *   cancelled while queued leaves a surplus count on the semaphore, which
+ *   is simply skipped.
+ *
+ ****************************************************************************/
+
+static int aio_worker(int argc, FAR char *argv[])
+{
+  FAR struct aio_container_s *aioc;
+  FAR dq_entry_t *entry;
+  worker_t worker;
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  struct sched_param param;
+  int prio;
+#endif
+
+  for (; ; )
+    {
+      nxsem_wait_uninterruptible(&g_aio_worksem);
+
+      if (aio_lock() < 0)
+        {
+          /* Give the count back so that the I/O is not lost */
+
+          nxsem_post(&g_aio_worksem);
+          continue;
+        }
+
+      entry = dq_remfirst(&g_aio_workq);
+      if (entry == NULL)
+        {
+          aio_unlock();
+          continue;
+        }
+
+      /* A NULL worker marks the I/O as started for aio_dequeue() */
+
+      aioc   = container_of(entry, struct aio_container_s,
+                            aioc_work.u.s.dq);
+      worker = aioc->aioc_work.worker;
+      aioc->aioc_work.worker = NULL;
+#ifdef CONFIG_PRIORITY_INHERITANCE
+      prio   = aioc->aioc_prio;
+#endif
+      aio_unlock();
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+      /* Run the I/O at the priority of the waiting task if it is higher */
+
+      if (prio > CONFIG_FS_AIO_PRIORITY)
+        {
+          param.sched_priority = prio;
+          nxsched_set_param(0, &param);
+        }
+#endif
+
+      worker(aioc);
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+      if (prio > CONFIG_FS_AIO_PRIORITY)
+        {
+          param.sched_priority = CONFIG_FS_AIO_PRIORITY;
+          nxsched_set_param(0, &param);
+        }
+#endif
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aio_priority
+ *
+ * Description:
+ *   The priority of a request: the priority of the waiting task lowered by
+ *   aio_reqprio.
+ *
+ ****************************************************************************/
+
+static int aio_priority(FAR struct aio_container_s *aioc)
+{
+  return (int)aioc->aioc_prio - aioc->aioc_aiocbp->aio_reqprio;
+}
+
+/****************************************************************************
+ * Name: aio_insert
+ *
+ * Description:
+ *   Add an asynchronous I/O to the queue of the dedicated workers behind
+ *   all I/O of the same or higher priority.
+ *
+ * Assumptions:
+ *   The caller holds the AIO lock.
+ *
+ ****************************************************************************/
+
+static void aio_insert(FAR struct aio_container_s *aioc)
+{
+  FAR struct aio_container_s *next;
+  FAR dq_entry_t *entry;
+  int prio = aio_priority(aioc);
+
+  for (entry = dq_peek(&g_aio_workq); entry != NULL; entry = dq_next(entry))
+    {
+      next = container_of(entry, struct aio_container_s, aioc_work.u.s.dq);
+      if (aio_priority(next) < prio)
+        {
+          dq_addbefore(entry, &aioc->aioc_work.u.s.dq, &g_aio_workq);
+          return;
+        }
+    }
+
+  dq_addlast(&aioc->aioc_work.u.s.dq, &g_aio_workq);
+}
+
+/****************************************************************************
+ * Name: aio_start
+ *
+ * Description:
+ *   Start the dedicated AIO worker threads if that was not done yet.
+ *
+ * Assumptions:
+ *   The caller holds the AIO lock.
+ *
+ ****************************************************************************/
+
+static int aio_start(void)
+{
+  int ret;
+  int i;
+
+  if (g_aio_started)
+    {
+      return OK;
+    }
+
+  for (i = 0; i < CONFIG_FS_AIO_NWORKERS; i++)
+    {
+      ret = kthread_create("aio", CONFIG_FS_AIO_PRIORITY,
+                           CONFIG_FS_AIO_STACKSIZE, aio_worker, NULL);
+      if (ret < 0)
+        {
+          ferr("ERROR: Failed to start AIO worker: %d\n", ret);
+
+          /* Fail only if there is no worker at all */
+
+          if (i == 0)
+            {
+              return ret;
+            }
+
+          break;
+        }
+    }
+
+  g_aio_started = true;
+  return OK;
+}
+#endif /* CONFIG_FS_AIO_NWORKERS > 0 */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
 /****************************************************************************
  * Name: aio_queue
  *
  * Description:
- *   Schedule the asynchronous I/O on the low priority work queue
+ *   Schedule the asynchronous I/O on the low priority work queue or on the
+ *   dedicated AIO worker threads
  *
  * Input Parameters:
  *   arg - Worker argument.  In this case, a pointer to an instance of
@@ -56,6 +247,39 @@
  *
  ****************************************************************************/
 
+#if CONFIG_FS_AIO_NWORKERS > 0
+int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
+{
+  int ret;
+
+  ret = aio_lock();
+  if (ret >= 0)
+    {
+      ret = aio_start();
+      if (ret >= 0)
+        {
+          aioc->aioc_work.worker = worker;
+          aioc->aioc_work.arg    = aioc;
+          aio_insert(aioc);
+        }
+
+      aio_unlock();
+    }
+
+  if (ret < 0)
+    {
+      FAR struct aiocb *aiocbp = aioc->aioc_aiocbp;
+      DEBUGASSERT(aiocbp);
+
+      aiocbp->aio_result = ret;
+      set_errno(-ret);
+      return ERROR;
+    }
+
+  nxsem_post(&g_aio_worksem);
+  return OK;
+}
+#else
 int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
 {
   int ret;
@@ -95,5 +319,40 @@ int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
 #endif
   return ret;
 }
+#endif
+
+/****************************************************************************
+ * Name: aio_dequeue
+ *
+ * Description:
+ *   Remove an asynchronous I/O from the queue if it has not been started.
+ *
+ * Input Parameters:
+ *   aioc - The AIO container of the I/O
+ *
+ * Returned Value:
+ *   Zero (OK) if the I/O was removed from the queue.  A negated errno value
+ *   is returned if the I/O is already running or has completed.
+ *
+ * Assumptions:
+ *   The caller holds the AIO lock.
+ *
+ ****************************************************************************/
+
+int aio_dequeue(FAR struct aio_container_s *aioc)
+{
+#if CONFIG_FS_AIO_NWORKERS > 0
+  if (aioc->aioc_work.worker == NULL)
+    {
+      return -ENOENT;
+    }
+
+  dq_rem(&aioc->aioc_work.u.s.dq, &g_aio_workq);
+  aioc->aioc_work.worker = NULL;
+  return OK;
+#else
+  return work_cancel(LPWORK, &aioc->aioc_work);
+#endif
+}
 
 #endif /* CONFIG_FS_AIO */
@@ -489,6 +489,7 @@ static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
 
 #ifndef CONFIG_FAT_FORCE_INDIRECT
   unsigned int nsectors;
+  uint32_t runcluster;
   bool force_indirect = false;
 #endif
 
@@ -613,15 +614,18 @@ fat_read_restart:
            * buffer without using our tiny read buffer.
            *
            * Limit the number of sectors that we read on this time
-           * through the loop to the remaining contiguous sectors
-           * in this cluster
+           * through the loop to the contiguous sectors in this cluster
+           * and in the clusters following it on the media.
            */
 
-          if (nsectors > ff->ff_sectorsincluster)
+          ret = fat_contiguous(fs, ff, nsectors, &runcluster);
+          if (ret < 0)
             {
-              nsectors = ff->ff_sectorsincluster;
+              goto errout_with_lock;
             }
 
+          nsectors = ret;
+
           /* We are not sure of the state of the file buffer so
            * the safest thing to do is just invalidate it
            */
@@ -654,9 +658,22 @@ fat_read_restart:
               goto errout_with_lock;
             }
 
-          ff->ff_sectorsincluster -= nsectors;
           ff->ff_currentsector    += nsectors;
           bytesread                = nsectors * fs->fs_hwsectorsize;
+
+          if (runcluster != ff->ff_currentcluster)
+            {
+              /* The transfer continued into the following clusters */
+
+              ff->ff_currentcluster   = runcluster;
+              ff->ff_sectorsincluster = fat_cluster2sector(fs, runcluster) +
+                                        fs->fs_fatsecperclus -
+                                        ff->ff_currentsector;
+            }
+          else
+            {
+              ff->ff_sectorsincluster -= nsectors;
+            }
         }
       else
 #endif /* CONFIG_FAT_FORCE_INDIRECT */
@@ -729,6 +746,7 @@ static ssize_t fat_write(FAR struct file *filep, FAR const char *buffer,
 
 #ifndef CONFIG_FAT_FORCE_INDIRECT
   unsigned int nsectors;
+  uint32_t runcluster;
   bool force_indirect = false;
 #endif
 
@@ -864,15 +882,19 @@ fat_write_restart:
            * buffer without using our tiny read buffer.
            *
            * Limit the number of sectors that we write on this time
-           * through the loop to the remaining contiguous sectors
-           * in this cluster
+           * through the loop to the contiguous sectors in this cluster
+           * and in the already allocated clusters following it on the
+           * media.
            */
 
-          if (nsectors > ff->ff_sectorsincluster)
+          ret = fat_contiguous(fs, ff, nsectors, &runcluster);
+          if (ret < 0)
             {
-              nsectors = ff->ff_sectorsincluster;
+              goto errout_with_lock;
             }
 
+          nsectors = ret;
+
           /* We are not sure of the state of the sector cache so the
            * safest thing to do is write back any dirty, cached sector
            * and invalidate the current cache content.
@@ -906,10 +928,24 @@ fat_write_restart:
               goto errout_with_lock;
             }
 
-          ff->ff_sectorsincluster -= nsectors;
           ff->ff_currentsector    += nsectors;
           writesize                = nsectors * fs->fs_hwsectorsize;
-          ff->ff_bflags           |= FFBUFF_MODIFIED;
+
+          if (runcluster != ff->ff_currentcluster)
+            {
+              /* The transfer continued into the following clusters */
+
+              ff->ff_currentcluster   = runcluster;
+              ff->ff_sectorsincluster = fat_cluster2sector(fs, runcluster) +
+                                        fs->fs_fatsecperclus -
+                                        ff->ff_currentsector;
+            }
+          else
+            {
+              ff->ff_sectorsincluster -= nsectors;
+            }
+
+          ff->ff_bflags |= FFBUFF_MODIFIED;
         }
       else
 #endif /* CONFIG_FAT_FORCE_INDIRECT */
@@ -2270,6 +2306,10 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
         }
     }
 
+  /* Write back any FAT sectors still held in the FAT table cache */
+
+  fat_fatcacheflush(fs);
+
   /* Unmount ... close the block driver */
 
   if (fs->fs_blkdriver)
@@ -2297,6 +2337,7 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
 
   /* Release the mountpoint private data */
 
+  fat_cachefree(fs);
   if (fs->fs_buffer)
     {
       fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
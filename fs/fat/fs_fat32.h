@@ -858,6 +858,18 @@
  * is mounted with a fat32 filesystem.
  */
 
+/* This structure describes one sector held in the FAT table cache or in the
+ * directory sector cache of a mountpoint.
+ */
+
+struct fat_cache_s
+{
+  off_t    sector;                 /* The cached sector or -1 if unused */
+  uint32_t stamp;                  /* Cache clock at the last access */
+  bool     dirty;                  /* true: buffer must be written back */
+  uint8_t *buffer;                 /* Buffer that holds the sector */
+};
+
 struct fat_file_s;
 struct fat_mountpt_s
 {
@@ -887,6 +899,17 @@ struct fat_mountpt_s
   uint8_t  fs_fatsecperclus;       /* MBR: Sectors per allocation unit: 2**n, n=0..7 */
   uint8_t *fs_buffer;              /* This is an allocated buffer to hold one
                                     * sector from the device */
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+  off_t    fs_fatlastmiss;         /* Last FAT sector read into the cache */
+  uint8_t *fs_fatbuffer;           /* Buffers of the FAT table cache */
+  struct fat_cache_s fs_fatcache[CONFIG_FAT_FATCACHE_NSECTORS];
+#endif
+#if CONFIG_FAT_DIRCACHE_NSECTORS > 0
+  struct fat_cache_s fs_dircache[CONFIG_FAT_DIRCACHE_NSECTORS];
+#endif
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0 || CONFIG_FAT_DIRCACHE_NSECTORS > 0
+  uint32_t fs_cachestamp;          /* LRU clock of the sector caches */
+#endif
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -1047,6 +1070,10 @@ EXTERN int    fat_removechain(FAR struct fat_mountpt_s *fs,
                               uint32_t cluster);
 EXTERN int32_t fat_extendchain(FAR struct fat_mountpt_s *fs,
                                uint32_t cluster);
+EXTERN int    fat_contiguous(FAR struct fat_mountpt_s *fs,
+                             FAR struct fat_file_s *ff,
+                             unsigned int nsectors,
+                             FAR uint32_t *cluster);
 
 #define fat_createchain(fs) fat_extendchain(fs, 0)
 
@@ -1095,6 +1122,14 @@ EXTERN int    fat_ffcacheread(FAR struct fat_mountpt_s *fs,
 EXTERN int    fat_ffcacheinvalidate(FAR struct fat_mountpt_s *fs,
                                     FAR struct fat_file_s *ff);
 
+/* FAT table and directory sector caches */
+
+EXTERN int    fat_cachealloc(FAR struct fat_mountpt_s *fs);
+EXTERN void   fat_cachefree(FAR struct fat_mountpt_s *fs);
+EXTERN int    fat_fatcacheflush(FAR struct fat_mountpt_s *fs);
+EXTERN int    fat_fatcacheread(FAR struct fat_mountpt_s *fs, off_t sector,
+                               bool dirty, FAR uint8_t **buffer);
+
 /* FSINFO sector support */
 
 EXTERN int    fat_updatefsinfo(FAR struct fat_mountpt_s *fs);
@@ -263,6 +263,187 @@ static int fat_checkbootrecord(struct fat_mountpt_s *fs)
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_writesector
+ *
+ * Description:
+ *   Write one sector to the media.  A sector of the first FAT is written to
+ *   the FAT copies as well.
+ *
+ ****************************************************************************/
+
+static int fat_writesector(FAR struct fat_mountpt_s *fs,
+                           FAR uint8_t *buffer, off_t sector)
+{
+  int ret;
+  int i;
+
+  ret = fat_hwwrite(fs, buffer, sector, 1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Does the sector lie in the FAT region? */
+
+  if (sector >= fs->fs_fatbase &&
+      sector < fs->fs_fatbase + fs->fs_nfatsects)
+    {
+      /* Yes, then make the change in the FAT copy as well */
+
+      for (i = fs->fs_fatnumfats; i >= 2; i--)
+        {
+          sector += fs->fs_nfatsects;
+          ret = fat_hwwrite(fs, buffer, sector, 1);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_cachefind
+ *
+ * Description:
+ *   Return the entry of a sector cache that holds 'sector' or NULL.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0 || CONFIG_FAT_DIRCACHE_NSECTORS > 0
+static FAR struct fat_cache_s *fat_cachefind(FAR struct fat_cache_s *cache,
+                                             int nentries, off_t sector)
+{
+  int i;
+
+  for (i = 0; i < nentries; i++)
+    {
+      if (cache[i].sector == sector)
+        {
+          return &cache[i];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: fat_cachevictim
+ *
+ * Description:
+ *   Return the entry of a sector cache to be replaced next: An unused entry
+ *   if there is one, otherwise the least recently used entry.
+ *
+ ****************************************************************************/
+
+static FAR struct fat_cache_s *fat_cachevictim(FAR struct fat_mountpt_s *fs,
+                                               FAR struct fat_cache_s *cache,
+                                               int nentries)
+{
+  FAR struct fat_cache_s *victim = &cache[0];
+  uint32_t age = 0;
+  int i;
+
+  for (i = 0; i < nentries; i++)
+    {
+      if (cache[i].sector < 0)
+        {
+          return &cache[i];
+        }
+
+      if (fs->fs_cachestamp - cache[i].stamp > age)
+        {
+          age    = fs->fs_cachestamp - cache[i].stamp;
+          victim = &cache[i];
+        }
+    }
+
+  return victim;
+}
+#endif
+
+/****************************************************************************
+ * Name: fat_cacheisold
+ *
+ * Description:
+ *   Return true if the entry of a sector cache is unused or is one of the
+ *   'nold' least recently used entries.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+static bool fat_cacheisold(FAR struct fat_mountpt_s *fs,
+                           FAR struct fat_cache_s *cache, int nentries,
+                           FAR struct fat_cache_s *entry, int nold)
+{
+  uint32_t age = fs->fs_cachestamp - entry->stamp;
+  int nolder = 0;
+  int i;
+
+  if (entry->sector < 0)
+    {
+      return true;
+    }
+
+  /* Count the entries that would be replaced before this one */
+
+  for (i = 0; i < nentries && nolder < nold; i++)
+    {
+      if (cache[i].sector < 0 || fs->fs_cachestamp - cache[i].stamp > age)
+        {
+          nolder++;
+        }
+    }
+
+  return nolder < nold;
+}
+#endif
+
+/****************************************************************************
+ * Name: fat_fatreadahead
+ *
+ * Description:
+ *   Return the number of FAT sectors to read into the FAT table cache
+ *   starting at the entry 'victim' when 'sector' is missing.  Cluster
+ *   chains are mostly walked in ascending order, so a miss that continues
+ *   the previous one also fills the following entries, as long as they
+ *   are clean and in the least recently used half of the cache.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+static unsigned int fat_fatreadahead(FAR struct fat_mountpt_s *fs,
+                                     FAR struct fat_cache_s *victim,
+                                     off_t sector)
+{
+  FAR struct fat_cache_s *end =
+    &fs->fs_fatcache[CONFIG_FAT_FATCACHE_NSECTORS];
+  off_t fatend = fs->fs_fatbase + fs->fs_nfatsects;
+  unsigned int nsectors = 1;
+
+  if (sector != fs->fs_fatlastmiss + 1)
+    {
+      return 1;
+    }
+
+  while (victim + nsectors < end && !victim[nsectors].dirty &&
+         fat_cacheisold(fs, fs->fs_fatcache, CONFIG_FAT_FATCACHE_NSECTORS,
+                        &victim[nsectors],
+                        CONFIG_FAT_FATCACHE_NSECTORS / 2) &&
+         sector + nsectors < fatend &&
+         fat_cachefind(fs->fs_fatcache, CONFIG_FAT_FATCACHE_NSECTORS,
+                       sector + nsectors) == NULL)
+    {
+      nsectors++;
+    }
+
+  return nsectors;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -513,6 +694,14 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
       goto errout;
     }
 
+  /* Allocate the FAT table and directory sector caches */
+
+  ret = fat_cachealloc(fs);
+  if (ret < 0)
+    {
+      goto errout_with_buffer;
+    }
+
   /* Search FAT boot record on the drive.  First check the MBR at sector
    * zero.  This could be either the boot record or a partition that refers
    * to the boot record.
@@ -606,6 +795,12 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
         }
     }
 
+  /* fs_buffer holds the last sector examined while searching for the
+   * boot record.  Don't let the sector caches mistake it for sector zero.
+   */
+
+  fs->fs_currentsector = -1;
+
   /* We have what appears to be a valid FAT filesystem! Now read the
    * FSINFO sector (FAT32 only)
    */
@@ -651,6 +846,7 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
   return OK;
 
 errout_with_buffer:
+  fat_cachefree(fs);
   fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
   fs->fs_buffer = NULL;
 
@@ -752,6 +948,22 @@ int fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
   if (fs && fs->fs_blkdriver)
     {
       struct inode *inode = fs->fs_blkdriver;
+
+#if CONFIG_FAT_DIRCACHE_NSECTORS > 0
+      int i;
+
+      /* Drop the copies of the written sectors from the directory cache */
+
+      for (i = 0; i < CONFIG_FAT_DIRCACHE_NSECTORS; i++)
+        {
+          if (fs->fs_dircache[i].sector >= sector &&
+              fs->fs_dircache[i].sector < sector + nsectors)
+            {
+              fs->fs_dircache[i].sector = -1;
+            }
+        }
+#endif
+
       if (inode && inode->u.i_bops && inode->u.i_bops->write)
         {
           ssize_t nsectorswritten =
@@ -815,6 +1027,7 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
         {
           case FSTYPE_FAT12 :
             {
+              FAR uint8_t  *buffer;
               off_t        fatsector;
               unsigned int fatoffset;
               unsigned int cluster;
@@ -829,7 +1042,7 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
 
               /* Read the sector at this offset */
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              if (fat_fatcacheread(fs, fatsector, false, &buffer) < 0)
                 {
                   /* Read error */
 
@@ -839,7 +1052,7 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
               /* Get the first, LS byte of the cluster from the FAT */
 
               fatindex = fatoffset & SEC_NDXMASK(fs);
-              cluster  = fs->fs_buffer[fatindex];
+              cluster  = buffer[fatindex];
 
               /* With FAT12, the second byte of the cluster number may lie in
                * a different sector than the first byte.
@@ -851,7 +1064,7 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
                   fatsector++;
                   fatindex = 0;
 
-                  if (fat_fscacheread(fs, fatsector) < 0)
+                  if (fat_fatcacheread(fs, fatsector, false, &buffer) < 0)
                     {
                       /* Read error */
 
@@ -864,7 +1077,7 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
                * on the fact that the byte stream is little-endian.
                */
 
-              cluster |= (unsigned int)fs->fs_buffer[fatindex] << 8;
+              cluster |= (unsigned int)buffer[fatindex] << 8;
 
               /* Now, pick out the correct 12 bit cluster start sector
                * value.
@@ -892,15 +1105,16 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
               off_t        fatsector = fs->fs_fatbase +
                                        SEC_NSECTORS(fs, fatoffset);
               unsigned int fatindex  = fatoffset & SEC_NDXMASK(fs);
+              FAR uint8_t  *buffer;
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              if (fat_fatcacheread(fs, fatsector, false, &buffer) < 0)
                 {
                   /* Read error */
 
                   break;
                 }
 
-              return FAT_GETFAT16(fs->fs_buffer, fatindex);
+              return FAT_GETFAT16(buffer, fatindex);
             }
 
           case FSTYPE_FAT32 :
@@ -909,15 +1123,16 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
               off_t        fatsector = fs->fs_fatbase +
                                        SEC_NSECTORS(fs, fatoffset);
               unsigned int fatindex  = fatoffset & SEC_NDXMASK(fs);
+              FAR uint8_t  *buffer;
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              if (fat_fatcacheread(fs, fatsector, false, &buffer) < 0)
                 {
                   /* Read error */
 
                   break;
                 }
 
-              return FAT_GETFAT32(fs->fs_buffer, fatindex) & 0x0fffffff;
+              return FAT_GETFAT32(buffer, fatindex) & 0x0fffffff;
             }
 
           default:
@@ -955,6 +1170,7 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
         {
           case FSTYPE_FAT12 :
             {
+              FAR uint8_t  *buffer;
               off_t        fatsector;
               unsigned int fatoffset;
               unsigned int fatindex;
@@ -967,9 +1183,11 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
               fatoffset = (clusterno * 3) / 2;
               fatsector = fs->fs_fatbase + SEC_NSECTORS(fs, fatoffset);
 
-              /* Make sure that the sector at this offset is in the cache */
+              /* Make sure that the sector at this offset is in the cache
+               * and mark it as "dirty" since we are going to modify it.
+               */
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              if (fat_fatcacheread(fs, fatsector, true, &buffer) < 0)
                 {
                   /* Read error */
 
@@ -985,7 +1203,7 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                 {
                   /* Save the LS four bits of the next cluster */
 
-                  value = (fs->fs_buffer[fatindex] & 0x0f) |
+                  value = (buffer[fatindex] & 0x0f) |
                            nextcluster << 4;
                 }
               else
@@ -995,7 +1213,7 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                   value = (uint8_t)nextcluster;
                 }
 
-              fs->fs_buffer[fatindex] = value;
+              buffer[fatindex] = value;
 
               /* With FAT12, the second byte of the cluster number may lie in
                * a different sector than the first byte.
@@ -1009,12 +1227,7 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                   fatsector++;
                   fatindex = 0;
 
-                  /* Set the dirty flag to make sure the sector that we
-                   * just modified is written out.
-                   */
-
-                  fs->fs_dirty = true;
-                  if (fat_fscacheread(fs, fatsector) < 0)
+                  if (fat_fatcacheread(fs, fatsector, true, &buffer) < 0)
                     {
                       /* Read error */
 
@@ -1036,11 +1249,11 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                 {
                   /* Save the MS four bits of the next cluster */
 
-                  value = (fs->fs_buffer[fatindex] & 0xf0) |
+                  value = (buffer[fatindex] & 0xf0) |
                           ((nextcluster >> 8) & 0x0f);
                 }
 
-              fs->fs_buffer[fatindex] = value;
+              buffer[fatindex] = value;
             }
           break;
 
@@ -1050,15 +1263,16 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
               off_t        fatsector = fs->fs_fatbase +
                                        SEC_NSECTORS(fs, fatoffset);
               unsigned int fatindex  = fatoffset & SEC_NDXMASK(fs);
+              FAR uint8_t  *buffer;
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              if (fat_fatcacheread(fs, fatsector, true, &buffer) < 0)
                 {
                   /* Read error */
 
                   break;
                 }
 
-              FAT_PUTFAT16(fs->fs_buffer, fatindex, nextcluster & 0xffff);
+              FAT_PUTFAT16(buffer, fatindex, nextcluster & 0xffff);
             }
           break;
 
@@ -1068,9 +1282,10 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
               off_t        fatsector = fs->fs_fatbase +
                                        SEC_NSECTORS(fs, fatoffset);
               unsigned int fatindex  = fatoffset & SEC_NDXMASK(fs);
+              FAR uint8_t  *buffer;
               uint32_t     val;
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              if (fat_fatcacheread(fs, fatsector, true, &buffer) < 0)
                 {
                   /* Read error */
 
@@ -1079,8 +1294,8 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
 
               /* Keep the top 4 bits */
 
-              val = FAT_GETFAT32(fs->fs_buffer, fatindex) & 0xf0000000;
-              FAT_PUTFAT32(fs->fs_buffer, fatindex,
+              val = FAT_GETFAT32(buffer, fatindex) & 0xf0000000;
+              FAT_PUTFAT32(buffer, fatindex,
                            val | (nextcluster & 0x0fffffff));
             }
           break;
@@ -1089,9 +1304,8 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
             return -EINVAL;
         }
 
-      /* Mark the modified sector as "dirty" and return success */
+      /* The modified sectors were marked "dirty" when they were read */
 
-      fs->fs_dirty = true;
       return OK;
     }
 
@@ -1312,6 +1526,54 @@ int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
   return newcluster;
 }
 
+/****************************************************************************
+ * Name: fat_contiguous
+ *
+ * Description:
+ *   Return the number of sectors, at most 'nsectors', that follow the
+ *   current sector of an open file without a gap on the media.  The run
+ *   continues into the following clusters as long as they are allocated
+ *   contiguously, so that large transfers need fewer requests.
+ *
+ * Input Parameters:
+ *   fs       - The mountpoint
+ *   ff       - The open file
+ *   nsectors - The number of sectors wanted
+ *   cluster  - Returns the cluster that holds the last sector of the run
+ *
+ * Returned Value:
+ *   The number of contiguous sectors or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int fat_contiguous(FAR struct fat_mountpt_s *fs, FAR struct fat_file_s *ff,
+                   unsigned int nsectors, FAR uint32_t *cluster)
+{
+  unsigned int run = ff->ff_sectorsincluster;
+  uint32_t last = ff->ff_currentcluster;
+  off_t next;
+
+  while (run < nsectors)
+    {
+      next = fat_getcluster(fs, last);
+      if (next < 0)
+        {
+          return next;
+        }
+
+      if (next != last + 1 || next >= fs->fs_nclusters)
+        {
+          break;
+        }
+
+      last = next;
+      run += fs->fs_fatsecperclus;
+    }
+
+  *cluster = last;
+  return run < nsectors ? run : nsectors;
+}
+
 /****************************************************************************
  * Name: fat_nextdirentry
  *
@@ -1767,32 +2029,12 @@ int fat_fscacheflush(struct fat_mountpt_s *fs)
     {
       /* Write the dirty sector */
 
-      ret = fat_hwwrite(fs, fs->fs_buffer, fs->fs_currentsector, 1);
+      ret = fat_writesector(fs, fs->fs_buffer, fs->fs_currentsector);
       if (ret < 0)
         {
           return ret;
         }
 
-      /* Does the sector lie in the FAT region? */
-
-      if (fs->fs_currentsector >= fs->fs_fatbase &&
-          fs->fs_currentsector < fs->fs_fatbase + fs->fs_nfatsects)
-        {
-          int i;
-
-          /* Yes, then make the change in the FAT copy as well */
-
-          for (i = fs->fs_fatnumfats; i >= 2; i--)
-            {
-              fs->fs_currentsector += fs->fs_nfatsects;
-              ret = fat_hwwrite(fs, fs->fs_buffer, fs->fs_currentsector, 1);
-              if (ret < 0)
-                {
-                  return ret;
-                }
-            }
-        }
-
       /* No longer dirty */
 
       fs->fs_dirty = false;
@@ -1812,6 +2054,11 @@ int fat_fscacheflush(struct fat_mountpt_s *fs)
 
 int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
 {
+#if CONFIG_FAT_DIRCACHE_NSECTORS > 0
+  FAR struct fat_cache_s *entry;
+  FAR uint8_t *buffer;
+  bool hit;
+#endif
   int ret;
 
   /* fs->fs_currentsector holds the current sector that is buffered in
@@ -1831,6 +2078,40 @@ int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
           return ret;
         }
 
+#if CONFIG_FAT_DIRCACHE_NSECTORS > 0
+      /* The old sector is clean now.  If the new sector is held in the
+       * directory cache, trade buffers with its entry so that the old
+       * sector takes its place.  Otherwise, the old sector replaces the
+       * least recently used entry.
+       */
+
+      entry = fat_cachefind(fs->fs_dircache, CONFIG_FAT_DIRCACHE_NSECTORS,
+                            sector);
+      hit   = entry != NULL;
+
+      if (!hit && fs->fs_currentsector >= 0)
+        {
+          entry = fat_cachevictim(fs, fs->fs_dircache,
+                                  CONFIG_FAT_DIRCACHE_NSECTORS);
+        }
+
+      if (entry != NULL)
+        {
+          buffer               = entry->buffer;
+          entry->buffer        = fs->fs_buffer;
+          entry->sector        = fs->fs_currentsector;
+          entry->stamp         = ++fs->fs_cachestamp;
+          fs->fs_buffer        = buffer;
+          fs->fs_currentsector = -1;
+
+          if (hit)
+            {
+              fs->fs_currentsector = sector;
+              return OK;
+            }
+        }
+#endif
+
       /* Then read the specified sector into the cache */
 
       ret = fat_hwread(fs, fs->fs_buffer, sector, 1);
@@ -1964,6 +2245,226 @@ int fat_ffcacheinvalidate(struct fat_mountpt_s *fs, struct fat_file_s *ff)
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_cachealloc
+ *
+ * Description:
+ *   Allocate the buffers of the FAT table and directory sector caches
+ *
+ ****************************************************************************/
+
+int fat_cachealloc(struct fat_mountpt_s *fs)
+{
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0 || CONFIG_FAT_DIRCACHE_NSECTORS > 0
+  int i;
+#endif
+
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+  /* The FAT table cache uses one contiguous buffer so that several FAT
+   * sectors can be read ahead with a single request.
+   */
+
+  fs->fs_fatbuffer = (FAR uint8_t *)
+    fat_io_alloc(CONFIG_FAT_FATCACHE_NSECTORS * fs->fs_hwsectorsize);
+  if (fs->fs_fatbuffer == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (i = 0; i < CONFIG_FAT_FATCACHE_NSECTORS; i++)
+    {
+      fs->fs_fatcache[i].sector = -1;
+      fs->fs_fatcache[i].dirty  = false;
+      fs->fs_fatcache[i].buffer = fs->fs_fatbuffer +
+                                  i * fs->fs_hwsectorsize;
+    }
+
+  fs->fs_fatlastmiss = -1;
+#endif
+
+#if CONFIG_FAT_DIRCACHE_NSECTORS > 0
+  /* The buffers of the directory cache are traded with fs_buffer, so each
+   * one is allocated just like fs_buffer.
+   */
+
+  for (i = 0; i < CONFIG_FAT_DIRCACHE_NSECTORS; i++)
+    {
+      fs->fs_dircache[i].sector = -1;
+      fs->fs_dircache[i].dirty  = false;
+      fs->fs_dircache[i].buffer = (FAR uint8_t *)
+        fat_io_alloc(fs->fs_hwsectorsize);
+      if (fs->fs_dircache[i].buffer == NULL)
+        {
+          return -ENOMEM;
+        }
+    }
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_cachefree
+ *
+ * Description:
+ *   Free the buffers of the FAT table and directory sector caches
+ *
+ ****************************************************************************/
+
+void fat_cachefree(struct fat_mountpt_s *fs)
+{
+#if CONFIG_FAT_DIRCACHE_NSECTORS > 0
+  int i;
+#endif
+
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+  if (fs->fs_fatbuffer != NULL)
+    {
+      fat_io_free(fs->fs_fatbuffer,
+                  CONFIG_FAT_FATCACHE_NSECTORS * fs->fs_hwsectorsize);
+      fs->fs_fatbuffer = NULL;
+    }
+#endif
+
+#if CONFIG_FAT_DIRCACHE_NSECTORS > 0
+  for (i = 0; i < CONFIG_FAT_DIRCACHE_NSECTORS; i++)
+    {
+      if (fs->fs_dircache[i].buffer != NULL)
+        {
+          fat_io_free(fs->fs_dircache[i].buffer, fs->fs_hwsectorsize);
+          fs->fs_dircache[i].buffer = NULL;
+        }
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: fat_fatcacheflush
+ *
+ * Description:
+ *   Write back all dirty sectors of the FAT table cache
+ *
+ ****************************************************************************/
+
+int fat_fatcacheflush(struct fat_mountpt_s *fs)
+{
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+  FAR struct fat_cache_s *entry;
+  int ret;
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_FATCACHE_NSECTORS; i++)
+    {
+      entry = &fs->fs_fatcache[i];
+      if (entry->dirty)
+        {
+          ret = fat_writesector(fs, entry->buffer, entry->sector);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          entry->dirty = false;
+        }
+    }
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_fatcacheread
+ *
+ * Description:
+ *   Make a sector of the FAT available for access.  Without a FAT table
+ *   cache, the sector is read into fs_buffer.
+ *
+ * Input Parameters:
+ *   fs     - The mountpoint
+ *   sector - The FAT sector to access
+ *   dirty  - true: The caller is going to modify the sector
+ *   buffer - Returns the buffer that holds the sector
+ *
+ * Returned Value:
+ *   Zero on success or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int fat_fatcacheread(struct fat_mountpt_s *fs, off_t sector, bool dirty,
+                     FAR uint8_t **buffer)
+{
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+  FAR struct fat_cache_s *entry;
+  unsigned int nsectors;
+  unsigned int i;
+  int ret;
+
+  entry = fat_cachefind(fs->fs_fatcache, CONFIG_FAT_FATCACHE_NSECTORS,
+                        sector);
+  if (entry == NULL)
+    {
+      entry    = fat_cachevictim(fs, fs->fs_fatcache,
+                                 CONFIG_FAT_FATCACHE_NSECTORS);
+      nsectors = fat_fatreadahead(fs, entry, sector);
+
+      /* Only the victim itself may be dirty, read-ahead skips dirty
+       * entries.
+       */
+
+      if (entry->dirty)
+        {
+          ret = fat_writesector(fs, entry->buffer, entry->sector);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          entry->dirty = false;
+        }
+
+      for (i = 0; i < nsectors; i++)
+        {
+          entry[i].sector = -1;
+        }
+
+      ret = fat_hwread(fs, entry->buffer, sector, nsectors);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      for (i = 0; i < nsectors; i++)
+        {
+          entry[i].sector = sector + i;
+          entry[i].stamp  = fs->fs_cachestamp;
+        }
+
+      fs->fs_fatlastmiss = sector + nsectors - 1;
+    }
+
+  entry->stamp = ++fs->fs_cachestamp;
+  entry->dirty = entry->dirty || dirty;
+  *buffer      = entry->buffer;
+  return OK;
+#else
+  int ret;
+
+  ret = fat_fscacheread(fs, sector);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (dirty)
+    {
+      fs->fs_dirty = true;
+    }
+
+  *buffer = fs->fs_buffer;
+  return OK;
+#endif
+}
+
 /****************************************************************************
  * Name: fat_updatefsinfo
  *
@@ -1977,9 +2478,14 @@ int fat_updatefsinfo(struct fat_mountpt_s *fs)
 {
   int ret;
 
-  /* Flush the fs_buffer if it is dirty */
+  /* Flush the FAT table cache and the fs_buffer if they are dirty */
+
+  ret = fat_fatcacheflush(fs);
+  if (ret == OK)
+    {
+      ret = fat_fscacheflush(fs);
+    }
 
-  ret = fat_fscacheflush(fs);
   if (ret == OK)
     {
       /* The FSINFO sector only has to be update for the case of a FAT32 file
@@ -2047,6 +2553,7 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
     }
   else
     {
+      FAR uint8_t  *buffer = NULL;
       unsigned int cluster;
       off_t        fatsector;
       unsigned int offset;
@@ -2060,12 +2567,12 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
       for (cluster = fs->fs_nclusters; cluster > 0; cluster--)
         {
           /* If we are starting a new sector, then read the new sector in
-           * fs_buffer
+           * the FAT table cache.
            */
 
           if (offset >= fs->fs_hwsectorsize)
             {
-              ret = fat_fscacheread(fs, fatsector);
+              ret = fat_fatcacheread(fs, fatsector, false, &buffer);
               if (ret < 0)
                 {
                   return ret;
@@ -2085,7 +2592,7 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
 
           if (fs->fs_type == FSTYPE_FAT16)
             {
-              if (FAT_GETFAT16(fs->fs_buffer, offset) == 0)
+              if (FAT_GETFAT16(buffer, offset) == 0)
                 {
                   nfreeclusters++;
                 }
@@ -2094,7 +2601,7 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
             }
           else
             {
-              if (FAT_GETFAT32(fs->fs_buffer, offset) == 0)
+              if (FAT_GETFAT32(buffer, offset) == 0)
                 {
                   nfreeclusters++;
                 }
@@ -47,6 +47,40 @@
 
 #include "inode/inode.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* fs_getfilep() reads the descriptor table without holding fl_lock.  A new
+ * row array is therefore published before the row count that covers it,
+ * and the row count is read before the row array.  Likewise, f_inode is
+ * the last field of a new descriptor to be set and the first to be read.
+ */
+
+#ifdef CONFIG_SMP
+#  define files_getrows(l) \
+     __atomic_load_n(&(l)->fl_rows, __ATOMIC_ACQUIRE)
+#  define files_setrows(l,r) \
+     __atomic_store_n(&(l)->fl_rows, (r), __ATOMIC_RELEASE)
+#  define files_getarray(l) \
+     __atomic_load_n(&(l)->fl_files, __ATOMIC_ACQUIRE)
+#  define files_setarray(l,a) \
+     __atomic_store_n(&(l)->fl_files, (a), __ATOMIC_RELEASE)
+#  define files_getinode(f) \
+     __atomic_load_n(&(f)->f_inode, __ATOMIC_ACQUIRE)
+#  define files_setinode(f,i) \
+     __atomic_store_n(&(f)->f_inode, (i), __ATOMIC_RELEASE)
+#else
+#  define files_getrows(l)    (*(FAR volatile uint8_t *)&(l)->fl_rows)
+#  define files_setrows(l,r)  (files_getrows(l) = (r))
+#  define files_getinode(f) \
+     (*(FAR struct inode * FAR volatile *)&(f)->f_inode)
+#  define files_setinode(f,i) (files_getinode(f) = (i))
+#  define files_getarray(l) \
+     (*(FAR struct file ** FAR volatile *)&(l)->fl_files)
+#  define files_setarray(l,a) (files_getarray(l) = (a))
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -70,13 +104,23 @@ static int files_extend(FAR struct filelist *list, size_t row)
       return -EMFILE;
     }
 
-  tmp = kmm_realloc(list->fl_files, sizeof(FAR struct file *) * row);
+  /* The row array cannot be reallocated in place because fs_getfilep() may
+   * be reading it without holding fl_lock.  The new array has a leading
+   * slot that links it to the array that it replaces.  The replaced arrays
+   * are freed by files_releaselist().
+   */
+
+  tmp = kmm_malloc(sizeof(FAR struct file *) * (row + 1));
   DEBUGASSERT(tmp);
   if (tmp == NULL)
     {
       return -ENFILE;
     }
 
+  tmp[0] = list->fl_files != NULL ?
+           (FAR struct file *)(list->fl_files - 1) : NULL;
+  tmp++;
+
   i = list->fl_rows;
   do
     {
@@ -89,14 +133,20 @@ static int files_extend(FAR struct filelist *list, size_t row)
               kmm_free(tmp[i]);
             }
 
-          kmm_free(tmp);
+          kmm_free(tmp - 1);
           return -ENFILE;
         }
     }
   while (++i < row);
 
-  list->fl_files = tmp;
-  list->fl_rows = row;
+  if (list->fl_rows > 0)
+    {
+      memcpy(tmp, list->fl_files,
+             sizeof(FAR struct file *) * list->fl_rows);
+    }
+
+  files_setarray(list, tmp);
+  files_setrows(list, row);
 
   /* Note: If assertion occurs, the fl_rows has a overflow.
    * And there may be file descriptors leak in system.
@@ -185,7 +235,21 @@ void files_releaselist(FAR struct filelist *list)
       kmm_free(list->fl_files[i]);
     }
 
-  kmm_free(list->fl_files);
+  /* Free the row array and all of the arrays that it replaced */
+
+  if (list->fl_files != NULL)
+    {
+      FAR struct file **files = list->fl_files - 1;
+
+      do
+        {
+          FAR struct file **prev = (FAR struct file **)files[0];
+
+          kmm_free(files);
+          files = prev;
+        }
+      while (files != NULL);
+    }
 
   /* Destroy the mutex */
 
@@ -253,8 +317,8 @@ int file_allocate_from_tcb(FAR struct tcb_s *tcb, FAR struct inode *inode,
             {
               list->fl_files[i][j].f_oflags = oflags;
               list->fl_files[i][j].f_pos    = pos;
-              list->fl_files[i][j].f_inode  = inode;
               list->fl_files[i][j].f_priv   = priv;
+              files_setinode(&list->fl_files[i][j], inode);
               nxmutex_unlock(&list->fl_lock);
 
               if (addref)
@@ -287,8 +351,8 @@ int file_allocate_from_tcb(FAR struct tcb_s *tcb, FAR struct inode *inode,
 
   list->fl_files[i][0].f_oflags = oflags;
   list->fl_files[i][0].f_pos    = pos;
-  list->fl_files[i][0].f_inode  = inode;
   list->fl_files[i][0].f_priv   = priv;
+  files_setinode(&list->fl_files[i][0], inode);
   nxmutex_unlock(&list->fl_lock);
 
   if (addref)
@@ -417,7 +481,7 @@ out:
 int fs_getfilep(int fd, FAR struct file **filep)
 {
   FAR struct filelist *list;
-  int ret;
+  FAR struct file **files;
 
 #ifdef CONFIG_FDCHECK
   fd = fdcheck_restore(fd);
@@ -439,36 +503,32 @@ int fs_getfilep(int fd, FAR struct file **filep)
       return -EAGAIN;
     }
 
-  if (fd < 0 || fd >= list->fl_rows * CONFIG_NFILE_DESCRIPTORS_PER_BLOCK)
+  /* The descriptor table is read without taking fl_lock.  Rows and row
+   * arrays are never freed before the list itself, and the row array read
+   * after the row count always covers that count.
+   */
+
+  if (fd < 0 ||
+      fd >= files_getrows(list) * CONFIG_NFILE_DESCRIPTORS_PER_BLOCK)
     {
       return -EBADF;
     }
 
-  /* The descriptor is in a valid range to file descriptor... Get the
-   * thread-specific file list.
-   */
-
   /* And return the file pointer from the list */
 
-  ret = nxmutex_lock(&list->fl_lock);
-  if (ret < 0)
-    {
-      return ret;
-    }
-
-  *filep = &list->fl_files[fd / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK]
-                          [fd % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK];
+  files  = files_getarray(list);
+  *filep = &files[fd / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK]
+                 [fd % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK];
 
   /* if f_inode is NULL, fd was closed */
 
-  if (!(*filep)->f_inode)
+  if (files_getinode(*filep) == NULL)
     {
       *filep = NULL;
-      ret = -EBADF;
+      return -EBADF;
     }
 
-  nxmutex_unlock(&list->fl_lock);
-  return ret;
+  return OK;
 }
 
 /****************************************************************************
@@ -495,6 +555,7 @@ int nx_dup2_from_tcb(FAR struct tcb_s *tcb, int fd1, int fd2)
   FAR struct filelist *list;
   FAR struct file *filep;
   FAR struct file  file;
+  FAR struct file  temp;
   int ret;
 
   if (fd1 == fd2)
@@ -537,18 +598,28 @@ int nx_dup2_from_tcb(FAR struct tcb_s *tcb, int fd1, int fd2)
 
   filep = &list->fl_files[fd2 / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK]
                          [fd2 % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK];
-  memcpy(&file, filep, sizeof(struct file));
-  memset(filep, 0,     sizeof(struct file));
 
-  /* Perform the dup2 operation */
+  /* Perform the dup2 operation into a temporary descriptor.  fs_getfilep()
+   * does not take fl_lock, so fd2 keeps referring to the old file while
+   * file_dup2() runs (it may block) and is replaced only once the new
+   * descriptor is complete.  fd2 is left unchanged if file_dup2() fails.
+   */
 
+  memset(&temp, 0, sizeof(struct file));
   ret = file_dup2(&list->fl_files[fd1 / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK]
                                  [fd1 % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK],
-                  filep);
+                  &temp);
+  if (ret < 0)
+    {
+      nxmutex_unlock(&list->fl_lock);
+      return ret;
+    }
 
-#ifdef CONFIG_FDSAN
-  filep->f_tag = file.f_tag;
-#endif
+  memcpy(&file, filep, sizeof(struct file));
+  filep->f_oflags = temp.f_oflags;
+  filep->f_pos    = temp.f_pos;
+  filep->f_priv   = temp.f_priv;
+  files_setinode(filep, temp.f_inode);
 
   nxmutex_unlock(&list->fl_lock);
 
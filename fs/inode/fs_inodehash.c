@@ -0,0 +1,344 @@
+/****************************************************************************
+ * fs/inode/fs_inodehash.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "inode/inode.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_HASH
+#  if (CONFIG_FS_INODE_HASH_SIZE & (CONFIG_FS_INODE_HASH_SIZE - 1)) != 0
+#    error CONFIG_FS_INODE_HASH_SIZE must be a power of 2
+#  endif
+#  define INODE_HASH_MASK (CONFIG_FS_INODE_HASH_SIZE - 1)
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#if CONFIG_FS_INODE_DCACHE_SIZE > 0
+/* One remembered result of inode_search().  Only the part of the search
+ * descriptor that does not depend on the caller is kept.
+ */
+
+struct inode_dentry_s
+{
+  FAR struct inode *node;   /* Inode found, NULL if the entry is unused */
+  FAR struct inode *peer;   /* The inode to the "left" of node */
+  FAR struct inode *parent; /* The inode "above" node */
+  uint16_t relpath;         /* Offset of the relative path in path[] */
+  char path[CONFIG_FS_INODE_DCACHE_PATHLEN]; /* Absolute path searched */
+};
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_HASH
+/* All inodes of the pseudo file system except for the root, hashed by
+ * their parent inode and their name.
+ */
+
+static FAR struct inode *g_inode_hash[CONFIG_FS_INODE_HASH_SIZE];
+#endif
+
+#if CONFIG_FS_INODE_DCACHE_SIZE > 0
+static struct inode_dentry_s g_inode_dcache[CONFIG_FS_INODE_DCACHE_SIZE];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_HASH
+/****************************************************************************
+ * Name: inode_hashkey
+ *
+ * Description:
+ *   Return the hash bucket of the path segment 'name' (terminated by '\0'
+ *   or '/') below the inode 'parent'.
+ *
+ ****************************************************************************/
+
+static unsigned int inode_hashkey(FAR struct inode *parent,
+                                  FAR const char *name)
+{
+  uint32_t hash = (uint32_t)((uintptr_t)parent >> 2);
+
+  while (*name != '\0' && *name != '/')
+    {
+      hash = hash * 31 + (uint8_t)*name++;
+    }
+
+  return (hash ^ (hash >> 16)) & INODE_HASH_MASK;
+}
+
+/****************************************************************************
+ * Name: inode_namematch
+ *
+ * Description:
+ *   Return true if the path segment 'name' is the name of 'node'.
+ *
+ ****************************************************************************/
+
+static bool inode_namematch(FAR const char *name, FAR struct inode *node)
+{
+  FAR const char *nname = node->i_name;
+
+  while (*nname != '\0' && *nname == *name)
+    {
+      nname++;
+      name++;
+    }
+
+  return *nname == '\0' && (*name == '\0' || *name == '/');
+}
+#endif /* CONFIG_FS_INODE_HASH */
+
+#if CONFIG_FS_INODE_DCACHE_SIZE > 0
+/****************************************************************************
+ * Name: inode_dentry
+ *
+ * Description:
+ *   Return the path cache entry that 'path' maps to and the length of
+ *   'path'.
+ *
+ ****************************************************************************/
+
+static FAR struct inode_dentry_s *inode_dentry(FAR const char *path,
+                                               FAR size_t *len)
+{
+  FAR const char *ptr = path;
+  uint32_t hash = 0;
+
+  while (*ptr != '\0')
+    {
+      hash = hash * 31 + (uint8_t)*ptr++;
+    }
+
+  *len = ptr - path;
+  return &g_inode_dcache[(hash ^ (hash >> 16)) %
+                         CONFIG_FS_INODE_DCACHE_SIZE];
+}
+#endif /* CONFIG_FS_INODE_DCACHE_SIZE > 0 */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_HASH
+/****************************************************************************
+ * Name: inode_hashadd
+ *
+ * Description:
+ *   Add an inode that has just been linked below its parent to the hash
+ *   index.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore
+ *
+ ****************************************************************************/
+
+void inode_hashadd(FAR struct inode *node)
+{
+  FAR struct inode **head;
+
+  DEBUGASSERT(node != NULL && node->i_parent != NULL);
+
+  head          = &g_inode_hash[inode_hashkey(node->i_parent,
+                                              node->i_name)];
+  node->i_hnext = *head;
+  *head         = node;
+}
+
+/****************************************************************************
+ * Name: inode_hashremove
+ *
+ * Description:
+ *   Remove an inode from the hash index.  This must be done before the
+ *   inode is unlinked from its parent.  Nothing happens if the inode is
+ *   not in the index.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore
+ *
+ ****************************************************************************/
+
+void inode_hashremove(FAR struct inode *node)
+{
+  FAR struct inode **curr;
+
+  if (node->i_parent == NULL)
+    {
+      return;
+    }
+
+  curr = &g_inode_hash[inode_hashkey(node->i_parent, node->i_name)];
+  for (; *curr != NULL; curr = &(*curr)->i_hnext)
+    {
+      if (*curr == node)
+        {
+          *curr         = node->i_hnext;
+          node->i_hnext = NULL;
+          break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: inode_hashfind
+ *
+ * Description:
+ *   Find the child of 'parent' named by the path segment 'name'.
+ *
+ * Returned Value:
+ *   The inode found or NULL if there is no such child.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore
+ *
+ ****************************************************************************/
+
+FAR struct inode *inode_hashfind(FAR struct inode *parent,
+                                 FAR const char *name)
+{
+  FAR struct inode *node;
+
+  node = g_inode_hash[inode_hashkey(parent, name)];
+  for (; node != NULL; node = node->i_hnext)
+    {
+      if (node->i_parent == parent && inode_namematch(name, node))
+        {
+          break;
+        }
+    }
+
+  return node;
+}
+#endif /* CONFIG_FS_INODE_HASH */
+
+#if CONFIG_FS_INODE_DCACHE_SIZE > 0
+/****************************************************************************
+ * Name: inode_dcachefind
+ *
+ * Description:
+ *   Look up the absolute path desc->path in the path cache.  On a hit the
+ *   search descriptor is completed as _inode_search() would have done it.
+ *
+ * Returned Value:
+ *   OK on a hit, -ENOENT on a miss.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore
+ *
+ ****************************************************************************/
+
+int inode_dcachefind(FAR struct inode_search_s *desc)
+{
+  FAR struct inode_dentry_s *dentry;
+  size_t len;
+
+  dentry = inode_dentry(desc->path, &len);
+  if (dentry->node == NULL || len >= CONFIG_FS_INODE_DCACHE_PATHLEN ||
+      memcmp(dentry->path, desc->path, len + 1) != 0)
+    {
+      return -ENOENT;
+    }
+
+  desc->node    = dentry->node;
+  desc->peer    = dentry->peer;
+  desc->parent  = dentry->parent;
+  desc->relpath = desc->path + dentry->relpath;
+  desc->path    = desc->relpath;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: inode_dcacheadd
+ *
+ * Description:
+ *   Remember the successful search of the absolute path 'path'.  Results
+ *   whose relative path does not lie within 'path' (as happens when a soft
+ *   link to a mountpoint was followed) are not cached.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore
+ *
+ ****************************************************************************/
+
+void inode_dcacheadd(FAR const struct inode_search_s *desc,
+                     FAR const char *path)
+{
+  FAR struct inode_dentry_s *dentry;
+  size_t len;
+
+  dentry = inode_dentry(path, &len);
+  if (len >= CONFIG_FS_INODE_DCACHE_PATHLEN ||
+      desc->relpath < path || desc->relpath > path + len)
+    {
+      return;
+    }
+
+  memcpy(dentry->path, path, len + 1);
+  dentry->node    = desc->node;
+  dentry->peer    = desc->peer;
+  dentry->parent  = desc->parent;
+  dentry->relpath = desc->relpath - path;
+}
+
+/****************************************************************************
+ * Name: inode_dcacheflush
+ *
+ * Description:
+ *   Forget all cached paths.  This must be called whenever the shape of
+ *   the inode tree changes.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore
+ *
+ ****************************************************************************/
+
+void inode_dcacheflush(void)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FS_INODE_DCACHE_SIZE; i++)
+    {
+      g_inode_dcache[i].node = NULL;
+    }
+}
+#endif /* CONFIG_FS_INODE_DCACHE_SIZE > 0 */
@@ -77,6 +77,23 @@ FAR struct inode *inode_unlink(FAR const char *path)
       node = desc.node;
       DEBUGASSERT(node != NULL);
 
+#ifdef CONFIG_FS_INODE_HASH
+      /* A lookup through the hash index does not report the left peer */
+
+      DEBUGASSERT(desc.parent != NULL);
+      desc.peer = NULL;
+      if (desc.parent->i_child != node)
+        {
+          desc.peer = desc.parent->i_child;
+          while (desc.peer->i_peer != node)
+            {
+              desc.peer = desc.peer->i_peer;
+            }
+        }
+
+      inode_hashremove(node);
+#endif
+
       /* If peer is non-null, then remove the node from the right of
        * of that peer node.
        */
@@ -96,6 +113,7 @@ FAR struct inode *inode_unlink(FAR const char *path)
 
       node->i_peer   = NULL;
       node->i_parent = NULL;
+      inode_dcacheflush();
     }
 
   RELEASE_SEARCH(&desc);
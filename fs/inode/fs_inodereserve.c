@@ -125,6 +125,9 @@ static void inode_insert(FAR struct inode *node,
       node->i_parent  = parent;
       parent->i_child = node;
     }
+
+  inode_hashadd(node);
+  inode_dcacheflush();
 }
 
 /****************************************************************************
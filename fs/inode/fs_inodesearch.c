@@ -244,7 +244,26 @@ static int _inode_search(FAR struct inode_search_s *desc)
 
   while (node != NULL)
     {
-      int result = _inode_compare(name, node);
+      int result;
+
+#ifdef CONFIG_FS_INODE_HASH
+      /* At the first child of a directory, look the name up in the hash
+       * index instead of walking the list of peers.  On a miss, fall back
+       * to the walk so that the insertion point is still reported in
+       * desc->peer.
+       */
+
+      if (above != NULL && left == NULL)
+        {
+          FAR struct inode *child = inode_hashfind(above, name);
+          if (child != NULL)
+            {
+              node = child;
+            }
+        }
+#endif
+
+      result = _inode_compare(name, node);
 
       /* Case 1:  The name is less than the name of the node.
        * Since the names are ordered, these means that there
@@ -492,7 +511,31 @@ int inode_search(FAR struct inode_search_s *desc)
       desc->path = desc->buffer;
     }
 
-  ret = _inode_search(desc);
+#if CONFIG_FS_INODE_DCACHE_SIZE > 0
+  /* Absolute paths owned by the caller are looked up in the path cache
+   * first.  Paths expanded into desc->buffer are not cached because the
+   * buffer may be released while following soft links.
+   */
+
+  if (desc->buffer == NULL)
+    {
+      FAR const char *path = desc->path;
+
+      ret = inode_dcachefind(desc);
+      if (ret < 0)
+        {
+          ret = _inode_search(desc);
+          if (ret >= 0 && desc->buffer == NULL)
+            {
+              inode_dcacheadd(desc, path);
+            }
+        }
+    }
+  else
+#endif
+    {
+      ret = _inode_search(desc);
+    }
 
 #ifdef CONFIG_PSEUDOFS_SOFTLINKS
   if (ret >= 0)
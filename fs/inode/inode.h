@@ -76,7 +76,9 @@
  *  node     - INPUT:  (not used)
  *             OUTPUT: On success, holds the pointer to the inode found.
  *  peer     - INPUT:  (not used)
- *             OUTPUT: The inode to the "left" of the inode found.
+ *             OUTPUT: The inode to the "left" of the inode found.  With
+ *                     CONFIG_FS_INODE_HASH this is only valid when the
+ *                     search fails and no inode was found.
  *  parent   - INPUT:  (not used)
  *             OUTPUT: The inode to the "above" of the inode found.
  *  relpath  - INPUT:  (not used)
@@ -291,6 +293,42 @@ int inode_getpath(FAR struct inode *node, FAR char *path, size_t len);
 
 void inode_free(FAR struct inode *node);
 
+/****************************************************************************
+ * Name: inode_hashadd, inode_hashremove and inode_hashfind
+ *
+ * Description:
+ *   Maintain and query the index of inodes by parent inode and name.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_HASH
+void inode_hashadd(FAR struct inode *node);
+void inode_hashremove(FAR struct inode *node);
+FAR struct inode *inode_hashfind(FAR struct inode *parent,
+                                 FAR const char *name);
+#else
+#  define inode_hashadd(node)
+#  define inode_hashremove(node)
+#endif
+
+/****************************************************************************
+ * Name: inode_dcachefind, inode_dcacheadd and inode_dcacheflush
+ *
+ * Description:
+ *   Look up, remember and forget the results of inode_search() for
+ *   absolute paths.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_INODE_DCACHE_SIZE > 0
+int inode_dcachefind(FAR struct inode_search_s *desc);
+void inode_dcacheadd(FAR const struct inode_search_s *desc,
+                     FAR const char *path);
+void inode_dcacheflush(void);
+#else
+#  define inode_dcacheflush()
+#endif
+
 /****************************************************************************
  * Name: inode_nextname
  *
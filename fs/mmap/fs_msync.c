@@ -0,0 +1,111 @@
+/****************************************************************************
+ * fs/mmap/fs_msync.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/mm/map.h>
+
+#include <sys/types.h>
+#include <sys/mman.h>
+
+#include <errno.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/sched.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: msync
+ *
+ * Description:
+ *   Write the changes made to a memory mapped file back to the file.
+ *
+ *   Only mappings that hold a copy of the file (see rammap()) have changes
+ *   to write back.  For all other mappings msync() has nothing to do.
+ *   MS_ASYNC is treated like MS_SYNC.  MS_INVALIDATE reloads the mapped
+ *   data from the file.
+ *
+ * Input Parameters:
+ *   addr    The start address of the range to synchronize
+ *   length  The length of the range.  The range must lie in one mapping.
+ *   flags   MS_ASYNC or MS_SYNC, optionally ORed with MS_INVALIDATE
+ *
+ * Returned Value:
+ *   On success, msync() returns 0, on failure -1, and errno is set:
+ *
+ *     EINVAL
+ *       'flags' is invalid
+ *     ENOMEM
+ *       The range is not mapped
+ *
+ ****************************************************************************/
+
+int msync(FAR void *addr, size_t length, int flags)
+{
+  FAR struct mm_map_entry_s *entry;
+  int ret;
+
+  /* msync() is a cancellation point */
+
+  enter_cancellation_point();
+
+  if ((flags & ~(MS_ASYNC | MS_SYNC | MS_INVALIDATE)) != 0 ||
+      (flags & (MS_ASYNC | MS_SYNC)) == (MS_ASYNC | MS_SYNC))
+    {
+      ret = -EINVAL;
+      goto errout;
+    }
+
+  ret = mm_map_lock();
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  entry = mm_map_find(get_current_mm(), addr, length);
+  if (entry == NULL)
+    {
+      ret = -ENOMEM;
+    }
+  else if (entry->msync != NULL)
+    {
+      ret = entry->msync(entry, addr, length, flags);
+    }
+
+  mm_map_unlock();
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  leave_cancellation_point();
+  return OK;
+
+errout:
+  leave_cancellation_point();
+  set_errno(-ret);
+  return ERROR;
+}
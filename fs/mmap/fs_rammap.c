@@ -24,29 +24,305 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include <assert.h>
 #include <debug.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
 #include <string.h>
 #include <unistd.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
+#include <nuttx/fs/procfs.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
 #include <nuttx/sched.h>
 
 #include "fs_rammap.h"
 
 #ifdef CONFIG_FS_RAMMAP
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Changes made through a shared, writable mapping are written back to the
+ * file.
+ */
+
+#define RAMMAP_WRITEBACK(entry) \
+  (((entry)->flags & MAP_SHARED) != 0 && ((entry)->prot & PROT_WRITE) != 0)
+
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_DISABLE_MOUNTPOINT) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_RAMMAP)
+#  define RAMMAP_PROCFS 1
+
+/* Output format:
+ *
+ *   REFS   OFFSET   LENGTH PATH
+ *   DDDD DDDDDDDD DDDDDDDD SSSS...
+ */
+
+#  define RAMMAP_HDR_FMT     "REFS   OFFSET   LENGTH PATH\n"
+#  define RAMMAP_REGION_FMT  "%4u %8lu %8lu %s\n"
+#  define RAMMAP_TOTAL_FMT   "Regions: %u Resident: %lu Shared: %lu\n"
+
+/* Size of the intermediate buffer, large enough for the longest line */
+
+#  define RAMMAP_LINELEN     (PATH_MAX + 32)
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A copy of part of a file in memory.  Mappings of the same range of the
+ * same file share one region, except for private, writable mappings which
+ * get a copy of their own.
+ */
+
+struct rammap_region_s
+{
+  FAR struct rammap_region_s *flink; /* Next region in g_rammap_regions */
+  struct file  file;                 /* Reference to the mapped file */
+  FAR char    *path;                 /* Path of a file on a mountpoint */
+  FAR uint8_t *vaddr;                /* The copy of the file data */
+  size_t       length;               /* Length of the region */
+  size_t       nvalid;               /* Bytes of the region in the file */
+  off_t        offset;               /* File offset of the region */
+  uint16_t     crefs;                /* Number of mappings of the region */
+  uint16_t     nwriters;             /* Number of them written back */
+  bool         kernel;               /* Allocated from the kernel heap */
+  bool         stale;                /* The file data changed, not shared */
+#ifdef CONFIG_BUILD_KERNEL
+  FAR struct task_group_s *group;    /* Owner of a user heap region */
+#endif
+};
+
+#ifdef RAMMAP_PROCFS
+/* This structure describes one open "file" */
+
+struct rammap_file_s
+{
+  struct procfs_file_s base;    /* Base open file structure */
+  char line[RAMMAP_LINELEN];    /* Pre-allocated buffer for formatted lines */
+  char path[PATH_MAX];          /* Path of the file of a region */
+};
+#endif
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+#ifdef RAMMAP_PROCFS
+/* File system methods */
+
+static int     rammap_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     rammap_close(FAR struct file *filep);
+static ssize_t rammap_procfs_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     rammap_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     rammap_stat(FAR const char *relpath, FAR struct stat *buf);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The regions that may be shared, protected by g_rammap_lock */
+
+static FAR struct rammap_region_s *g_rammap_regions;
+static mutex_t g_rammap_lock = NXMUTEX_INITIALIZER;
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
 
+#ifdef RAMMAP_PROCFS
+/* See fs_procfs.c -- this structure is explicitly extern'ed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_rammap_operations =
+{
+  rammap_open,         /* open */
+  rammap_close,        /* close */
+  rammap_procfs_read,  /* read */
+  NULL,                /* write */
+
+  rammap_dup,          /* dup */
+
+  NULL,                /* opendir */
+  NULL,                /* closedir */
+  NULL,                /* readdir */
+  NULL,                /* rewinddir */
+
+  rammap_stat          /* stat */
+};
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: rammap_read
+ *
+ * Description:
+ *   Read part of a file into memory without moving the file position.  Any
+ *   memory beyond the end of the file is zeroed.
+ *
+ * Returned Value:
+ *   The number of bytes read from the file or a negated errno value.
+ *
+ ****************************************************************************/
+
+static ssize_t rammap_read(FAR struct file *filep, FAR uint8_t *buffer,
+                           off_t offset, size_t length)
+{
+  size_t total = 0;
+  ssize_t nread;
+
+  while (total < length)
+    {
+      nread = file_pread(filep, buffer + total, length - total,
+                         offset + total);
+      if (nread < 0)
+        {
+          /* Handle the special case where the read was interrupted by a
+           * signal.
+           */
+
+          if (nread != -EINTR)
+            {
+              /* All other read errors are bad. */
+
+              ferr("ERROR: Read failed: offset=%zu ret=%zd\n",
+                   (size_t)offset, nread);
+              return nread;
+            }
+
+          continue;
+        }
+
+      /* Check for end of file. */
+
+      if (nread == 0)
+        {
+          break;
+        }
+
+      total += nread;
+    }
+
+  /* Zero any memory beyond the amount read from the file */
+
+  memset(buffer + total, 0, length - total);
+  return total;
+}
+
+/****************************************************************************
+ * Name: rammap_writeback
+ *
+ * Description:
+ *   Write part of a region back to the file.  Data beyond the end of the
+ *   file when it was mapped is not written.
+ *
+ ****************************************************************************/
+
+static int rammap_writeback(FAR struct rammap_region_s *region,
+                            size_t offset, size_t length)
+{
+  ssize_t nwritten;
+
+  if (offset >= region->nvalid)
+    {
+      return OK;
+    }
+
+  if (length > region->nvalid - offset)
+    {
+      length = region->nvalid - offset;
+    }
+
+  while (length > 0)
+    {
+      nwritten = file_pwrite(&region->file, region->vaddr + offset, length,
+                             region->offset + offset);
+      if (nwritten < 0)
+        {
+          if (nwritten == -EINTR)
+            {
+              continue;
+            }
+
+          ferr("ERROR: Write back failed: offset=%zu ret=%zd\n",
+               (size_t)region->offset + offset, nwritten);
+          return nwritten;
+        }
+
+      offset += nwritten;
+      length -= nwritten;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: rammap_release
+ *
+ * Description:
+ *   Drop one reference to a region, freeing it with the last one.  The
+ *   caller holds g_rammap_lock.
+ *
+ ****************************************************************************/
+
+static void rammap_release(FAR struct rammap_region_s *region)
+{
+  FAR struct rammap_region_s **prev;
+
+  DEBUGASSERT(region->crefs > 0);
+  if (--region->crefs > 0)
+    {
+      return;
+    }
+
+  for (prev = &g_rammap_regions; *prev != region; prev = &(*prev)->flink)
+    {
+      DEBUGASSERT(*prev != NULL);
+    }
+
+  *prev = region->flink;
+
+  file_close(&region->file);
+  if (region->kernel)
+    {
+      kmm_free(region->vaddr);
+    }
+  else
+    {
+      kumm_free(region->vaddr);
+    }
+
+  kmm_free(region->path);
+  kmm_free(region);
+}
+
+/****************************************************************************
+ * Name: unmap_rammap
+ *
+ * Description:
+ *   Unmap a private copy of a file.
+ *
+ ****************************************************************************/
+
 static int unmap_rammap(FAR struct task_group_s *group,
                         FAR struct mm_map_entry_s *entry,
                         FAR void *start,
@@ -121,125 +397,171 @@ static int unmap_rammap(FAR struct task_group_s *group,
 }
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: rammmap
+ * Name: unmap_shared
  *
  * Description:
- *   Support simulation of memory mapped files by copying files into RAM.
- *
- * Input Parameters:
- *   filep   file descriptor of the backing file -- required.
- *   entry   mmap entry information.
- *           field offset and length must be initialized correctly.
- *   kernel  kmm_zalloc or kumm_zalloc
- *
- * Returned Value:
- *  On success, rammap returns 0 and entry->vaddr points to memory mapped.
- *     Otherwise errno is returned appropriately.
- *
- *     EBADF
- *      'fd' is not a valid file descriptor.
- *     EINVAL
- *       'length' or 'offset' are invalid
- *     ENOMEM
- *       Insufficient memory is available to map the file.
+ *   Unmap a mapping of a shared region.
  *
  ****************************************************************************/
 
-int rammap(FAR struct file *filep, FAR struct mm_map_entry_s *entry,
-           bool kernel)
+static int unmap_shared(FAR struct task_group_s *group,
+                        FAR struct mm_map_entry_s *entry,
+                        FAR void *start,
+                        size_t length)
 {
-  FAR uint8_t *rdbuffer;
-  ssize_t nread;
-  off_t fpos;
+  FAR struct rammap_region_s *region = entry->priv.p;
+  off_t offset;
   int ret;
-  size_t length = entry->length;
-
-  /* There is a major design flaw that I have not yet thought of fix for:
-   * The goal is to have a single region of memory that represents a single
-   * file and can be shared by many threads.  That is, given a filename a
-   * thread should be able to open the file, get a file descriptor, and
-   * call mmap() to get a memory region.  Different file descriptors opened
-   * with the same file path should get the same memory region when mapped.
-   *
-   * The design flaw is that I don't have sufficient knowledge to know that
-   * these different file descriptors map to the same file.  So, for the time
-   * being, a new memory region is created each time that rammap() is called.
-   * Not very useful!
+
+  /* As for private copies, all unmappings must extend to the end of the
+   * mapping.
    */
 
-  /* Allocate a region of memory of the specified size */
+  offset = (uintptr_t)start - (uintptr_t)entry->vaddr;
+  if (offset + length < entry->length)
+    {
+      ferr("ERROR: Cannot umap without unmapping to the end\n");
+      return -ENOSYS;
+    }
 
-  rdbuffer = kernel ? kmm_malloc(length) : kumm_malloc(length);
-  if (!rdbuffer)
+  length = entry->length - offset;
+
+  ret = nxmutex_lock(&g_rammap_lock);
+  if (ret < 0)
     {
-      ferr("ERROR: Region allocation failed, length: %zu\n", length);
-      return -ENOMEM;
+      return ret;
     }
 
-  entry->vaddr = rdbuffer; /* save the buffer firstly */
+  /* Write back the changes made through a shared, writable mapping.  A
+   * write error does not prevent the unmapping.
+   */
 
-  /* Seek to the specified file offset */
+  if (RAMMAP_WRITEBACK(entry))
+    {
+      rammap_writeback(region, offset, length);
+    }
 
-  fpos = file_seek(filep, entry->offset, SEEK_SET);
-  if (fpos < 0)
+  if (length >= entry->length)
     {
-      /* Seek failed... errno has already been set, but EINVAL is probably
-       * the correct response.
+      if (RAMMAP_WRITEBACK(entry))
+        {
+          region->nwriters--;
+        }
+
+      ret = mm_map_remove(get_group_mm(group), entry);
+      rammap_release(region);
+    }
+  else
+    {
+      /* Other mappings may still use the rest of the region, it is only
+       * freed with the last mapping.
        */
 
-      ferr("ERROR: Seek to position %zu failed\n", (size_t)entry->offset);
-      ret = fpos;
-      goto errout_with_region;
+      entry->length = offset;
     }
 
-  /* Read the file data into the memory region */
+  nxmutex_unlock(&g_rammap_lock);
+  return ret;
+}
 
-  while (length > 0)
+/****************************************************************************
+ * Name: msync_shared
+ ****************************************************************************/
+
+static int msync_shared(FAR struct mm_map_entry_s *entry, FAR void *start,
+                        size_t length, int flags)
+{
+  FAR struct rammap_region_s *region = entry->priv.p;
+  size_t offset;
+  ssize_t nread;
+  int ret = OK;
+
+  offset = (uintptr_t)start - (uintptr_t)entry->vaddr;
+  if (length > entry->length - offset)
     {
-      nread = file_read(filep, rdbuffer, length);
-      if (nread < 0)
-        {
-          /* Handle the special case where the read was interrupted by a
-           * signal.
-           */
+      length = entry->length - offset;
+    }
 
-          if (nread != -EINTR)
-            {
-              /* All other read errors are bad. */
+  if (!RAMMAP_WRITEBACK(entry) && (flags & MS_INVALIDATE) == 0)
+    {
+      return OK;
+    }
 
-              ferr("ERROR: Read failed: offset=%zu ret=%zd\n",
-                   (size_t)entry->offset, nread);
+  ret = nxmutex_lock(&g_rammap_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
 
-              ret = nread;
-              goto errout_with_region;
-            }
-        }
+  /* MS_ASYNC is treated like MS_SYNC */
 
-      /* Check for end of file. */
+  if (RAMMAP_WRITEBACK(entry))
+    {
+      ret = rammap_writeback(region, offset, length);
+    }
 
-      if (nread == 0)
+  /* Reload the range from the file.  All mappings of the region see the
+   * new data.
+   */
+
+  if (ret >= 0 && (flags & MS_INVALIDATE) != 0)
+    {
+      nread = rammap_read(&region->file, region->vaddr + offset,
+                          region->offset + offset, length);
+      if (nread < 0)
         {
-          break;
+          ret = nread;
+        }
+      else if (offset + nread > region->nvalid)
+        {
+          region->nvalid = offset + nread;
         }
+    }
 
-      /* Increment number of bytes read */
+  nxmutex_unlock(&g_rammap_lock);
+  return ret;
+}
 
-      rdbuffer += nread;
-      length   -= nread;
+/****************************************************************************
+ * Name: rammap_private
+ *
+ * Description:
+ *   Map a private copy of a file.
+ *
+ ****************************************************************************/
+
+static int rammap_private(FAR struct file *filep,
+                          FAR struct mm_map_entry_s *entry, bool kernel)
+{
+  FAR uint8_t *rdbuffer;
+  ssize_t nread;
+  int ret;
+
+  /* Allocate a region of memory of the specified size */
+
+  rdbuffer = kernel ? kmm_malloc(entry->length) :
+                      kumm_malloc(entry->length);
+  if (!rdbuffer)
+    {
+      ferr("ERROR: Region allocation failed, length: %zu\n", entry->length);
+      return -ENOMEM;
     }
 
-  /* Zero any memory beyond the amount read from the file */
+  /* Read the file data into the memory region */
 
-  memset(rdbuffer, 0, length);
+  nread = rammap_read(filep, rdbuffer, entry->offset, entry->length);
+  if (nread < 0)
+    {
+      ret = nread;
+      goto errout_with_region;
+    }
 
   /* Add the buffer to the list of regions */
 
+  entry->vaddr  = rdbuffer;
   entry->priv.i = kernel;
   entry->munmap = unmap_rammap;
+  entry->msync  = NULL;
 
   ret = mm_map_add(get_current_mm(), entry);
   if (ret < 0)
@@ -252,14 +574,508 @@ int rammap(FAR struct file *filep, FAR struct mm_map_entry_s *entry,
 errout_with_region:
   if (kernel)
     {
-      kmm_free(entry->vaddr);
+      kmm_free(rdbuffer);
     }
   else
     {
-      kumm_free(entry->vaddr);
+      kumm_free(rdbuffer);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: rammap_match
+ *
+ * Description:
+ *   Check if a region holds the requested range of the file.  The inode of
+ *   a file on a mountpoint is the inode of the mountpoint, so such files
+ *   are told apart by their path.  A file that replaced the mapped one at
+ *   the same path is told apart by its attributes.
+ *
+ ****************************************************************************/
+
+static bool rammap_match(FAR struct rammap_region_s *region,
+                         FAR struct file *filep, FAR const char *path,
+                         FAR struct mm_map_entry_s *entry, bool kernel)
+{
+  struct stat mapped;
+  struct stat buf;
+
+  if (region->stale || region->file.f_inode != filep->f_inode ||
+      region->offset != entry->offset ||
+      region->length != entry->length ||
+      region->kernel != kernel)
+    {
+      return false;
+    }
+
+#ifdef CONFIG_BUILD_KERNEL
+  /* Each process has its own user heap */
+
+  if (!kernel && region->group != nxsched_self()->group)
+    {
+      return false;
+    }
+#endif
+
+  if (!INODE_IS_MOUNTPT(filep->f_inode))
+    {
+      return true;
+    }
+
+  if (path == NULL || region->path == NULL ||
+      strcmp(region->path, path) != 0)
+    {
+      return false;
+    }
+
+  return file_fstat(&region->file, &mapped) >= 0 &&
+         file_fstat(filep, &buf) >= 0 &&
+         mapped.st_ino == buf.st_ino &&
+         mapped.st_size == buf.st_size &&
+         mapped.st_mtime == buf.st_mtime;
+}
+
+/****************************************************************************
+ * Name: rammap_shared
+ *
+ * Description:
+ *   Map a region that is shared with all other mappings of the same range
+ *   of the same file.
+ *
+ *   Files on a mountpoint are only shared if their path can be obtained
+ *   with FIOC_FILEPATH, which only some file systems (romfs, binfs)
+ *   support.  Other files on a mountpoint get a region of their own.
+ *
+ ****************************************************************************/
+
+static int rammap_shared(FAR struct file *filep,
+                         FAR struct mm_map_entry_s *entry, bool kernel)
+{
+  FAR struct rammap_region_s *region;
+  FAR uint8_t *buffer = NULL;
+  FAR char *path = NULL;
+  struct file file;
+  ssize_t nread = 0;
+  int ret;
+
+  /* Files on a mountpoint share their inode, get the path of the file.
+   * A file without a path is never shared.
+   */
+
+  if (INODE_IS_MOUNTPT(filep->f_inode))
+    {
+      path = kmm_malloc(PATH_MAX);
+      if (path == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      if (file_ioctl(filep, FIOC_FILEPATH, path) < 0)
+        {
+          kmm_free(path);
+          path = NULL;
+        }
+    }
+
+  ret = nxmutex_lock(&g_rammap_lock);
+  if (ret < 0)
+    {
+      goto errout_with_path;
+    }
+
+  /* Look for a copy of the same range of the same file.  The region holds
+   * a reference to the inode, so the inode cannot be reused by another
+   * file while the region exists.
+   */
+
+  for (region = g_rammap_regions; region != NULL; region = region->flink)
+    {
+      if (rammap_match(region, filep, path, entry, kernel))
+        {
+          break;
+        }
+    }
+
+  /* The file may have been changed through write() since the region was
+   * read, without a change of its size or time stamp.  Read the file data
+   * again as if there were no region, and only share the region if it
+   * still holds the same data.  A region with writable, shared mappings
+   * holds changes that are not written back yet, it is always shared.
+   */
+
+  if (region == NULL || region->nwriters == 0)
+    {
+      buffer = kernel ? kmm_malloc(entry->length) :
+                        kumm_malloc(entry->length);
+      if (buffer == NULL)
+        {
+          ferr("ERROR: Region allocation failed, length: %zu\n",
+               entry->length);
+          ret = -ENOMEM;
+          goto errout_with_lock;
+        }
+
+      nread = rammap_read(filep, buffer, entry->offset, entry->length);
+      if (nread < 0)
+        {
+          ret = nread;
+          goto errout_with_buffer;
+        }
+
+      if (region != NULL &&
+          ((size_t)nread != region->nvalid ||
+           memcmp(buffer, region->vaddr, entry->length) != 0))
+        {
+          /* The region is stale.  Its mappings keep it, but it is not
+           * shared with new mappings any more.
+           */
+
+          region->stale = true;
+          region = NULL;
+        }
+    }
+
+  if (region == NULL)
+    {
+      /* No.. Make a new region of the file data just read */
+
+      region = kmm_zalloc(sizeof(struct rammap_region_s));
+      if (region == NULL)
+        {
+          ret = -ENOMEM;
+          goto errout_with_buffer;
+        }
+
+      ret = file_dup2(filep, &region->file);
+      if (ret < 0)
+        {
+          kmm_free(region);
+          goto errout_with_buffer;
+        }
+
+      region->path     = path;
+      region->vaddr    = buffer;
+      region->length   = entry->length;
+      region->nvalid   = nread;
+      region->offset   = entry->offset;
+      region->kernel   = kernel;
+#ifdef CONFIG_BUILD_KERNEL
+      region->group    = nxsched_self()->group;
+#endif
+      region->flink    = g_rammap_regions;
+      g_rammap_regions = region;
+      path             = NULL;
+      buffer           = NULL;
+    }
+  else if (RAMMAP_WRITEBACK(entry) &&
+           (region->file.f_oflags & O_WROK) == 0 &&
+           (filep->f_oflags & O_WROK) != 0)
+    {
+      /* The region was mapped through a read-only file.  Write back
+       * through this one from now on.
+       */
+
+      memset(&file, 0, sizeof(file));
+      if (file_dup2(filep, &file) >= 0)
+        {
+          file_close(&region->file);
+          memcpy(&region->file, &file, sizeof(file));
+        }
     }
 
+  region->crefs++;
+  if (RAMMAP_WRITEBACK(entry))
+    {
+      region->nwriters++;
+    }
+
+  entry->vaddr  = region->vaddr;
+  entry->priv.p = region;
+  entry->munmap = unmap_shared;
+  entry->msync  = msync_shared;
+
+  ret = mm_map_add(get_current_mm(), entry);
+  if (ret < 0)
+    {
+      if (RAMMAP_WRITEBACK(entry))
+        {
+          region->nwriters--;
+        }
+
+      rammap_release(region);
+    }
+
+errout_with_buffer:
+  if (buffer != NULL)
+    {
+      if (kernel)
+        {
+          kmm_free(buffer);
+        }
+      else
+        {
+          kumm_free(buffer);
+        }
+    }
+
+errout_with_lock:
+  nxmutex_unlock(&g_rammap_lock);
+
+errout_with_path:
+  kmm_free(path);
   return ret;
 }
 
+#ifdef RAMMAP_PROCFS
+/****************************************************************************
+ * Name: rammap_open
+ ****************************************************************************/
+
+static int rammap_open(FAR struct file *filep, FAR const char *relpath,
+                       int oflags, mode_t mode)
+{
+  FAR struct rammap_file_s *rmfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* This PROCFS file is read-only.  Any attempt to open with write access
+   * is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  rmfile = kmm_zalloc(sizeof(struct rammap_file_s));
+  if (!rmfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)rmfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: rammap_close
+ ****************************************************************************/
+
+static int rammap_close(FAR struct file *filep)
+{
+  FAR struct rammap_file_s *rmfile;
+
+  /* Recover our private data from the struct file instance */
+
+  rmfile = (FAR struct rammap_file_s *)filep->f_priv;
+  DEBUGASSERT(rmfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(rmfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: rammap_procfs_read
+ ****************************************************************************/
+
+static ssize_t rammap_procfs_read(FAR struct file *filep, FAR char *buffer,
+                                  size_t buflen)
+{
+  FAR struct rammap_file_s *rmfile;
+  FAR struct rammap_region_s *region;
+  unsigned long resident = 0;
+  unsigned long shared = 0;
+  unsigned int nregions = 0;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int ret;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  rmfile = (FAR struct rammap_file_s *)filep->f_priv;
+  DEBUGASSERT(rmfile);
+
+  ret = nxmutex_lock(&g_rammap_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  offset = filep->f_pos;
+
+  /* The first line to output is the header */
+
+  linesize  = procfs_snprintf(rmfile->line, RAMMAP_LINELEN, RAMMAP_HDR_FMT);
+  copysize  = procfs_memcpy(rmfile->line, linesize, buffer, buflen,
+                            &offset);
+  totalsize = copysize;
+
+  /* Then one line for each region */
+
+  for (region = g_rammap_regions; region != NULL; region = region->flink)
+    {
+      nregions++;
+      resident += region->length;
+      shared   += (region->crefs - 1) * (unsigned long)region->length;
+
+      if (totalsize >= buflen)
+        {
+          continue;
+        }
+
+      if (file_ioctl(&region->file, FIOC_FILEPATH, rmfile->path) < 0)
+        {
+          strlcpy(rmfile->path, "?", PATH_MAX);
+        }
+
+      linesize   = procfs_snprintf(rmfile->line, RAMMAP_LINELEN,
+                                   RAMMAP_REGION_FMT, region->crefs,
+                                   (unsigned long)region->offset,
+                                   (unsigned long)region->length,
+                                   rmfile->path);
+      copysize   = procfs_memcpy(rmfile->line, linesize,
+                                 buffer + totalsize, buflen - totalsize,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  /* And finally the totals.  Shared is the memory that the mappings would
+   * use in addition if they did not share regions.
+   */
+
+  if (totalsize < buflen)
+    {
+      linesize   = procfs_snprintf(rmfile->line, RAMMAP_LINELEN,
+                                   RAMMAP_TOTAL_FMT, nregions, resident,
+                                   shared);
+      copysize   = procfs_memcpy(rmfile->line, linesize,
+                                 buffer + totalsize, buflen - totalsize,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  nxmutex_unlock(&g_rammap_lock);
+
+  /* Update the file offset */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: rammap_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int rammap_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct rammap_file_s *oldattr;
+  FAR struct rammap_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct rammap_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct rammap_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct rammap_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: rammap_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int rammap_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "rammap" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+#endif /* RAMMAP_PROCFS */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rammmap
+ *
+ * Description:
+ *   Support simulation of memory mapped files by copying files into RAM.
+ *
+ *   Read-only mappings and shared mappings of the same range of the same
+ *   file share one copy of the file data.  Changes made through shared,
+ *   writable mappings are written back to the file by msync() and
+ *   munmap().  Private, writable mappings get a copy of their own.
+ *
+ * Input Parameters:
+ *   filep   file descriptor of the backing file -- required.
+ *   entry   mmap entry information.
+ *           field offset and length must be initialized correctly.
+ *   kernel  kmm_zalloc or kumm_zalloc
+ *
+ * Returned Value:
+ *  On success, rammap returns 0 and entry->vaddr points to memory mapped.
+ *     Otherwise errno is returned appropriately.
+ *
+ *     EBADF
+ *      'fd' is not a valid file descriptor.
+ *     EINVAL
+ *       'length' or 'offset' are invalid
+ *     ENOMEM
+ *       Insufficient memory is available to map the file.
+ *
+ ****************************************************************************/
+
+int rammap(FAR struct file *filep, FAR struct mm_map_entry_s *entry,
+           bool kernel)
+{
+  if ((entry->prot & PROT_WRITE) != 0 && (entry->flags & MAP_SHARED) == 0)
+    {
+      return rammap_private(filep, entry, kernel);
+    }
+
+  return rammap_shared(filep, entry, kernel);
+}
+
 #endif /* CONFIG_FS_RAMMAP */
@@ -30,9 +30,13 @@
  * - All of the file must be present in memory.  This limits the size of
  *   files that may be memory mapped (especially on MCUs with no significant
  *   RAM resources).
- * - All mapped files are read-only.  You can write to the in-memory image,
- *   but the file contents will not change.
+ * - Only changes made through shared, writable mappings are written back
+ *   to the file, and only by msync() and munmap().  Changes made to the
+ *   file are not seen by existing mappings before msync(MS_INVALIDATE).
  * - There are not access privileges.
+ *
+ * Read-only and shared mappings of the same range of the same file share
+ * one reference counted copy of the file data.
  */
 
 #ifndef __FS_MMAP_FS_RAMMAP_H
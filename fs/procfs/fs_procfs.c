@@ -56,6 +56,7 @@ extern const struct procfs_operations g_clk_operations;
 extern const struct procfs_operations g_cpuinfo_operations;
 extern const struct procfs_operations g_cpuload_operations;
 extern const struct procfs_operations g_critmon_operations;
+extern const struct procfs_operations g_csection_operations;
 extern const struct procfs_operations g_fdt_operations;
 extern const struct procfs_operations g_iobinfo_operations;
 extern const struct procfs_operations g_irq_operations;
@@ -65,6 +66,8 @@ extern const struct procfs_operations g_mempool_operations;
 extern const struct procfs_operations g_module_operations;
 extern const struct procfs_operations g_pm_operations;
 extern const struct procfs_operations g_proc_operations;
+extern const struct procfs_operations g_rammap_operations;
+extern const struct procfs_operations g_rwbuffer_operations;
 extern const struct procfs_operations g_tcbinfo_operations;
 extern const struct procfs_operations g_uptime_operations;
 extern const struct procfs_operations g_version_operations;
@@ -114,6 +117,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "critmon",      &g_critmon_operations,  PROCFS_FILE_TYPE   },
 #endif
 
+#ifdef CONFIG_SCHED_CSECTION_CONTENTION
+  { "csection",     &g_csection_operations, PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_DEVICE_TREE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_FDT)
   { "fdt",          &g_fdt_operations,      PROCFS_FILE_TYPE   },
 #endif
@@ -175,6 +182,14 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "pm/**",        &g_pm_operations,       PROCFS_UNKOWN_TYPE },
 #endif
 
+#if defined(CONFIG_FS_RAMMAP) && !defined(CONFIG_FS_PROCFS_EXCLUDE_RAMMAP)
+  { "rammap",       &g_rammap_operations,   PROCFS_FILE_TYPE   },
+#endif
+
+#ifdef CONFIG_DRVR_RWBUFFER_STATS
+  { "rwbuffer",     &g_rwbuffer_operations, PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_PROCESS
   { "self",         &g_proc_operations,     PROCFS_DIR_TYPE    },
   { "self/**",      &g_proc_operations,     PROCFS_UNKOWN_TYPE },
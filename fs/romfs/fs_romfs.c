@@ -1124,10 +1124,7 @@ static int romfs_bind(FAR struct inode *blkdriver, FAR const void *data,
   return OK;
 
 errout_with_buffer:
-  if (!rm->rm_xipbase)
-    {
-      kmm_free(rm->rm_buffer);
-    }
+  romfs_hwrelease(rm);
 
 errout:
   nxrmutex_destroy(&rm->rm_lock);
@@ -1207,10 +1204,7 @@ static int romfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
 
       /* Release the mountpoint private data */
 
-      if (!rm->rm_xipbase && rm->rm_buffer)
-        {
-          kmm_free(rm->rm_buffer);
-        }
+      romfs_hwrelease(rm);
 
 #ifdef CONFIG_FS_ROMFS_CACHE_NODE
       romfs_freenode(rm->rm_root);
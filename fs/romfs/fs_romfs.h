@@ -112,6 +112,14 @@
 
 #define ROMF_MAX_LINKS 64
 
+/* Number of device sectors cached for metadata accesses */
+
+#ifndef CONFIG_FS_ROMFS_CACHE_META_NSECTORS
+#  define CONFIG_FS_ROMFS_CACHE_META_NSECTORS 1
+#endif
+
+#define ROMFS_NCACHESECTORS CONFIG_FS_ROMFS_CACHE_META_NSECTORS
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -139,6 +147,16 @@ struct romfs_mountpt_s
   uint32_t rm_cachesector;        /* Current sector in the rm_buffer */
   FAR uint8_t *rm_xipbase;        /* Base address of directly accessible media */
   FAR uint8_t *rm_buffer;         /* Device sector buffer, allocated if rm_xipbase==0 */
+#if ROMFS_NCACHESECTORS > 1
+  FAR uint8_t *rm_cachebase;      /* Allocation holding all cached sectors */
+
+  /* Recently used sectors, most recently used first.  The first entry is
+   * always rm_cachesector in rm_buffer.
+   */
+
+  uint32_t rm_cachesectors[ROMFS_NCACHESECTORS];
+  FAR uint8_t *rm_cachebuffers[ROMFS_NCACHESECTORS];
+#endif
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -195,6 +213,7 @@ int  romfs_hwread(FAR struct romfs_mountpt_s *rm, FAR uint8_t *buffer,
 int  romfs_filecacheread(FAR struct romfs_mountpt_s *rm,
                          FAR struct romfs_file_s *rf, uint32_t sector);
 int  romfs_hwconfigure(FAR struct romfs_mountpt_s *rm);
+void romfs_hwrelease(FAR struct romfs_mountpt_s *rm);
 int  romfs_fsconfigure(FAR struct romfs_mountpt_s *rm);
 int  romfs_fileconfigure(FAR struct romfs_mountpt_s *rm,
                          FAR struct romfs_file_s *rf);
@@ -191,6 +191,39 @@ static int16_t romfs_devcacheread(FAR struct romfs_mountpt_s *rm,
         }
       else
         {
+#if ROMFS_NCACHESECTORS > 1
+          FAR uint8_t *buffer;
+          int i;
+
+          /* Look for the sector among the recently used sectors.  If it is
+           * not there, the buffer of the least recently used one is reused.
+           */
+
+          for (i = 1; i < ROMFS_NCACHESECTORS - 1 &&
+                      rm->rm_cachesectors[i] != sector; i++);
+
+          buffer = rm->rm_cachebuffers[i];
+          if (rm->rm_cachesectors[i] != sector)
+            {
+              ret = romfs_hwread(rm, buffer, sector, 1);
+              if (ret < 0)
+                {
+                  rm->rm_cachesectors[i] = (uint32_t)-1;
+                  return (int16_t)ret;
+                }
+            }
+
+          /* Make it the most recently used sector */
+
+          memmove(&rm->rm_cachesectors[1], &rm->rm_cachesectors[0],
+                  i * sizeof(rm->rm_cachesectors[0]));
+          memmove(&rm->rm_cachebuffers[1], &rm->rm_cachebuffers[0],
+                  i * sizeof(rm->rm_cachebuffers[0]));
+
+          rm->rm_cachesectors[0] = sector;
+          rm->rm_cachebuffers[0] = buffer;
+          rm->rm_buffer          = buffer;
+#else
           /* In non-XIP mode, we will have to read the new sector. */
 
           ret = romfs_hwread(rm, rm->rm_buffer, sector, 1);
@@ -198,6 +231,7 @@ static int16_t romfs_devcacheread(FAR struct romfs_mountpt_s *rm,
             {
               return (int16_t)ret;
             }
+#endif
         }
 
       /* Update the cached sector number */
@@ -414,7 +448,8 @@ static int romfs_cachenode(FAR struct romfs_mountpt_s *rm,
   char childname[NAME_MAX + 1];
   uint32_t linkoffset;
   uint32_t info;
-  uint8_t num = 0;
+  uint32_t incr;
+  uint32_t num = 0;
   size_t nsize;
   int ret;
 
@@ -462,7 +497,22 @@ static int romfs_cachenode(FAR struct romfs_mountpt_s *rm,
             {
               FAR void *tmp;
 
-              tmp = kmm_realloc(nodeinfo->rn_child, (num + NODEINFO_NINCR) *
+              /* Grow the node array geometrically so that building the
+               * cache of a large directory is not quadratic.  rn_count
+               * limits the number of entries in one directory.
+               */
+
+              incr = num < NODEINFO_NINCR ? NODEINFO_NINCR : num;
+              if (num + incr > UINT16_MAX)
+                {
+                  incr = UINT16_MAX - num;
+                  if (incr == 0)
+                    {
+                      return -EFBIG;
+                    }
+                }
+
+              tmp = kmm_realloc(nodeinfo->rn_child, (num + incr) *
                                 sizeof(*nodeinfo->rn_child));
               if (tmp == NULL)
                 {
@@ -470,9 +520,9 @@ static int romfs_cachenode(FAR struct romfs_mountpt_s *rm,
                 }
 
               nodeinfo->rn_child = tmp;
-              memset(nodeinfo->rn_child + num, 0, NODEINFO_NINCR *
+              memset(nodeinfo->rn_child + num, 0, incr *
                      sizeof(*nodeinfo->rn_child));
-              num += NODEINFO_NINCR;
+              num += incr;
             }
 
           child = &nodeinfo->rn_child[nodeinfo->rn_count++];
@@ -495,6 +545,22 @@ static int romfs_cachenode(FAR struct romfs_mountpt_s *rm,
     }
   while (next != 0);
 
+  /* Release the unused tail of the node array, but keep the NULL entry
+   * that terminates it for romfs_readdir().
+   */
+
+  if (nodeinfo->rn_count > 0 && nodeinfo->rn_count + 1 < num)
+    {
+      FAR void *tmp;
+
+      tmp = kmm_realloc(nodeinfo->rn_child, (nodeinfo->rn_count + 1) *
+                        sizeof(*nodeinfo->rn_child));
+      if (tmp != NULL)
+        {
+          nodeinfo->rn_child = tmp;
+        }
+    }
+
   if (nodeinfo->rn_count > 1)
     {
       qsort(nodeinfo->rn_child, nodeinfo->rn_count,
@@ -640,6 +706,9 @@ int romfs_hwconfigure(FAR struct romfs_mountpt_s *rm)
 {
   FAR struct inode *inode = rm->rm_blkdriver;
   int ret;
+#if ROMFS_NCACHESECTORS > 1
+  int i;
+#endif
 
   /* Get the underlying device geometry */
 
@@ -720,15 +789,51 @@ int romfs_hwconfigure(FAR struct romfs_mountpt_s *rm)
 
   /* Allocate the device cache buffer for normal sector accesses */
 
+#if ROMFS_NCACHESECTORS > 1
+  rm->rm_cachebase = kmm_malloc(ROMFS_NCACHESECTORS * rm->rm_hwsectorsize);
+  if (!rm->rm_cachebase)
+    {
+      return -ENOMEM;
+    }
+
+  for (i = 0; i < ROMFS_NCACHESECTORS; i++)
+    {
+      rm->rm_cachesectors[i] = (uint32_t)-1;
+      rm->rm_cachebuffers[i] = rm->rm_cachebase + i * rm->rm_hwsectorsize;
+    }
+
+  rm->rm_buffer = rm->rm_cachebuffers[0];
+#else
   rm->rm_buffer = kmm_malloc(rm->rm_hwsectorsize);
   if (!rm->rm_buffer)
     {
       return -ENOMEM;
     }
+#endif
 
   return OK;
 }
 
+/****************************************************************************
+ * Name: romfs_hwrelease
+ *
+ * Description:
+ *   Free the device cache buffers allocated by romfs_hwconfigure().
+ *
+ ****************************************************************************/
+
+void romfs_hwrelease(FAR struct romfs_mountpt_s *rm)
+{
+  if (!rm->rm_xipbase)
+    {
+#if ROMFS_NCACHESECTORS > 1
+      kmm_free(rm->rm_cachebase);
+#else
+      kmm_free(rm->rm_buffer);
+#endif
+    }
+}
+
 /****************************************************************************
  * Name: romfs_fsconfigure
  *
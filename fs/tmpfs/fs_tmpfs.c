@@ -36,6 +36,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
+#include <nuttx/mm/mempool.h>
 
 #include "fs_tmpfs.h"
 
@@ -49,8 +50,10 @@
 #  warning CONFIG_FS_TMPFS_DIRECTORY_FREEGUARD needs to be > ALLOCGUARD
 #endif
 
-#if CONFIG_FS_TMPFS_FILE_FREEGUARD <= CONFIG_FS_TMPFS_FILE_ALLOCGUARD
-#  warning CONFIG_FS_TMPFS_FILE_FREEGUARD needs to be > ALLOCGUARD
+#ifndef CONFIG_FS_TMPFS_CHUNKED
+#  if CONFIG_FS_TMPFS_FILE_FREEGUARD <= CONFIG_FS_TMPFS_FILE_ALLOCGUARD
+#    warning CONFIG_FS_TMPFS_FILE_FREEGUARD needs to be > ALLOCGUARD
+#  endif
 #endif
 
 #define tmpfs_lock(fs) \
@@ -91,6 +94,11 @@ static int  tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
               unsigned int nentries);
 static int  tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
               size_t newsize);
+static void tmpfs_free_filedata(FAR struct tmpfs_file_s *tfo);
+static void tmpfs_unmap_filedata(FAR struct tmpfs_file_s *tfo,
+                                 FAR struct mm_map_entry_s *map);
+static void tmpfs_punch_file(FAR struct tmpfs_file_s *tfo, off_t start,
+              off_t len);
 static void tmpfs_release_lockedobject(FAR struct tmpfs_object_s *to);
 static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo);
 static int  tmpfs_release_file(FAR struct tmpfs_file_s *tfo);
@@ -135,6 +143,7 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
 static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
               size_t buflen);
 static off_t tmpfs_seek(FAR struct file *filep, off_t offset, int whence);
+static int  tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg);
 static int  tmpfs_sync(FAR struct file *filep);
 static int  tmpfs_dup(FAR const struct file *oldp, FAR struct file *newp);
 static int  tmpfs_fstat(FAR const struct file *filep, FAR struct stat *buf);
@@ -167,6 +176,17 @@ static void tmpfs_stat_common(FAR struct tmpfs_object_s *to,
 static int  tmpfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
               FAR struct stat *buf);
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+/* File chunks are allocated from one pool shared by all TMPFS instances */
+
+static struct mempool_s g_tmpfs_chunkpool;
+static bool g_tmpfs_chunkinit;
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -178,7 +198,7 @@ const struct mountpt_operations g_tmpfs_operations =
   tmpfs_read,       /* read */
   tmpfs_write,      /* write */
   tmpfs_seek,       /* seek */
-  NULL,             /* ioctl */
+  tmpfs_ioctl,      /* ioctl */
   tmpfs_mmap,       /* mmap */
   tmpfs_truncate,   /* truncate */
 
@@ -257,6 +277,338 @@ static int tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
   return ret;
 }
 
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+/****************************************************************************
+ * Name: tmpfs_chunkpool_alloc
+ ****************************************************************************/
+
+static FAR void *tmpfs_chunkpool_alloc(FAR struct mempool_s *pool,
+                                       size_t size)
+{
+  return kmm_malloc(size);
+}
+
+/****************************************************************************
+ * Name: tmpfs_chunkpool_free
+ ****************************************************************************/
+
+static void tmpfs_chunkpool_free(FAR struct mempool_s *pool, FAR void *addr)
+{
+  kmm_free(addr);
+}
+
+/****************************************************************************
+ * Name: tmpfs_chunkpool_initialize
+ *
+ * Description:
+ *   Initialize the chunk pool when the first TMPFS instance is bound.
+ *   Binding is serialized by the inode tree lock.
+ *
+ ****************************************************************************/
+
+static int tmpfs_chunkpool_initialize(void)
+{
+  FAR struct mempool_s *pool = &g_tmpfs_chunkpool;
+  int ret;
+
+  if (g_tmpfs_chunkinit)
+    {
+      return OK;
+    }
+
+  pool->blocksize  = TMPFS_CHUNKSIZE;
+  pool->expandsize = CONFIG_FS_TMPFS_CHUNK_EXPAND *
+                     MEMPOOL_REALBLOCKSIZE(pool) + sizeof(sq_entry_t);
+  pool->alloc      = tmpfs_chunkpool_alloc;
+  pool->free       = tmpfs_chunkpool_free;
+
+  ret = mempool_init(pool, "tmpfs");
+  if (ret >= 0)
+    {
+      g_tmpfs_chunkinit = true;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: tmpfs_resize_index
+ *
+ * Description:
+ *   Resize the chunk index of a file so that it holds at least nchunks
+ *   entries.  The index grows geometrically so that appending to a file
+ *   is amortized O(1), and it is only shrunk when most of it is unused.
+ *
+ ****************************************************************************/
+
+static int tmpfs_resize_index(FAR struct tmpfs_file_s *tfo, size_t nchunks)
+{
+  FAR uint8_t **newindex;
+  size_t newsize;
+
+  if (nchunks == 0)
+    {
+      kmm_free(tfo->tfo_chunks);
+      tfo->tfo_chunks  = NULL;
+      tfo->tfo_nchunks = 0;
+      return OK;
+    }
+  else if (nchunks > tfo->tfo_nchunks)
+    {
+      newsize = tfo->tfo_nchunks * 2;
+      if (newsize < nchunks)
+        {
+          newsize = nchunks;
+        }
+    }
+  else if (nchunks <= tfo->tfo_nchunks / 4)
+    {
+      newsize = nchunks;
+    }
+  else
+    {
+      return OK;
+    }
+
+  newindex = kmm_realloc(tfo->tfo_chunks, newsize * sizeof(FAR uint8_t *));
+  if (newindex == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* Entries beyond the end of the file are always holes */
+
+  if (newsize > tfo->tfo_nchunks)
+    {
+      memset(&newindex[tfo->tfo_nchunks], 0,
+             (newsize - tfo->tfo_nchunks) * sizeof(FAR uint8_t *));
+    }
+
+  tfo->tfo_chunks  = newindex;
+  tfo->tfo_nchunks = newsize;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tmpfs_free_chunks
+ *
+ * Description:
+ *   Return the chunks first through last - 1 of a file to the pool,
+ *   leaving holes in their place.  Chunks of a mapped file are cleared
+ *   and kept.
+ *
+ ****************************************************************************/
+
+static void tmpfs_free_chunks(FAR struct tmpfs_file_s *tfo,
+                              size_t first, size_t last)
+{
+  for (; first < last; first++)
+    {
+      if (tfo->tfo_chunks[first] != NULL && tfo->tfo_maps > 0)
+        {
+          /* The chunk may be mapped, clear it instead */
+
+          memset(tfo->tfo_chunks[first], 0, TMPFS_CHUNKSIZE);
+          tfo->tfo_flags |= TFO_FLAG_CLEARED;
+        }
+      else if (tfo->tfo_chunks[first] != NULL)
+        {
+          mempool_free(&g_tmpfs_chunkpool, tfo->tfo_chunks[first]);
+          tfo->tfo_chunks[first] = NULL;
+          tfo->tfo_alloc -= TMPFS_CHUNKSIZE;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: tmpfs_zero_chunk
+ ****************************************************************************/
+
+static void tmpfs_zero_chunk(FAR struct tmpfs_file_s *tfo, size_t index,
+                             size_t offset, size_t len)
+{
+  if (tfo->tfo_chunks[index] != NULL)
+    {
+      memset(tfo->tfo_chunks[index] + offset, 0, len);
+    }
+}
+
+/****************************************************************************
+ * Name: tmpfs_chunk_iszero
+ ****************************************************************************/
+
+static bool tmpfs_chunk_iszero(FAR const uint8_t *chunk)
+{
+  size_t i;
+
+  for (i = 0; i < TMPFS_CHUNKSIZE; i++)
+    {
+      if (chunk[i] != 0)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: tmpfs_realloc_file
+ *
+ * Description:
+ *   Set the size of a chunked file.  Growing a file only extends the chunk
+ *   index, the new range is a hole until it is written.
+ *
+ ****************************************************************************/
+
+static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
+                              size_t newsize)
+{
+  size_t nchunks = TMPFS_NCHUNKS(newsize);
+  size_t offset;
+  int ret;
+
+  if (newsize < tfo->tfo_size)
+    {
+      /* Release the chunks beyond the new end of the file and clear the
+       * rest of the new last chunk so that the file can grow again
+       * without clearing it.
+       */
+
+      tmpfs_free_chunks(tfo, nchunks, TMPFS_NCHUNKS(tfo->tfo_size));
+
+      offset = TMPFS_CHUNKOFFSET(newsize);
+      if (offset > 0)
+        {
+          tmpfs_zero_chunk(tfo, nchunks - 1, offset,
+                           TMPFS_CHUNKSIZE - offset);
+        }
+    }
+
+  /* The index must keep the chunks that were cleared but not freed */
+
+  if (tfo->tfo_maps == 0 || nchunks > tfo->tfo_nchunks)
+    {
+      ret = tmpfs_resize_index(tfo, nchunks);
+      if (ret < 0 && nchunks > tfo->tfo_nchunks)
+        {
+          return ret;
+        }
+    }
+
+  tfo->tfo_size = newsize;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tmpfs_read_chunks
+ ****************************************************************************/
+
+static void tmpfs_read_chunks(FAR struct tmpfs_file_s *tfo,
+                              FAR char *buffer, off_t pos, size_t len)
+{
+  FAR uint8_t *chunk;
+  size_t offset;
+  size_t nbytes;
+
+  while (len > 0)
+    {
+      chunk  = tfo->tfo_chunks[TMPFS_CHUNK(pos)];
+      offset = TMPFS_CHUNKOFFSET(pos);
+      nbytes = TMPFS_CHUNKSIZE - offset;
+      if (nbytes > len)
+        {
+          nbytes = len;
+        }
+
+      /* Holes read back as zeroes */
+
+      if (chunk != NULL)
+        {
+          memcpy(buffer, chunk + offset, nbytes);
+        }
+      else
+        {
+          memset(buffer, 0, nbytes);
+        }
+
+      buffer += nbytes;
+      pos    += nbytes;
+      len    -= nbytes;
+    }
+}
+
+/****************************************************************************
+ * Name: tmpfs_write_chunks
+ *
+ * Description:
+ *   Write to a chunked file, allocating chunks for any holes that are
+ *   written.  The file is extended by the amount of data actually written.
+ *
+ ****************************************************************************/
+
+static ssize_t tmpfs_write_chunks(FAR struct tmpfs_file_s *tfo,
+                                  FAR const char *buffer, off_t pos,
+                                  size_t len)
+{
+  FAR uint8_t *chunk;
+  size_t nwritten = 0;
+  size_t nchunks;
+  size_t offset;
+  size_t nbytes;
+  int ret;
+
+  nchunks = TMPFS_NCHUNKS(pos + len);
+  if (nchunks > tfo->tfo_nchunks)
+    {
+      ret = tmpfs_resize_index(tfo, nchunks);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  while (nwritten < len)
+    {
+      offset = TMPFS_CHUNKOFFSET(pos);
+      nbytes = TMPFS_CHUNKSIZE - offset;
+      if (nbytes > len - nwritten)
+        {
+          nbytes = len - nwritten;
+        }
+
+      chunk = tfo->tfo_chunks[TMPFS_CHUNK(pos)];
+      if (chunk == NULL)
+        {
+          chunk = mempool_alloc(&g_tmpfs_chunkpool);
+          if (chunk == NULL)
+            {
+              break;
+            }
+
+          /* Clear the part of the new chunk that is not written */
+
+          memset(chunk, 0, offset);
+          memset(chunk + offset + nbytes, 0,
+                 TMPFS_CHUNKSIZE - offset - nbytes);
+
+          tfo->tfo_chunks[TMPFS_CHUNK(pos)] = chunk;
+          tfo->tfo_alloc += TMPFS_CHUNKSIZE;
+        }
+
+      memcpy(chunk + offset, buffer + nwritten, nbytes);
+      nwritten += nbytes;
+      pos      += nbytes;
+    }
+
+  if (nwritten > 0 && pos > tfo->tfo_size)
+    {
+      tfo->tfo_size = pos;
+    }
+
+  return nwritten > 0 || len == 0 ? (ssize_t)nwritten : -ENOMEM;
+}
+#else
 /****************************************************************************
  * Name: tmpfs_realloc_file
  ****************************************************************************/
@@ -264,6 +616,7 @@ static int tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
 static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
                               size_t newsize)
 {
+  FAR struct tmpfs_retired_s *retired;
   FAR uint8_t *newdata;
   size_t allocsize;
   size_t delta;
@@ -273,10 +626,15 @@ static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
   if (newsize <= tfo->tfo_alloc)
     {
       /* Shrinking ... Shrink unconditionally if the size is shrinking to
-       * zero.
+       * zero.  Mapped data is never shrunk.
        */
 
-      if (newsize > 0)
+      if (tfo->tfo_maps > 0)
+        {
+          tfo->tfo_size = newsize;
+          return OK;
+        }
+      else if (newsize > 0)
         {
           /* Otherwise, don't realloc unless the object has shrunk by a
            * lot.
@@ -299,12 +657,38 @@ static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
 
   allocsize = newsize + CONFIG_FS_TMPFS_FILE_ALLOCGUARD;
 
-  /* Realloc the file object */
+  if (tfo->tfo_maps > 0)
+    {
+      /* The data is mapped.  Copy it to a new buffer and keep the old one
+       * until the last of its mappings is released.  The new buffer is
+       * not mapped.
+       */
+
+      retired = kmm_malloc(sizeof(struct tmpfs_retired_s));
+      newdata = kmm_malloc(allocsize);
+      if (retired == NULL || newdata == NULL)
+        {
+          kmm_free(retired);
+          kmm_free(newdata);
+          return -ENOMEM;
+        }
 
-  newdata = kmm_realloc(tfo->tfo_data, allocsize);
-  if (newdata == NULL)
+      memcpy(newdata, tfo->tfo_data, tfo->tfo_alloc);
+      retired->flink   = tfo->tfo_retired;
+      retired->data    = tfo->tfo_data;
+      retired->maps    = tfo->tfo_maps;
+      tfo->tfo_retired = retired;
+      tfo->tfo_maps    = 0;
+    }
+  else
     {
-      return -ENOMEM;
+      /* Realloc the file object */
+
+      newdata = kmm_realloc(tfo->tfo_data, allocsize);
+      if (newdata == NULL)
+        {
+          return -ENOMEM;
+        }
     }
 
   /* Return the new address of the reallocated file object */
@@ -314,6 +698,188 @@ static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
   tfo->tfo_data  = newdata;
   return OK;
 }
+#endif /* CONFIG_FS_TMPFS_CHUNKED */
+
+/****************************************************************************
+ * Name: tmpfs_free_filedata
+ ****************************************************************************/
+
+static void tmpfs_free_filedata(FAR struct tmpfs_file_s *tfo)
+{
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+  if (tfo->tfo_chunks != NULL)
+    {
+      tmpfs_free_chunks(tfo, 0, tfo->tfo_nchunks);
+      kmm_free(tfo->tfo_chunks);
+    }
+#else
+  FAR struct tmpfs_retired_s *retired;
+
+  while ((retired = tfo->tfo_retired) != NULL)
+    {
+      tfo->tfo_retired = retired->flink;
+      kmm_free(retired->data);
+      kmm_free(retired);
+    }
+
+  kmm_free(tfo->tfo_data);
+#endif
+}
+
+/****************************************************************************
+ * Name: tmpfs_unmap_filedata
+ *
+ * Description:
+ *   Release a mapping of the file data in place.  When the last mapping of
+ *   some data is gone, free the data that was kept only for the mappings.
+ *
+ ****************************************************************************/
+
+static void tmpfs_unmap_filedata(FAR struct tmpfs_file_s *tfo,
+                                 FAR struct mm_map_entry_s *map)
+{
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+  size_t index;
+
+  UNUSED(map);
+
+  DEBUGASSERT(tfo->tfo_maps > 0);
+  if (--tfo->tfo_maps > 0)
+    {
+      return;
+    }
+
+  /* Free the chunks beyond the end of the file that were only cleared */
+
+  tmpfs_free_chunks(tfo, TMPFS_NCHUNKS(tfo->tfo_size), tfo->tfo_nchunks);
+  tmpfs_resize_index(tfo, TMPFS_NCHUNKS(tfo->tfo_size));
+
+  /* And the cleared chunks inside of the file, which are holes now.  Any
+   * chunk of zeroes reads back the same as a hole.
+   */
+
+  if ((tfo->tfo_flags & TFO_FLAG_CLEARED) != 0)
+    {
+      tfo->tfo_flags &= ~TFO_FLAG_CLEARED;
+      for (index = 0; index < TMPFS_NCHUNKS(tfo->tfo_size); index++)
+        {
+          if (tfo->tfo_chunks[index] != NULL &&
+              tmpfs_chunk_iszero(tfo->tfo_chunks[index]))
+            {
+              tmpfs_free_chunks(tfo, index, index + 1);
+            }
+        }
+    }
+#else
+  FAR struct tmpfs_retired_s **prev;
+  FAR struct tmpfs_retired_s *retired;
+  FAR uint8_t *data = (FAR uint8_t *)map->vaddr - map->offset;
+
+  if (data == tfo->tfo_data)
+    {
+      DEBUGASSERT(tfo->tfo_maps > 0);
+      tfo->tfo_maps--;
+      return;
+    }
+
+  /* The mapping is of data that was replaced since */
+
+  for (prev = &tfo->tfo_retired; (retired = *prev) != NULL;
+       prev = &retired->flink)
+    {
+      if (retired->data == data)
+        {
+          DEBUGASSERT(retired->maps > 0);
+          if (--retired->maps == 0)
+            {
+              *prev = retired->flink;
+              kmm_free(retired->data);
+              kmm_free(retired);
+            }
+
+          return;
+        }
+    }
+
+  DEBUGPANIC();
+#endif
+}
+
+/****************************************************************************
+ * Name: tmpfs_punch_file
+ *
+ * Description:
+ *   Deallocate a range of a file without changing its size.  The range
+ *   reads back as zeroes.  A len of zero means up to the end of the file.
+ *
+ ****************************************************************************/
+
+static void tmpfs_punch_file(FAR struct tmpfs_file_s *tfo, off_t start,
+                             off_t len)
+{
+  off_t end = start + len;
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+  size_t first;
+  size_t last;
+  size_t head;
+  size_t tail;
+#endif
+
+  if (len == 0 || end > tfo->tfo_size)
+    {
+      end = tfo->tfo_size;
+    }
+
+  if (start >= end)
+    {
+      return;
+    }
+
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+  /* Allocated chunks are already zero beyond the end of the file, so a
+   * range that extends to the end of the file may release its last chunk.
+   */
+
+  first = TMPFS_CHUNK(start);
+  head  = TMPFS_CHUNKOFFSET(start);
+
+  if (end == tfo->tfo_size)
+    {
+      last = TMPFS_NCHUNKS(end);
+      tail = 0;
+    }
+  else
+    {
+      last = TMPFS_CHUNK(end);
+      tail = TMPFS_CHUNKOFFSET(end);
+    }
+
+  /* Clear the partially covered chunks at either end of the range and
+   * release the chunks in between.
+   */
+
+  if (head > 0)
+    {
+      if (first == last)
+        {
+          tmpfs_zero_chunk(tfo, first, head, tail - head);
+          return;
+        }
+
+      tmpfs_zero_chunk(tfo, first, head, TMPFS_CHUNKSIZE - head);
+      first++;
+    }
+
+  tmpfs_free_chunks(tfo, first, last);
+
+  if (tail > 0)
+    {
+      tmpfs_zero_chunk(tfo, last, 0, tail);
+    }
+#else
+  memset(&tfo->tfo_data[start], 0, end - start);
+#endif
+}
 
 /****************************************************************************
  * Name: tmpfs_release_lockedobject
@@ -352,7 +918,7 @@ static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo)
     {
       tmpfs_unlock_file(tfo);
       nxrmutex_destroy(&tfo->tfo_lock);
-      kmm_free(tfo->tfo_data);
+      tmpfs_free_filedata(tfo);
       kmm_free(tfo);
     }
 
@@ -547,8 +1113,15 @@ static FAR struct tmpfs_file_s *tmpfs_alloc_file(void)
   tfo->tfo_type  = TMPFS_REGULAR;
   tfo->tfo_refs  = 1;
   tfo->tfo_flags = 0;
+  tfo->tfo_maps  = 0;
   tfo->tfo_size  = 0;
-  tfo->tfo_data  = NULL;
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+  tfo->tfo_nchunks = 0;
+  tfo->tfo_chunks  = NULL;
+#else
+  tfo->tfo_data    = NULL;
+  tfo->tfo_retired = NULL;
+#endif
 
   nxrmutex_init(&tfo->tfo_lock);
   tmpfs_lock_file(tfo);
@@ -1099,8 +1672,14 @@ static int tmpfs_statfs_callout(FAR struct tmpfs_directory_s *tdo,
 
       tmptfo             = (FAR struct tmpfs_file_s *)to;
       tmpbuf->tsf_alloc += sizeof(struct tmpfs_file_s);
-      tmpbuf->tsf_avail += to->to_alloc - tmptfo->tfo_size;
       tmpbuf->tsf_files++;
+
+      /* The chunks of a sparse file may not cover its size */
+
+      if (to->to_alloc > tmptfo->tfo_size)
+        {
+          tmpbuf->tsf_avail += to->to_alloc - tmptfo->tfo_size;
+        }
     }
   else /* if (to->to_type == TMPFS_DIRECTORY) */
     {
@@ -1175,7 +1754,7 @@ static int tmpfs_free_callout(FAR struct tmpfs_directory_s *tdo,
           return TMPFS_UNLINKED;
         }
 
-      kmm_free(tfo->tfo_data);
+      tmpfs_free_filedata(tfo);
     }
   else /* if (to->to_type == TMPFS_DIRECTORY) */
     {
@@ -1496,6 +2075,10 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
 
   /* Copy data from the memory object to the user buffer */
 
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+  tmpfs_read_chunks(tfo, buffer, startpos, nread);
+  filep->f_pos += nread;
+#else
   if (tfo->tfo_data != NULL)
     {
       memcpy(buffer, &tfo->tfo_data[startpos], nread);
@@ -1505,6 +2088,7 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
     {
       DEBUGASSERT(tfo->tfo_size == 0 && nread == 0);
     }
+#endif
 
   /* Release the lock on the file */
 
@@ -1521,8 +2105,10 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
 {
   FAR struct tmpfs_file_s *tfo;
   ssize_t nwritten;
+#ifndef CONFIG_FS_TMPFS_CHUNKED
   off_t startpos;
   off_t endpos;
+#endif
   int ret;
 
   finfo("filep: %p buffer: %p buflen: %lu\n",
@@ -1541,6 +2127,20 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
       return ret;
     }
 
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+  /* Chunks are allocated as they are written, without moving the rest of
+   * the file.
+   */
+
+  nwritten = tmpfs_write_chunks(tfo, buffer, filep->f_pos, buflen);
+  if (nwritten > 0)
+    {
+      filep->f_pos += nwritten;
+    }
+
+  tmpfs_unlock_file(tfo);
+  return nwritten;
+#else
   /* Handle attempts to write beyond the end of the file */
 
   startpos = filep->f_pos;
@@ -1578,6 +2178,7 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
 errout_with_lock:
   tmpfs_unlock_file(tfo);
   return (ssize_t)ret;
+#endif
 }
 
 /****************************************************************************
@@ -1624,6 +2225,60 @@ static off_t tmpfs_seek(FAR struct file *filep, off_t offset, int whence)
   return position;
 }
 
+/****************************************************************************
+ * Name: tmpfs_ioctl
+ ****************************************************************************/
+
+static int tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+  FAR struct tmpfs_file_s *tfo;
+  FAR const struct flock *range;
+  int ret;
+
+  finfo("filep: %p cmd: %d arg: %08lx\n", filep, cmd, arg);
+  DEBUGASSERT(filep->f_priv != NULL);
+
+  /* Recover our private data from the struct file instance */
+
+  tfo = filep->f_priv;
+
+  /* Only one ioctl command is supported */
+
+  if (cmd != FIOC_PUNCHHOLE)
+    {
+      return -ENOTTY;
+    }
+
+  /* Punching a hole modifies the file, it must be open for writing */
+
+  if ((filep->f_oflags & O_WROK) == 0)
+    {
+      return -EBADF;
+    }
+
+  range = (FAR const struct flock *)((uintptr_t)arg);
+  if (range == NULL || range->l_whence != SEEK_SET ||
+      range->l_start < 0 || range->l_len < 0)
+    {
+      return -EINVAL;
+    }
+
+  /* Get exclusive access to the file */
+
+  ret = tmpfs_lock_file(tfo);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  tmpfs_punch_file(tfo, range->l_start, range->l_len);
+
+  /* Release the lock on the file */
+
+  tmpfs_unlock_file(tfo);
+  return OK;
+}
+
 static int tmpfs_unmap(FAR struct task_group_s *group,
                        FAR struct mm_map_entry_s *entry,
                        FAR void *start, size_t length)
@@ -1654,6 +2309,9 @@ static int tmpfs_unmap(FAR struct task_group_s *group,
       ret = mm_map_remove(get_group_mm(group), entry);
       if (ret >= 0)
         {
+          tmpfs_lock_file(tfo);
+          tmpfs_unmap_filedata(tfo, entry);
+          tmpfs_unlock_file(tfo);
           ret = tmpfs_release_file(tfo);
         }
     }
@@ -1676,7 +2334,10 @@ static int tmpfs_unmap(FAR struct task_group_s *group,
 static int tmpfs_mmap(FAR struct file *filep, FAR struct mm_map_entry_s *map)
 {
   FAR struct tmpfs_file_s *tfo;
-  int ret = -EINVAL;
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+  FAR uint8_t *chunk;
+#endif
+  int ret;
 
   DEBUGASSERT(filep->f_priv != NULL);
 
@@ -1686,20 +2347,62 @@ static int tmpfs_mmap(FAR struct file *filep, FAR struct mm_map_entry_s *map)
 
   DEBUGASSERT(tfo != NULL);
 
-  if (map->offset >= 0 && map->offset < tfo->tfo_size &&
-      map->length && map->offset + map->length <= tfo->tfo_size)
+  /* The data must not move between getting its address and counting the
+   * mapping.
+   */
+
+  ret = tmpfs_lock_file(tfo);
+  if (ret < 0)
     {
-      map->vaddr = tfo->tfo_data + map->offset;
-      map->priv.p = tfo;
-      map->munmap = tmpfs_unmap;
-      ret = mm_map_add(get_current_mm(), map);
+      return ret;
+    }
 
-      if (ret >= 0)
-        {
-          tmpfs_lock_file(tfo);
-          tfo->tfo_refs++;
-          tmpfs_unlock_file(tfo);
-        }
+  if (map->offset < 0 || map->offset >= tfo->tfo_size ||
+      map->length == 0 || map->offset + map->length > tfo->tfo_size)
+    {
+      tmpfs_unlock_file(tfo);
+      return -EINVAL;
+    }
+
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+  /* Only a range inside of one allocated chunk can be mapped in place.
+   * Let rammap() handle anything else.
+   */
+
+  chunk = tfo->tfo_chunks[TMPFS_CHUNK(map->offset)];
+  if (chunk == NULL || TMPFS_CHUNK(map->offset) !=
+                       TMPFS_CHUNK(map->offset + map->length - 1))
+    {
+      tmpfs_unlock_file(tfo);
+      return -ENOTTY;
+    }
+
+  map->vaddr = chunk + TMPFS_CHUNKOFFSET(map->offset);
+#else
+  map->vaddr = tfo->tfo_data + map->offset;
+#endif
+  /* Each mapping holds a reference to the file as well */
+
+  if (tfo->tfo_refs == UINT8_MAX || tfo->tfo_maps == UINT8_MAX)
+    {
+      tmpfs_unlock_file(tfo);
+      return -EMFILE;
+    }
+
+  map->priv.p = tfo;
+  map->munmap = tmpfs_unmap;
+
+  tfo->tfo_refs++;
+  tfo->tfo_maps++;
+  tmpfs_unlock_file(tfo);
+
+  ret = mm_map_add(get_current_mm(), map);
+  if (ret < 0)
+    {
+      tmpfs_lock_file(tfo);
+      tmpfs_unmap_filedata(tfo, map);
+      tmpfs_unlock_file(tfo);
+      tmpfs_release_file(tfo);
     }
 
   return ret;
@@ -1832,14 +2535,16 @@ static int tmpfs_truncate(FAR struct file *filep, off_t length)
           goto errout_with_lock;
         }
 
+#ifndef CONFIG_FS_TMPFS_CHUNKED
       /* If the size has increased, then we need to zero the newly added
-       * memory.
+       * memory.  The new range of a chunked file is a hole instead.
        */
 
       if (length > oldsize)
         {
           memset(&tfo->tfo_data[oldsize], 0, length - oldsize);
         }
+#endif
 
       ret = OK;
     }
@@ -2048,10 +2753,23 @@ static int tmpfs_bind(FAR struct inode *blkdriver, FAR const void *data,
 {
   FAR struct tmpfs_directory_s *tdo;
   FAR struct tmpfs_s *fs;
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+  int ret;
+#endif
 
   finfo("blkdriver: %p data: %p handle: %p\n", blkdriver, data, handle);
   DEBUGASSERT(blkdriver == NULL && handle != NULL);
 
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+  /* Create the chunk pool when the first instance is bound */
+
+  ret = tmpfs_chunkpool_initialize();
+  if (ret < 0)
+    {
+      return ret;
+    }
+#endif
+
   /* Create an instance of the tmpfs file system */
 
   fs = kmm_zalloc(sizeof(struct tmpfs_s));
@@ -2282,7 +3000,7 @@ static int tmpfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
   else
     {
       nxrmutex_destroy(&tfo->tfo_lock);
-      kmm_free(tfo->tfo_data);
+      tmpfs_free_filedata(tfo);
       kmm_free(tfo);
     }
 
@@ -2648,6 +3366,16 @@ static void tmpfs_stat_common(FAR struct tmpfs_object_s *to,
   buf->st_blksize = CONFIG_FS_TMPFS_BLOCKSIZE;
   buf->st_blocks  = (objsize + CONFIG_FS_TMPFS_BLOCKSIZE - 1) /
                     CONFIG_FS_TMPFS_BLOCKSIZE;
+
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+  /* A sparse file only uses the memory of its allocated chunks */
+
+  if (to->to_type == TMPFS_REGULAR)
+    {
+      buf->st_blocks = (to->to_alloc + CONFIG_FS_TMPFS_BLOCKSIZE - 1) /
+                       CONFIG_FS_TMPFS_BLOCKSIZE;
+    }
+#endif
 }
 
 /****************************************************************************
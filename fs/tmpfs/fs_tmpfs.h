@@ -39,6 +39,16 @@
 /* Bit definitions for file object flags */
 
 #define TFO_FLAG_UNLINKED (1 << 0)  /* Bit 0: File is unlinked */
+#define TFO_FLAG_CLEARED  (1 << 1)  /* Bit 1: Chunks cleared, not freed */
+
+/* Chunked file storage */
+
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+#  define TMPFS_CHUNKSIZE        CONFIG_FS_TMPFS_CHUNKSIZE
+#  define TMPFS_CHUNK(pos)       ((size_t)((pos) / TMPFS_CHUNKSIZE))
+#  define TMPFS_CHUNKOFFSET(pos) ((size_t)((pos) % TMPFS_CHUNKSIZE))
+#  define TMPFS_NCHUNKS(size)    TMPFS_CHUNK((size) + TMPFS_CHUNKSIZE - 1)
+#endif
 
 /****************************************************************************
  * Public Types
@@ -101,7 +111,30 @@ struct tmpfs_directory_s
 
 #define SIZEOF_TMPFS_DIRECTORY(n) ((n) * sizeof(struct tmpfs_dirent_s))
 
+#ifndef CONFIG_FS_TMPFS_CHUNKED
+/* File data that was replaced while it was mapped in place */
+
+struct tmpfs_retired_s
+{
+  FAR struct tmpfs_retired_s *flink;
+  FAR uint8_t *data;
+  uint8_t      maps;     /* Number of mappings of the data */
+};
+#endif
+
 /* The form of a regular file memory object
+ *
+ * With CONFIG_FS_TMPFS_CHUNKED, the file data is held in TMPFS_CHUNKSIZE
+ * chunks and tfo_alloc is the size of the chunks that are allocated, which
+ * may be less than tfo_size for a sparse file.  Allocated chunks are zero
+ * beyond the end of the file, so a file can grow without clearing them.
+ *
+ * While tfo_maps is non-zero, mmap() or sendfile() access the file data in
+ * place and it is neither moved nor freed.  Chunks are cleared instead of
+ * freed, and are freed when the last mapping is gone.  Contiguous data
+ * that has to grow is copied to a new buffer, the old one being kept in
+ * tfo_retired with its mappings until the last of them is gone.  tfo_maps
+ * then only counts the mappings of the new buffer.
  *
  * NOTE that in this very simplified implementation, there is no per-open
  * state.  The file memory object also serves as the open file object,
@@ -122,8 +155,15 @@ struct tmpfs_file_s
   /* Remaining fields are unique to a directory object */
 
   uint8_t       tfo_flags; /* See TFO_FLAG_* definitions */
+  uint8_t       tfo_maps;  /* Number of mappings of the data in place */
   size_t        tfo_size;  /* Valid file size */
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+  size_t        tfo_nchunks; /* Number of entries in tfo_chunks[] */
+  FAR uint8_t **tfo_chunks;  /* Chunk index, NULL entries are holes */
+#else
   FAR uint8_t  *tfo_data;  /* File data starts here */
+  FAR struct tmpfs_retired_s *tfo_retired; /* Data kept for mappings */
+#endif
 };
 
 /* This structure represents one instance of a TMPFS file system */
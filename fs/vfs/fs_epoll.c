@@ -39,6 +39,7 @@
 #include <nuttx/list.h>
 #include <nuttx/mutex.h>
 #include <nuttx/signal.h>
+#include <nuttx/spinlock.h>
 
 #include "inode/inode.h"
 
@@ -49,6 +50,7 @@
 struct epoll_node_s
 {
   struct list_node      node;
+  struct list_node      rnode;    /* Link in the ready list */
   epoll_data_t          data;
   struct pollfd         pfd;
 };
@@ -61,13 +63,21 @@ struct epoll_head_s
   int                   crefs;
   mutex_t               lock;
   sem_t                 sem;
+  spinlock_t            rlock;    /* Protects the ready list, which is
+                                   * updated from the poll callbacks.
+                                   */
+  struct list_node      ready;    /* The ready list, store all the setuped
+                                   * epoll node notified since the last
+                                   * epoll_wait.
+                                   */
   struct list_node      setup;    /* The setup list, store all the setuped
                                    * epoll node.
                                    */
-  struct list_node      teardown; /* The teardown list, store all the epoll
-                                   * node notified after epoll_wait finish,
-                                   * these epoll node should be setup again
-                                   * to check the pending poll notification.
+  struct list_node      teardown; /* The teardown list, store all the level
+                                   * triggered epoll node reported by the
+                                   * last epoll_wait, these epoll node
+                                   * should be setup again to check if
+                                   * they are still ready.
                                    */
   struct list_node      oneshot;  /* The oneshot list, store all the epoll
                                    * node notified after epoll_wait and with
@@ -97,6 +107,7 @@ static int epoll_do_poll(FAR struct file *filep,
 static int epoll_setup(FAR epoll_head_t *eph);
 static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
                           int maxevents);
+static void epoll_default_cb(FAR struct pollfd *fds);
 
 /****************************************************************************
  * Private Data
@@ -236,6 +247,8 @@ static int epoll_do_create(int size, int flags)
 
   epn = (FAR epoll_node_t *)(eph + 1);
 
+  spin_initialize(&eph->rlock, SP_UNLOCKED);
+  list_initialize(&eph->ready);
   list_initialize(&eph->setup);
   list_initialize(&eph->teardown);
   list_initialize(&eph->oneshot);
@@ -262,6 +275,114 @@ static int epoll_do_create(int size, int flags)
   return fd;
 }
 
+/****************************************************************************
+ * Name: epoll_takeevents
+ *
+ * Description:
+ *   Return and clear the pending events of a node.  poll_notify() adds
+ *   events without the ready list lock, atomically in the SMP case, so
+ *   they are taken atomically as well.  Otherwise events added meanwhile
+ *   on another CPU would be lost.
+ *
+ ****************************************************************************/
+
+static inline pollevent_t epoll_takeevents(FAR struct pollfd *fds)
+{
+#ifdef CONFIG_SMP
+  return __atomic_exchange_n(&fds->revents, 0, __ATOMIC_RELAXED);
+#else
+  pollevent_t revents = fds->revents;
+
+  fds->revents = 0;
+  return revents;
+#endif
+}
+
+/****************************************************************************
+ * Name: epoll_default_cb
+ *
+ * Description:
+ *   The poll callback of the epoll nodes.  Queue the notified node to the
+ *   ready list and wake up epoll_wait.  This may be called from interrupt
+ *   context, so only the ready list spinlock is taken.
+ *
+ ****************************************************************************/
+
+static void epoll_default_cb(FAR struct pollfd *fds)
+{
+  FAR epoll_node_t *epn = container_of(fds, epoll_node_t, pfd);
+  FAR epoll_head_t *eph = fds->arg;
+  irqstate_t flags;
+  int semcount = 0;
+
+  flags = spin_lock_irqsave(&eph->rlock);
+  if (!list_in_list(&epn->rnode))
+    {
+      list_add_tail(&eph->ready, &epn->rnode);
+    }
+
+  spin_unlock_irqrestore(&eph->rlock, flags);
+
+  nxsem_get_value(&eph->sem, &semcount);
+  if (semcount < 1)
+    {
+      nxsem_post(&eph->sem);
+    }
+}
+
+/****************************************************************************
+ * Name: epoll_unready
+ *
+ * Description:
+ *   Remove a node from the ready list and forget its pending events.  The
+ *   node must not be setup any more, or be about to be setup again.
+ *
+ ****************************************************************************/
+
+static void epoll_unready(FAR epoll_head_t *eph, FAR epoll_node_t *epn)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&eph->rlock);
+  if (list_in_list(&epn->rnode))
+    {
+      list_delete(&epn->rnode);
+    }
+
+  epn->pfd.revents = 0;
+  spin_unlock_irqrestore(&eph->rlock, flags);
+}
+
+/****************************************************************************
+ * Name: epoll_isready
+ *
+ * Description:
+ *   Return true if the ready list isn't empty.
+ *
+ ****************************************************************************/
+
+static bool epoll_isready(FAR epoll_head_t *eph)
+{
+  irqstate_t flags;
+  bool ready;
+
+  flags = spin_lock_irqsave(&eph->rlock);
+  ready = !list_is_empty(&eph->ready);
+  spin_unlock_irqrestore(&eph->rlock, flags);
+
+  return ready;
+}
+
+/****************************************************************************
+ * Name: epoll_setup
+ *
+ * Description:
+ *   Setup again the level triggered nodes reported by the last epoll_wait.
+ *   The drivers notify them again at once if they are still ready.  Only
+ *   these nodes are visited, the other nodes stay setup.
+ *
+ ****************************************************************************/
+
 static int epoll_setup(FAR epoll_head_t *eph)
 {
   FAR epoll_node_t *tepn;
@@ -280,7 +401,7 @@ static int epoll_setup(FAR epoll_head_t *eph)
        * cover the situation several poll event pending on one fd.
        */
 
-      epn->pfd.revents = 0;
+      epoll_unready(eph, epn);
       ret = poll_fdsetup(epn->pfd.fd, &epn->pfd, true);
       if (ret < 0)
         {
@@ -297,31 +418,62 @@ static int epoll_setup(FAR epoll_head_t *eph)
   return ret;
 }
 
+/****************************************************************************
+ * Name: epoll_teardown
+ *
+ * Description:
+ *   Report the nodes of the ready list.  Edge triggered nodes stay setup
+ *   and are queued again by their next notification, level triggered nodes
+ *   are torn down until the next epoll_wait checks them again, and oneshot
+ *   nodes are torn down until they are rearmed by EPOLL_CTL_MOD.
+ *
+ ****************************************************************************/
+
 static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
                           int maxevents)
 {
-  FAR epoll_node_t *tepn;
   FAR epoll_node_t *epn;
+  pollevent_t revents;
+  irqstate_t flags;
   int i = 0;
 
   nxmutex_lock(&eph->lock);
 
-  list_for_every_entry_safe(&eph->setup, epn, tepn, epoll_node_t, node)
+  while (i < maxevents)
     {
-      if (epn->pfd.revents != 0 && i < maxevents)
+      flags = spin_lock_irqsave(&eph->rlock);
+      if (list_is_empty(&eph->ready))
+        {
+          spin_unlock_irqrestore(&eph->rlock, flags);
+          break;
+        }
+
+      epn = container_of(list_remove_head(&eph->ready), epoll_node_t,
+                         rnode);
+      revents = epoll_takeevents(&epn->pfd);
+      spin_unlock_irqrestore(&eph->rlock, flags);
+
+      if (revents == 0)
+        {
+          continue;
+        }
+
+      evs[i].data     = epn->data;
+      evs[i++].events = revents;
+
+      if ((epn->pfd.events & EPOLLONESHOT) != 0)
+        {
+          poll_fdsetup(epn->pfd.fd, &epn->pfd, false);
+          epoll_unready(eph, epn);
+          list_delete(&epn->node);
+          list_add_tail(&eph->oneshot, &epn->node);
+        }
+      else if ((epn->pfd.events & EPOLLET) == 0)
         {
-          evs[i].data     = epn->data;
-          evs[i++].events = epn->pfd.revents;
           poll_fdsetup(epn->pfd.fd, &epn->pfd, false);
+          epoll_unready(eph, epn);
           list_delete(&epn->node);
-          if ((epn->pfd.events & EPOLLONESHOT) != 0)
-            {
-              list_add_tail(&eph->oneshot, &epn->node);
-            }
-          else
-            {
-              list_add_tail(&eph->teardown, &epn->node);
-            }
+          list_add_tail(&eph->teardown, &epn->node);
         }
     }
 
@@ -417,6 +569,15 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
       case EPOLL_CTL_ADD:
         finfo("%p CTL ADD: fd=%d ev=%08" PRIx32 "\n", eph, fd, ev->events);
 
+        /* EPOLLEXCLUSIVE can't be combined with EPOLLONESHOT */
+
+        if ((ev->events & (EPOLLEXCLUSIVE | EPOLLONESHOT)) ==
+            (EPOLLEXCLUSIVE | EPOLLONESHOT))
+          {
+            ret = -EINVAL;
+            goto err;
+          }
+
         /* Check repetition */
 
         list_for_every_entry(&eph->setup, epn, epoll_node_t, node)
@@ -475,8 +636,8 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
         epn->data        = ev->data;
         epn->pfd.events  = ev->events;
         epn->pfd.fd      = fd;
-        epn->pfd.arg     = &eph->sem;
-        epn->pfd.cb      = poll_default_cb;
+        epn->pfd.arg     = eph;
+        epn->pfd.cb      = epoll_default_cb;
         epn->pfd.revents = 0;
 
         ret = poll_fdsetup(fd, &epn->pfd, true);
@@ -496,6 +657,7 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
             if (epn->pfd.fd == fd)
               {
                 poll_fdsetup(fd, &epn->pfd, false);
+                epoll_unready(eph, epn);
                 list_delete(&epn->node);
                 list_add_tail(&eph->free, &epn->node);
                 goto out;
@@ -526,6 +688,15 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
 
       case EPOLL_CTL_MOD:
         finfo("%p CTL MOD: fd=%d ev=%08" PRIx32 "\n", eph, fd, ev->events);
+
+        /* EPOLLEXCLUSIVE can only be set by EPOLL_CTL_ADD */
+
+        if ((ev->events & EPOLLEXCLUSIVE) != 0)
+          {
+            ret = -EINVAL;
+            goto err;
+          }
+
         list_for_every_entry(&eph->setup, epn, epoll_node_t, node)
           {
             if (epn->pfd.fd == fd)
@@ -533,6 +704,7 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
                 if (epn->pfd.events != ev->events)
                   {
                     poll_fdsetup(fd, &epn->pfd, false);
+                    epoll_unready(eph, epn);
 
                     epn->data        = ev->data;
                     epn->pfd.events  = ev->events;
@@ -640,7 +812,7 @@ int epoll_pwait(int epfd, FAR struct epoll_event *evs,
 
   nxsig_procmask(SIG_SETMASK, sigmask, &oldsigmask);
 
-  if (timeout == 0)
+  if (timeout == 0 || epoll_isready(eph))
     {
       ret = OK;
     }
@@ -665,7 +837,13 @@ int epoll_pwait(int epfd, FAR struct epoll_event *evs,
     }
   else
     {
-      ret = nxsem_wait(&eph->sem);
+      /* The semaphore may have been posted for nodes reported already */
+
+      do
+        {
+          ret = nxsem_wait(&eph->sem);
+        }
+      while (ret >= 0 && !epoll_isready(eph));
     }
 
   nxsig_procmask(SIG_SETMASK, &oldsigmask, NULL);
@@ -712,7 +890,7 @@ int epoll_wait(int epfd, FAR struct epoll_event *evs,
 
   /* Wait the poll ready */
 
-  if (timeout == 0)
+  if (timeout == 0 || epoll_isready(eph))
     {
       ret = OK;
     }
@@ -737,7 +915,13 @@ int epoll_wait(int epfd, FAR struct epoll_event *evs,
     }
   else
     {
-      ret = nxsem_wait(&eph->sem);
+      /* The semaphore may have been posted for nodes reported already */
+
+      do
+        {
+          ret = nxsem_wait(&eph->sem);
+        }
+      while (ret >= 0 && !epoll_isready(eph));
     }
 
   if (ret < 0)
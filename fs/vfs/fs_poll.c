@@ -24,6 +24,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/epoll.h>
 #include <poll.h>
 #include <time.h>
 #include <assert.h>
@@ -40,6 +41,25 @@
 
 #include "inode/inode.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* In the SMP case the events are added to revents atomically, because
+ * epoll_wait() may read and clear revents on another CPU at the same time
+ * (see epoll_teardown()).
+ */
+
+#ifdef CONFIG_SMP
+#  define poll_addevents(f, e) \
+     __atomic_or_fetch(&(f)->revents, (e), __ATOMIC_RELAXED)
+#  define poll_clrevents(f, e) \
+     __atomic_and_fetch(&(f)->revents, ~(e), __ATOMIC_RELAXED)
+#else
+#  define poll_addevents(f, e) ((f)->revents |= (e))
+#  define poll_clrevents(f, e) ((f)->revents &= ~(e))
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -244,6 +264,8 @@ void poll_default_cb(FAR struct pollfd *fds)
 
 void poll_notify(FAR struct pollfd **afds, int nfds, pollevent_t eventset)
 {
+  bool exclusive = false;
+  pollevent_t revents;
   int i;
   FAR struct pollfd *fds;
 
@@ -254,19 +276,32 @@ void poll_notify(FAR struct pollfd **afds, int nfds, pollevent_t eventset)
       fds = afds[i];
       if (fds != NULL)
         {
+          /* Only the first of the EPOLLEXCLUSIVE waiters is woken up */
+
+          if ((fds->events & EPOLLEXCLUSIVE) != 0)
+            {
+              if (exclusive)
+                {
+                  continue;
+                }
+
+              exclusive = (eventset & (fds->events | POLLERR | POLLHUP)) != 0;
+            }
+
           /* The error event must be set in fds->revents */
 
-          fds->revents |= eventset & (fds->events | POLLERR | POLLHUP);
-          if ((fds->revents & (POLLERR | POLLHUP)) != 0)
+          revents = poll_addevents(fds, eventset &
+                                   (fds->events | POLLERR | POLLHUP));
+          if ((revents & (POLLERR | POLLHUP)) != 0)
             {
               /* Error or Hung up, clear POLLOUT event */
 
-              fds->revents &= ~POLLOUT;
+              revents = poll_clrevents(fds, POLLOUT);
             }
 
-          if (fds->revents != 0 && fds->cb != NULL)
+          if (revents != 0 && fds->cb != NULL)
             {
-              finfo("Report events: %08" PRIx32 "\n", fds->revents);
+              finfo("Report events: %08" PRIx32 "\n", revents);
               fds->cb(fds);
             }
         }
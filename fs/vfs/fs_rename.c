@@ -66,6 +66,7 @@ static int pseudorename(FAR const char *oldpath, FAR struct inode *oldinode,
 {
   struct inode_search_s newdesc;
   FAR struct inode *newinode;
+  FAR struct inode *child;
   FAR char *subdir = NULL;
   int ret;
 
@@ -203,6 +204,15 @@ next_subdir:
 #endif
   newinode->i_private = oldinode->i_private; /* Per inode driver private data */
 
+  /* The children now live below the new inode */
+
+  for (child = newinode->i_child; child != NULL; child = child->i_peer)
+    {
+      inode_hashremove(child);
+      child->i_parent = newinode;
+      inode_hashadd(child);
+    }
+
 #ifdef CONFIG_PSEUDOFS_SOFTLINKS
   /* Prevent the link target string from being deallocated.  The pointer to
    * the allocated link target path was copied above (under the guise of
@@ -25,11 +25,17 @@
 #include <nuttx/config.h>
 
 #include <sys/sendfile.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
 #include <errno.h>
 #include <debug.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/mm/map.h>
+#include <nuttx/sched.h>
 #include <nuttx/net/net.h>
 
 /****************************************************************************
@@ -229,10 +235,206 @@ static ssize_t copyfile(FAR struct file *outfile, FAR struct file *infile,
   return ntransferred;
 }
 
+/****************************************************************************
+ * Name: sendfile_direct
+ *
+ * Description:
+ *   Write the data of a file that is accessible in memory straight to the
+ *   outfile.  Returns -ENOTTY if the file has to be read with copyfile().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SENDFILE_DIRECT
+static ssize_t sendfile_direct(FAR struct file *outfile,
+                               FAR struct file *infile,
+                               FAR off_t *offset, size_t count)
+{
+  struct mm_map_entry_s entry;
+  FAR const uint8_t *data;
+  ssize_t nbyteswritten;
+  size_t ntransferred = 0;
+  ssize_t ret;
+  off_t pos;
+
+  /* Start at the requested offset or at the current file position */
+
+  if (offset)
+    {
+      pos = *offset;
+    }
+  else
+    {
+      pos = file_seek(infile, 0, SEEK_CUR);
+      if (pos < 0)
+        {
+          return pos;
+        }
+    }
+
+  /* Like the TCP path, fall back to copyfile() whenever the file cannot
+   * be mapped in place.
+   */
+
+  ret = file_sendfile_map(infile, pos, count, &entry);
+  if (ret < 0)
+    {
+      return -ENOTTY;
+    }
+
+  /* Write the data with the same error semantics as copyfile() */
+
+  data = entry.vaddr;
+  while (ntransferred < entry.length)
+    {
+      nbyteswritten = file_write(outfile, data + ntransferred,
+                                 entry.length - ntransferred);
+      if (nbyteswritten > 0)
+        {
+          ntransferred += nbyteswritten;
+        }
+      else if (nbyteswritten == 0)
+        {
+          break;
+        }
+      else if (nbyteswritten != -EINTR || ntransferred == 0)
+        {
+          ret = nbyteswritten;
+          break;
+        }
+    }
+
+  file_sendfile_unmap(&entry);
+
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Report the new offset or advance the file position */
+
+  pos += ntransferred;
+  if (offset)
+    {
+      *offset = pos;
+    }
+  else
+    {
+      pos = file_seek(infile, pos, SEEK_SET);
+      if (pos < 0)
+        {
+          return pos;
+        }
+    }
+
+  return ntransferred;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+#ifdef CONFIG_SENDFILE_DIRECT
+/****************************************************************************
+ * Name: file_sendfile_map
+ *
+ * Description:
+ *   Get the address of a range of a file whose data is directly accessible
+ *   in memory.  Only file systems that map files in place (ROMFS on XIP
+ *   media, TMPFS) are used, never the copying rammap() fallback.
+ *
+ ****************************************************************************/
+
+int file_sendfile_map(FAR struct file *filep, off_t offset, size_t count,
+                      FAR struct mm_map_entry_s *entry)
+{
+  FAR struct inode *inode = filep->f_inode;
+  struct stat buf;
+  int ret;
+
+  memset(entry, 0, sizeof(struct mm_map_entry_s));
+
+  if (inode == NULL || !INODE_IS_MOUNTPT(inode) ||
+      inode->u.i_mops->mmap == NULL || (filep->f_oflags & O_RDOK) == 0)
+    {
+      return -ENOTTY;
+    }
+
+  /* The file systems refuse ranges that go past the end of the file */
+
+  ret = file_fstat(filep, &buf);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (offset < 0 || offset >= buf.st_size)
+    {
+      return offset < 0 ? -EINVAL : OK;
+    }
+
+  if (count > buf.st_size - offset)
+    {
+      count = buf.st_size - offset;
+    }
+
+  entry->length = count;
+  entry->offset = offset;
+  entry->prot   = PROT_READ;
+  entry->flags  = MAP_SHARED;
+
+  ret = inode->u.i_mops->mmap(filep, entry);
+  if (ret < 0)
+    {
+      entry->length = 0;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: file_sendfile_unmap
+ *
+ * Description:
+ *   Release a range obtained with file_sendfile_map().  File systems that
+ *   track their mappings registered a copy of the entry with the current
+ *   task group.  Only that copy is released: file_munmap() would also
+ *   unmap any mapping of the caller that overlaps the range.  A mapping of
+ *   the caller that is identical to the copy is interchangeable with it.
+ *
+ ****************************************************************************/
+
+void file_sendfile_unmap(FAR struct mm_map_entry_s *entry)
+{
+  FAR struct task_group_s *group = nxsched_self()->group;
+  FAR struct mm_map_s *mm = get_current_mm();
+  FAR struct mm_map_entry_s *map;
+
+  if (entry->munmap == NULL || entry->length == 0)
+    {
+      return;
+    }
+
+  if (mm_map_lock() < 0)
+    {
+      return;
+    }
+
+  for (map = mm_map_next(mm, NULL); map != NULL; map = mm_map_next(mm, map))
+    {
+      if (map->vaddr == entry->vaddr && map->length == entry->length &&
+          map->offset == entry->offset && map->priv.p == entry->priv.p &&
+          map->munmap == entry->munmap)
+        {
+          map->munmap(group, map, map->vaddr, map->length);
+          break;
+        }
+    }
+
+  mm_map_unlock();
+}
+#endif
+
 /****************************************************************************
  * Name: file_sendfile
  *
@@ -245,6 +447,10 @@ static ssize_t copyfile(FAR struct file *outfile, FAR struct file *infile,
 ssize_t file_sendfile(FAR struct file *outfile, FAR struct file *infile,
                       off_t *offset, size_t count)
 {
+#ifdef CONFIG_SENDFILE_DIRECT
+  ssize_t nsent;
+#endif
+
   if (count == 0)
     {
       nwarn("WARNING: sendfile count is zero\n");
@@ -275,6 +481,16 @@ ssize_t file_sendfile(FAR struct file *outfile, FAR struct file *infile,
     }
 #endif
 
+#ifdef CONFIG_SENDFILE_DIRECT
+  /* Send the file data in place if the file system allows it */
+
+  nsent = sendfile_direct(outfile, infile, offset, count);
+  if (nsent != -ENOTTY)
+    {
+      return nsent;
+    }
+#endif
+
   /* No... then this is probably a file-to-file transfer.  The generic
    * copyfile() can handle that case.
    */
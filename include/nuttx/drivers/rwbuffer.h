@@ -39,6 +39,14 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+#ifndef CONFIG_DRVR_WRITEBUFFER_NSLOTS
+#  define CONFIG_DRVR_WRITEBUFFER_NSLOTS 1
+#endif
+
+#ifndef CONFIG_DRVR_READAHEAD_NSTREAMS
+#  define CONFIG_DRVR_READAHEAD_NSTREAMS 1
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -53,6 +61,52 @@ typedef CODE ssize_t (*rwbreload_t)(FAR void *dev, FAR uint8_t *buffer,
 typedef CODE ssize_t (*rwbflush_t)(FAR void *dev, FAR const uint8_t *buffer,
                                    off_t startblock, size_t nblocks);
 
+/* One slot of the write buffer.  A slot holds the dirty blocks of one page
+ * of wrmaxblocks blocks, aligned to wrmaxblocks.  The dirty blocks are
+ * contiguous and are kept at their offset from the start of the page.
+ */
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+struct rwb_wrslot_s
+{
+  FAR uint8_t  *buffer;          /* wrmaxblocks blocks of the slot */
+  off_t         blockstart;      /* First dirty block, -1 if unused */
+  uint16_t      nblocks;         /* Number of dirty blocks */
+  uint32_t      stamp;           /* Time of last use */
+};
+#endif
+
+/* One read-ahead stream.  Each stream has its own read-ahead buffer and
+ * remembers where the next sequential read of the stream would start.
+ */
+
+#ifdef CONFIG_DRVR_READAHEAD
+struct rwb_rhslot_s
+{
+  FAR uint8_t  *buffer;          /* rhmaxblocks blocks of the stream */
+  off_t         blockstart;      /* First block in the buffer, -1 if none */
+  off_t         nextblock;       /* Block after the last one read */
+  uint16_t      nblocks;         /* Number of blocks in the buffer */
+  uint16_t      window;          /* Number of blocks of the last reload */
+  uint32_t      stamp;           /* Time of last use */
+};
+#endif
+
+/* Buffer statistics, reported in /proc/rwbuffer */
+
+#ifdef CONFIG_DRVR_RWBUFFER_STATS
+struct rwb_stats_s
+{
+  uint32_t      rdblocks;        /* Blocks read by the caller */
+  uint32_t      rdhits;          /* ... found in a buffer */
+  uint32_t      rhloads;         /* Reloads of a read-ahead buffer */
+  uint32_t      rhblocks;        /* Blocks read from the media by reloads */
+  uint32_t      wrblocks;        /* Blocks written by the caller */
+  uint32_t      wrflushes;       /* Writes of buffered blocks to the media */
+  uint32_t      wrflushblocks;   /* Blocks written by those flushes */
+};
+#endif
+
 /* This structure holds the state of the buffers.  In typical usage,
  * an instance of this structure is declared within each block driver
  * status structure like:
@@ -129,18 +183,23 @@ struct rwbuffer_s
 #ifdef CONFIG_DRVR_WRITEBUFFER
   mutex_t       wrlock;          /* Enforces exclusive access to the write buffer */
   struct work_s work;            /* Delayed work to flush buffer after a delay with no activity */
-  FAR uint8_t  *wrbuffer;        /* Allocated write buffer */
-  uint16_t      wrnblocks;       /* Number of blocks in write buffer */
-  off_t         wrblockstart;    /* First block in write buffer */
+  FAR uint8_t  *wrbuffer;        /* Allocated buffer of all slots */
+  uint32_t      wrstamp;         /* Clock for the replacement of write slots */
+  struct rwb_wrslot_s wrslot[CONFIG_DRVR_WRITEBUFFER_NSLOTS];
 #endif
 
   /* This is the state of the read-ahead buffering */
 
 #ifdef CONFIG_DRVR_READAHEAD
   mutex_t       rhlock;          /* Enforces exclusive access to the write buffer */
-  FAR uint8_t  *rhbuffer;        /* Allocated read-ahead buffer */
-  uint16_t      rhnblocks;       /* Number of blocks in read-ahead buffer */
-  off_t         rhblockstart;    /* First block in read-ahead buffer */
+  FAR uint8_t  *rhbuffer;        /* Allocated buffer of all streams */
+  uint32_t      rhstamp;         /* Clock for the replacement of streams */
+  struct rwb_rhslot_s rhslot[CONFIG_DRVR_READAHEAD_NSTREAMS];
+#endif
+
+#ifdef CONFIG_DRVR_RWBUFFER_STATS
+  FAR struct rwbuffer_s *flink;  /* Next initialized buffer */
+  struct rwb_stats_s stats;      /* Buffer statistics */
 #endif
 };
 
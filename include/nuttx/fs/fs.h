@@ -405,6 +405,9 @@ struct inode
   FAR struct inode *i_parent;   /* Link to parent level inode */
   FAR struct inode *i_peer;     /* Link to same level inode */
   FAR struct inode *i_child;    /* Link to lower level inode */
+#ifdef CONFIG_FS_INODE_HASH
+  FAR struct inode *i_hnext;    /* Link to next inode in hash bucket */
+#endif
   int16_t           i_crefs;    /* References to inode */
   uint16_t          i_flags;    /* Flags for inode */
   union inode_ops_u u;          /* Inode operations */
@@ -1343,6 +1346,42 @@ ssize_t file_pwrite(FAR struct file *filep, FAR const void *buf,
 ssize_t file_sendfile(FAR struct file *outfile, FAR struct file *infile,
                       FAR off_t *offset, size_t count);
 
+#ifdef CONFIG_SENDFILE_DIRECT
+/****************************************************************************
+ * Name: file_sendfile_map
+ *
+ * Description:
+ *   Get the address of a range of a file whose data is directly accessible
+ *   in memory so that it can be sent without reading it first.
+ *
+ * Input Parameters:
+ *   filep  - The file to access
+ *   offset - Offset of the first byte of the range
+ *   count  - Length of the range.  It is clipped at the end of the file.
+ *   entry  - Receives the address (vaddr) and length of the range.  A
+ *            length of zero means that offset is at or beyond end of file.
+ *
+ * Returned Value:
+ *   Zero (OK) on success.  -ENOTTY if the file data cannot be accessed in
+ *   place; any other negated errno value on failure.  A successful mapping
+ *   must be released with file_sendfile_unmap().
+ *
+ ****************************************************************************/
+
+int file_sendfile_map(FAR struct file *filep, off_t offset, size_t count,
+                      FAR struct mm_map_entry_s *entry);
+
+/****************************************************************************
+ * Name: file_sendfile_unmap
+ *
+ * Description:
+ *   Release a range obtained with file_sendfile_map().
+ *
+ ****************************************************************************/
+
+void file_sendfile_unmap(FAR struct mm_map_entry_s *entry);
+#endif
+
 /****************************************************************************
  * Name: file_seek
  *
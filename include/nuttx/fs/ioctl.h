@@ -199,6 +199,15 @@
                                            */
 #endif
 
+#define FIOC_PUNCHHOLE  _FIOC(0x0010)     /* IN:  FAR const struct flock *
+                                           *      l_start and l_len of the
+                                           *      range to deallocate
+                                           *      (l_whence is SEEK_SET, a
+                                           *      l_len of 0 means up to the
+                                           *      end of the file)
+                                           * OUT: None
+                                           */
+
 /* NuttX file system ioctl definitions **************************************/
 
 #define _DIOCVALID(c)   (_IOC_TYPE(c)==_DIOCBASE)
@@ -312,6 +321,17 @@
                                            *      to return sector numbers.
                                            * OUT: Data return in user-provided
                                            *      buffer. */
+#define BIOC_CACHESIZE  _BIOC(0x0011)     /* Set the number of sectors held
+                                           * in the sector cache of a BCH
+                                           * device.
+                                           * IN:  Number of sectors
+                                           * OUT: None */
+#define BIOC_CACHESTAT  _BIOC(0x0012)     /* Get the statistics of the
+                                           * sector cache of a BCH device.
+                                           * IN:  Pointer to writable instance
+                                           *      of struct bch_cachestat_s
+                                           * OUT: Data return in user-provided
+                                           *      buffer. */
 
 /* NuttX MTD driver ioctl definitions ***************************************/
 
@@ -686,6 +706,15 @@ struct pipe_peek_s
   size_t size;
 };
 
+/* Used with BIOC_CACHESTAT */
+
+struct bch_cachestat_s
+{
+  size_t   nsectors;   /* Number of sectors held in the cache */
+  uint32_t hits;       /* Number of sector lookups served by the cache */
+  uint32_t misses;     /* Number of sector lookups read from the media */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
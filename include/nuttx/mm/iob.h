@@ -81,6 +81,11 @@
 #define IOB_DATA(p)      (&(p)->io_data[(p)->io_offset])
 #define IOB_FREESPACE(p) (CONFIG_IOB_BUFSIZE - (p)->io_len - (p)->io_offset)
 
+/* Checksum offload state of a packet, see io_csumflags */
+
+#define IOB_CSUM_PARTIAL 0x01 /* The device must complete the checksum */
+#define IOB_CSUM_VALID   0x02 /* The device has verified the checksum */
+
 #if CONFIG_IOB_NCHAINS > 0
 /* Queue helpers */
 
@@ -114,6 +119,17 @@ struct iob_s
 #endif
   unsigned int io_pktlen; /* Total length of the packet */
 
+#ifdef CONFIG_NETDEV_CHECKSUM_OFFLOAD
+  /* Checksum offload state of the packet, only valid for the I/O buffer at
+   * the head of the chain.  The offsets are relative to the beginning of
+   * the data (io_offset) of the head.
+   */
+
+  uint8_t  io_csumflags;  /* See IOB_CSUM_* definitions */
+  uint16_t io_csumstart;  /* Start of the data covered by the checksum */
+  uint16_t io_csumoffset; /* Offset of the checksum field from csumstart */
+#endif
+
   uint8_t  io_data[CONFIG_IOB_BUFSIZE];
 };
 
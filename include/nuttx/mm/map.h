@@ -67,6 +67,15 @@ struct mm_map_entry_s
                 FAR struct mm_map_entry_s *entry,
                 FAR void *start,
                 size_t length);
+
+  /* Mappings that are backed by a copy of a file may implement msync to
+   * write the changes back to the file.  May be NULL.
+   */
+
+  int (*msync)(FAR struct mm_map_entry_s *entry,
+               FAR void *start,
+               size_t length,
+               int flags);
 };
 
 /* A structure for the task group */
@@ -88,6 +88,19 @@ struct mempool_procfs_entry_s
 };
 #endif
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+/* This structure describes the free blocks of a pool owned by one CPU */
+
+struct mempool_percpu_s
+{
+  sq_queue_t    queue; /* The free block queue of the CPU */
+  size_t        nblks; /* The number of blocks in queue */
+  spinlock_t    lock;  /* Protects queue against draining by other CPUs */
+  unsigned long nhit;  /* The allocations served from queue */
+  unsigned long nmiss; /* The allocations that refilled queue */
+};
+#endif
+
 /* This structure describes memory buffer pool */
 
 struct mempool_s
@@ -112,8 +125,15 @@ struct mempool_s
 #else
   size_t     nalloc;    /* The number of used block in mempool */
 #endif
+#ifdef CONFIG_TICKET_SPINLOCK
+  ticketlock_t lock;    /* The protect lock to mempool */
+#else
   spinlock_t lock;      /* The protect lock to mempool */
+#endif
   sem_t      waitsem;   /* The semaphore of waiter get free block */
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  struct mempool_percpu_s percpu[CONFIG_SMP_NCPUS]; /* The CPU free lists */
+#endif
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL)
   struct mempool_procfs_entry_s procfs; /* The entry of procfs */
 #endif
@@ -139,6 +159,10 @@ struct mempoolinfo_s
   unsigned long aordblks; /* This is the number of used blocks */
   unsigned long sizeblks; /* This is the size of a mempool blocks */
   unsigned long nwaiter;  /* This is the number of waiter for mempool */
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  unsigned long nhit;     /* This is the number of CPU free list hits */
+  unsigned long nmiss;    /* This is the number of CPU free list refills */
+#endif
 };
 
 /****************************************************************************
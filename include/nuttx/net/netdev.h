@@ -168,6 +168,21 @@
 #define IPv4BUF ((FAR struct ipv4_hdr_s *)IPBUF(0))
 #define IPv6BUF ((FAR struct ipv6_hdr_s *)IPBUF(0))
 
+/* Offload capabilities of a network device, see d_features */
+
+#define NETDEV_F_TXCSUM  (1 << 0) /* Completes TCP checksums on transmit */
+#define NETDEV_F_RXCSUM  (1 << 1) /* Verifies TCP/UDP checksums on receive */
+
+/* Check if the device has verified the checksum of the packet in d_iob */
+
+#ifdef CONFIG_NETDEV_CHECKSUM_OFFLOAD
+#  define NETDEV_RXCSUM_VALID(dev) \
+     (((dev)->d_features & NETDEV_F_RXCSUM) != 0 && \
+      ((dev)->d_iob->io_csumflags & IOB_CSUM_VALID) != 0)
+#else
+#  define NETDEV_RXCSUM_VALID(dev) false
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -271,6 +286,10 @@ struct net_driver_s
 
   uint16_t d_pktsize;           /* Maximum packet size */
 
+#ifdef CONFIG_NETDEV_CHECKSUM_OFFLOAD
+  uint8_t d_features;           /* Offload capabilities, see NETDEV_F_* */
+#endif
+
   /* Link layer address */
 
 #if defined(CONFIG_NET_ETHERNET) || defined(CONFIG_NET_6LOWPAN) || \
@@ -827,6 +846,76 @@ uint16_t ipv6_upperlayer_chksum(FAR struct net_driver_s *dev,
                                 uint8_t proto, unsigned int iplen);
 #endif /* CONFIG_NET_IPv6 */
 
+/****************************************************************************
+ * Name: netdev_txcsum_offload
+ *
+ * Description:
+ *   Leave the checksum of the outgoing TCP segment in d_iob to the network
+ *   device if it advertises NETDEV_F_TXCSUM.  The checksum field is set to
+ *   the sum of the pseudo-header and the packet is marked so that the
+ *   driver completes it over the upper layer header and payload.
+ *
+ * Input Parameters:
+ *   dev     - The network driver instance.  The packet data is in d_iob.
+ *   proto   - The upper layer protocol.
+ *   iplen   - The size of the IP header, including IPv4 options or IPv6
+ *             extension headers.
+ *   csumoff - The offset of the checksum field in the upper layer header.
+ *
+ * Returned Value:
+ *   true if the device will complete the checksum; false if the caller
+ *   must calculate it.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_CHECKSUM_OFFLOAD
+bool netdev_txcsum_offload(FAR struct net_driver_s *dev, uint8_t proto,
+                           unsigned int iplen, unsigned int csumoff);
+#else
+#  define netdev_txcsum_offload(dev, proto, iplen, csumoff) false
+#endif
+
+/****************************************************************************
+ * Name: netdev_csum_complete
+ *
+ * Description:
+ *   Complete a partial checksum of a packet in software.  This is shared
+ *   by netdev_txcsum_complete() and the lower half drivers.
+ *
+ * Input Parameters:
+ *   iob    - The packet, starting with the IP header
+ *   start  - The offset in the packet where the checksum starts
+ *   offset - The offset of the checksum field from 'start'
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_CHECKSUM_OFFLOAD
+int netdev_csum_complete(FAR struct iob_s *iob, unsigned int start,
+                         unsigned int offset);
+#endif
+
+/****************************************************************************
+ * Name: netdev_txcsum_complete
+ *
+ * Description:
+ *   Complete in software a checksum of the packet in d_iob that was left
+ *   to the device by netdev_txcsum_offload(), for a packet that is not
+ *   passed to the device.
+ *
+ * Input Parameters:
+ *   dev - The network driver instance.  The packet data is in d_iob.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_CHECKSUM_OFFLOAD
+void netdev_txcsum_complete(FAR struct net_driver_s *dev);
+#else
+#  define netdev_txcsum_complete(dev)
+#endif
+
 /****************************************************************************
  * Name: ipv4_chksum
  *
@@ -126,6 +126,9 @@ struct netdev_lowerhalf_s
    *
    * Fields that lowerhalf should never touch (used by upper half):
    *   d_ifup, d_ifdown, d_txavail, d_addmac, d_rmmac, d_ioctl, d_private
+   *
+   * With CONFIG_NETDEV_CHECKSUM_OFFLOAD, the lowerhalf sets the offloads
+   * it supports in d_features before netdev_lower_register.
    */
 
   struct net_driver_s netdev;
@@ -511,4 +514,69 @@ bool netpkt_is_fragmented(FAR netpkt_t *pkt);
 int netpkt_to_iov(FAR struct netdev_lowerhalf_s *dev, FAR netpkt_t *pkt,
                   FAR struct iovec *iov, int iovcnt);
 
+#ifdef CONFIG_NETDEV_CHECKSUM_OFFLOAD
+/****************************************************************************
+ * Name: netpkt_getcsum
+ *
+ * Description:
+ *   Check if the checksum of a TX packet is left to the device, which is
+ *   only done if the driver sets NETDEV_F_TXCSUM in netdev.d_features.
+ *   The checksum field already holds the sum of the pseudo-header.  The
+ *   device adds the data from 'start' to the end of the packet and stores
+ *   the complement of the result in the field at 'start' + 'offset'.
+ *
+ * Input Parameters:
+ *   dev    - The lower half device driver structure
+ *   pkt    - The net packet
+ *   start  - Returns the offset of netpkt where the checksum starts
+ *   offset - Returns the offset of the checksum field from 'start'
+ *
+ * Returned Value:
+ *   true if the device must complete the checksum.
+ *
+ ****************************************************************************/
+
+bool netpkt_getcsum(FAR struct netdev_lowerhalf_s *dev, FAR netpkt_t *pkt,
+                    FAR unsigned int *start, FAR unsigned int *offset);
+
+/****************************************************************************
+ * Name: netpkt_setcsum_valid
+ *
+ * Description:
+ *   Mark the TCP or UDP checksum of an RX packet as verified by the device,
+ *   so that the stack does not calculate it again.  Only honored if the
+ *   driver sets NETDEV_F_RXCSUM in netdev.d_features.
+ *
+ * Input Parameters:
+ *   dev    - The lower half device driver structure
+ *   pkt    - The net packet
+ *
+ ****************************************************************************/
+
+void netpkt_setcsum_valid(FAR struct netdev_lowerhalf_s *dev,
+                          FAR netpkt_t *pkt);
+
+/****************************************************************************
+ * Name: netpkt_csum_complete
+ *
+ * Description:
+ *   Complete a partial checksum in software, e.g. for a packet received
+ *   from a virtual device that deferred the checksum to the receiver.
+ *
+ * Input Parameters:
+ *   dev    - The lower half device driver structure
+ *   pkt    - The net packet
+ *   start  - The offset of netpkt where the checksum starts
+ *   offset - The offset of the checksum field from 'start'
+ *
+ * Returned Value:
+ *   0:Success; negated errno on failure
+ *
+ ****************************************************************************/
+
+int netpkt_csum_complete(FAR struct netdev_lowerhalf_s *dev,
+                         FAR netpkt_t *pkt, unsigned int start,
+                         unsigned int offset);
+#endif
+
 #endif /* __INCLUDE_NUTTX_NET_NETDEV_LOWERHALF_H */
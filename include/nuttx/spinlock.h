@@ -28,6 +28,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <nuttx/irq.h>
@@ -84,6 +85,73 @@ typedef uint8_t spinlock_t;
 #  define __SP_UNLOCK_FUNCTION 1
 #endif
 
+/* Initial values of the ticket, MCS and read-write spinlocks */
+
+#ifdef CONFIG_TICKET_SPINLOCK
+#  define TICKET_UNLOCKED {{0, 0}}
+#endif
+
+#ifdef CONFIG_MCS_SPINLOCK
+#  define MCS_UNLOCKED NULL
+#endif
+
+#ifdef CONFIG_RW_SPINLOCK
+#  define RW_SP_UNLOCKED       0
+#  define RW_SP_READ_LOCKED    1
+#  define RW_SP_WRITE_LOCKED  -1
+#  define RW_SP_WRITE_WAITING (1 << 30)
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_TICKET_SPINLOCK
+/* A ticket spinlock grants the lock in the order that it was requested.
+ * Each waiter takes the next ticket and spins until the owner field
+ * reaches it, so a CPU cannot be starved by other CPUs re-taking the lock.
+ */
+
+union ticketlock_u
+{
+  struct
+  {
+    uint16_t owner;          /* The ticket that currently holds the lock */
+    uint16_t next;           /* The next ticket to hand out */
+  } tickets;
+  uint32_t value;            /* Both fields, for atomic compare-and-swap */
+};
+
+typedef union ticketlock_u ticketlock_t;
+#endif
+
+#ifdef CONFIG_MCS_SPINLOCK
+/* An MCS spinlock points to the queue node of the last CPU waiting for or
+ * holding the lock.  Each waiter spins on the flag of its own node, which
+ * its predecessor clears when handing the lock over, so waiters never
+ * share a contended cache line.  The node must remain valid until the
+ * lock is released, it is normally a local variable of the caller.
+ */
+
+struct mcs_node_s
+{
+  FAR struct mcs_node_s *volatile next; /* The next waiter in the queue */
+  volatile uint8_t locked;              /* Non-zero while waiting */
+};
+
+typedef FAR struct mcs_node_s *mcslock_t;
+#endif
+
+#ifdef CONFIG_RW_SPINLOCK
+/* A read-write spinlock holds the number of readers holding the lock, or
+ * RW_SP_WRITE_LOCKED if it is held by a writer.  A waiting writer sets
+ * RW_SP_WRITE_WAITING in the reader count; no new reader takes the lock
+ * until the writer had its turn, so readers cannot starve writers.
+ */
+
+typedef int32_t rwlock_t;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -333,6 +401,290 @@ void spin_clrbit(FAR volatile cpu_set_t *set, unsigned int cpu,
                  FAR volatile spinlock_t *orlock);
 #endif
 
+/****************************************************************************
+ * Name: ticket_lock
+ *
+ * Description:
+ *   Take a ticket and loop until the ticket spinlock is granted to it.
+ *   Waiters acquire the lock in FIFO order.
+ *
+ *   This implementation is non-reentrant and is prone to deadlocks in
+ *   the case that any logic on the same CPU attempts to take the lock
+ *   more than once.
+ *
+ * Input Parameters:
+ *   lock - A reference to the ticket spinlock object to lock.
+ *
+ * Returned Value:
+ *   None.  When the function returns, the spinlock was successfully locked
+ *   by this CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_TICKET_SPINLOCK
+void ticket_lock(FAR ticketlock_t *lock);
+#endif
+
+/****************************************************************************
+ * Name: ticket_trylock
+ *
+ * Description:
+ *   Try once to lock the ticket spinlock.  Do not wait if the spinlock is
+ *   already locked or has waiters.
+ *
+ * Input Parameters:
+ *   lock - A reference to the ticket spinlock object to lock.
+ *
+ * Returned Value:
+ *   SP_LOCKED   - Failure, the spinlock was already locked
+ *   SP_UNLOCKED - Success, the spinlock was successfully locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_TICKET_SPINLOCK
+spinlock_t ticket_trylock(FAR ticketlock_t *lock);
+#endif
+
+/****************************************************************************
+ * Name: ticket_unlock
+ *
+ * Description:
+ *   Release the ticket spinlock, granting it to the next waiter.
+ *
+ * Input Parameters:
+ *   lock - A reference to the ticket spinlock object to unlock.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_TICKET_SPINLOCK
+void ticket_unlock(FAR ticketlock_t *lock);
+#endif
+
+/****************************************************************************
+ * Name: ticket_islocked
+ *
+ * Description:
+ *   Test if the ticket spinlock is held.
+ *
+ * Input Parameters:
+ *   lock - A reference to the ticket spinlock object to test.
+ *
+ * Returned Value:
+ *   A boolean value: true the spinlock is locked; false if it is unlocked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_TICKET_SPINLOCK
+/* bool ticket_islocked(FAR ticketlock_t *lock); */
+#  define ticket_islocked(l) ((l)->tickets.owner != (l)->tickets.next)
+#endif
+
+/****************************************************************************
+ * Name: mcs_lock
+ *
+ * Description:
+ *   Queue behind the current holder and waiters of the MCS spinlock and
+ *   loop until the lock is handed over.  Waiters acquire the lock in FIFO
+ *   order and each spins on its own queue node.
+ *
+ *   This implementation is non-reentrant and is prone to deadlocks in
+ *   the case that any logic on the same CPU attempts to take the lock
+ *   more than once.
+ *
+ * Input Parameters:
+ *   lock - A reference to the MCS spinlock object to lock.
+ *   node - The queue node of the caller.  It must remain valid until the
+ *          matching mcs_unlock() returns.
+ *
+ * Returned Value:
+ *   None.  When the function returns, the spinlock was successfully locked
+ *   by this CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MCS_SPINLOCK
+void mcs_lock(FAR mcslock_t *lock, FAR struct mcs_node_s *node);
+#endif
+
+/****************************************************************************
+ * Name: mcs_trylock
+ *
+ * Description:
+ *   Try once to lock the MCS spinlock.  Do not wait if the spinlock is
+ *   already locked.
+ *
+ * Input Parameters:
+ *   lock - A reference to the MCS spinlock object to lock.
+ *   node - The queue node of the caller.
+ *
+ * Returned Value:
+ *   SP_LOCKED   - Failure, the spinlock was already locked
+ *   SP_UNLOCKED - Success, the spinlock was successfully locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MCS_SPINLOCK
+spinlock_t mcs_trylock(FAR mcslock_t *lock, FAR struct mcs_node_s *node);
+#endif
+
+/****************************************************************************
+ * Name: mcs_unlock
+ *
+ * Description:
+ *   Release the MCS spinlock, handing it over to the next waiter.
+ *
+ * Input Parameters:
+ *   lock - A reference to the MCS spinlock object to unlock.
+ *   node - The queue node that was passed to mcs_lock() or mcs_trylock().
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MCS_SPINLOCK
+void mcs_unlock(FAR mcslock_t *lock, FAR struct mcs_node_s *node);
+#endif
+
+/****************************************************************************
+ * Name: mcs_islocked
+ *
+ * Description:
+ *   Test if the MCS spinlock is held.
+ *
+ * Input Parameters:
+ *   lock - A reference to the MCS spinlock object to test.
+ *
+ * Returned Value:
+ *   A boolean value: true the spinlock is locked; false if it is unlocked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MCS_SPINLOCK
+/* bool mcs_islocked(FAR mcslock_t *lock); */
+#  define mcs_islocked(l) (*(l) != MCS_UNLOCKED)
+#endif
+
+/****************************************************************************
+ * Name: read_lock
+ *
+ * Description:
+ *   Loop until the read-write spinlock is taken for reading.  Any number
+ *   of readers may hold the lock at the same time, but not while a writer
+ *   holds it or waits for it.  A CPU must therefore not take the lock for
+ *   reading again while it already holds it.
+ *
+ * Input Parameters:
+ *   lock - A reference to the read-write spinlock object to lock.
+ *
+ * Returned Value:
+ *   None.  When the function returns, the spinlock was successfully locked
+ *   for reading by this CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RW_SPINLOCK
+void read_lock(FAR volatile rwlock_t *lock);
+#endif
+
+/****************************************************************************
+ * Name: read_trylock
+ *
+ * Description:
+ *   Try once to take the read-write spinlock for reading.
+ *
+ * Input Parameters:
+ *   lock - A reference to the read-write spinlock object to lock.
+ *
+ * Returned Value:
+ *   true  - Success, the spinlock was locked for reading
+ *   false - Failure, the spinlock is held or awaited by a writer
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RW_SPINLOCK
+bool read_trylock(FAR volatile rwlock_t *lock);
+#endif
+
+/****************************************************************************
+ * Name: read_unlock
+ *
+ * Description:
+ *   Release a read-write spinlock held for reading.
+ *
+ * Input Parameters:
+ *   lock - A reference to the read-write spinlock object to unlock.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RW_SPINLOCK
+void read_unlock(FAR volatile rwlock_t *lock);
+#endif
+
+/****************************************************************************
+ * Name: write_lock
+ *
+ * Description:
+ *   Loop until the read-write spinlock is taken for writing.  A writer
+ *   keeps new readers out and waits until there are neither readers nor
+ *   another writer.
+ *
+ * Input Parameters:
+ *   lock - A reference to the read-write spinlock object to lock.
+ *
+ * Returned Value:
+ *   None.  When the function returns, the spinlock was successfully locked
+ *   for writing by this CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RW_SPINLOCK
+void write_lock(FAR volatile rwlock_t *lock);
+#endif
+
+/****************************************************************************
+ * Name: write_trylock
+ *
+ * Description:
+ *   Try once to take the read-write spinlock for writing.
+ *
+ * Input Parameters:
+ *   lock - A reference to the read-write spinlock object to lock.
+ *
+ * Returned Value:
+ *   true  - Success, the spinlock was locked for writing
+ *   false - Failure, the spinlock is held by readers or a writer
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RW_SPINLOCK
+bool write_trylock(FAR volatile rwlock_t *lock);
+#endif
+
+/****************************************************************************
+ * Name: write_unlock
+ *
+ * Description:
+ *   Release a read-write spinlock held for writing.
+ *
+ * Input Parameters:
+ *   lock - A reference to the read-write spinlock object to unlock.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RW_SPINLOCK
+void write_unlock(FAR volatile rwlock_t *lock);
+#endif
+
 #endif /* CONFIG_SPINLOCK */
 
 /****************************************************************************
@@ -449,4 +801,159 @@ void spin_unlock_irqrestore_wo_note(FAR spinlock_t *lock, irqstate_t flags);
 #  define spin_unlock_irqrestore_wo_note(l, f) up_irq_restore(f)
 #endif
 
+/****************************************************************************
+ * Name: ticket_lock_irqsave
+ *
+ * Description:
+ *   If SMP is enabled:
+ *     Disable local interrupts, take the ticket spinlock and return the
+ *     interrupt state.
+ *
+ *   If SMP is not enabled:
+ *     This function is equivalent to up_irq_save().
+ *
+ * Input Parameters:
+ *   lock - Caller specific ticket spinlock.  Nested calls for the same
+ *          lock would cause a deadlock.
+ *
+ * Returned Value:
+ *   An opaque, architecture-specific value that represents the state of
+ *   the interrupts prior to the call to ticket_lock_irqsave(lock);
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_TICKET_SPINLOCK
+#  ifdef CONFIG_SMP
+irqstate_t ticket_lock_irqsave(FAR ticketlock_t *lock);
+#  else
+#    define ticket_lock_irqsave(l) ((void)(l), up_irq_save())
+#  endif
+#endif
+
+/****************************************************************************
+ * Name: ticket_unlock_irqrestore
+ *
+ * Description:
+ *   If SMP is enabled:
+ *     Release the ticket spinlock and restore the interrupt state as it was
+ *     prior to the previous call to ticket_lock_irqsave(lock).
+ *
+ *   If SMP is not enabled:
+ *     This function is equivalent to up_irq_restore().
+ *
+ * Input Parameters:
+ *   lock  - Caller specific ticket spinlock.
+ *   flags - The architecture-specific value that represents the state of
+ *           the interrupts prior to the call to ticket_lock_irqsave(lock);
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_TICKET_SPINLOCK
+#  ifdef CONFIG_SMP
+void ticket_unlock_irqrestore(FAR ticketlock_t *lock, irqstate_t flags);
+#  else
+#    define ticket_unlock_irqrestore(l, f) up_irq_restore(f)
+#  endif
+#endif
+
+/****************************************************************************
+ * Name: mcs_lock_irqsave, mcs_unlock_irqrestore
+ *
+ * Description:
+ *   If SMP is enabled:
+ *     Disable local interrupts and take the MCS spinlock, or release it and
+ *     restore the interrupt state returned by mcs_lock_irqsave().
+ *
+ *   If SMP is not enabled:
+ *     These functions are equivalent to up_irq_save() and
+ *     up_irq_restore().
+ *
+ * Input Parameters:
+ *   lock  - Caller specific MCS spinlock.
+ *   node  - The queue node of the caller.
+ *   flags - The value returned by mcs_lock_irqsave().
+ *
+ * Returned Value:
+ *   mcs_lock_irqsave() returns an opaque, architecture-specific value that
+ *   represents the state of the interrupts prior to the call.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MCS_SPINLOCK
+#  ifdef CONFIG_SMP
+irqstate_t mcs_lock_irqsave(FAR mcslock_t *lock,
+                            FAR struct mcs_node_s *node);
+void mcs_unlock_irqrestore(FAR mcslock_t *lock, FAR struct mcs_node_s *node,
+                           irqstate_t flags);
+#  else
+#    define mcs_lock_irqsave(l, n)          ((void)(l), (void)(n), \
+                                             up_irq_save())
+#    define mcs_unlock_irqrestore(l, n, f)  up_irq_restore(f)
+#  endif
+#endif
+
+/****************************************************************************
+ * Name: read_lock_irqsave, write_lock_irqsave
+ *
+ * Description:
+ *   If SMP is enabled:
+ *     Disable local interrupts, take the read-write spinlock for reading
+ *     or for writing and return the interrupt state.
+ *
+ *   If SMP is not enabled:
+ *     These functions are equivalent to up_irq_save().
+ *
+ * Input Parameters:
+ *   lock - Caller specific read-write spinlock.
+ *
+ * Returned Value:
+ *   An opaque, architecture-specific value that represents the state of
+ *   the interrupts prior to the call.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RW_SPINLOCK
+#  ifdef CONFIG_SMP
+irqstate_t read_lock_irqsave(FAR volatile rwlock_t *lock);
+irqstate_t write_lock_irqsave(FAR volatile rwlock_t *lock);
+#  else
+#    define read_lock_irqsave(l)  ((void)(l), up_irq_save())
+#    define write_lock_irqsave(l) ((void)(l), up_irq_save())
+#  endif
+#endif
+
+/****************************************************************************
+ * Name: read_unlock_irqrestore, write_unlock_irqrestore
+ *
+ * Description:
+ *   If SMP is enabled:
+ *     Release the read-write spinlock and restore the interrupt state as it
+ *     was prior to the matching read_lock_irqsave() or
+ *     write_lock_irqsave().
+ *
+ *   If SMP is not enabled:
+ *     These functions are equivalent to up_irq_restore().
+ *
+ * Input Parameters:
+ *   lock  - Caller specific read-write spinlock.
+ *   flags - The value returned by the matching lock call.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RW_SPINLOCK
+#  ifdef CONFIG_SMP
+void read_unlock_irqrestore(FAR volatile rwlock_t *lock, irqstate_t flags);
+void write_unlock_irqrestore(FAR volatile rwlock_t *lock, irqstate_t flags);
+#  else
+#    define read_unlock_irqrestore(l, f)  up_irq_restore(f)
+#    define write_unlock_irqrestore(l, f) up_irq_restore(f)
+#  endif
+#endif
+
 #endif /* __INCLUDE_NUTTX_SPINLOCK_H */
@@ -30,6 +30,10 @@
 #include <nuttx/clock.h>
 #include <stdint.h>
 
+#ifdef CONFIG_WDOG_RBTREE
+#  include <sys/tree.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -75,7 +79,12 @@ struct wdog_s
 #ifdef CONFIG_PIC
   FAR void          *picbase;    /* PIC base address */
 #endif
+#ifdef CONFIG_WDOG_RBTREE
+  RB_ENTRY(wdog_s)   node;       /* Support for the active watchdog tree */
+  clock_t            expired;    /* Tick when the delay expires */
+#else
   sclock_t           lag;        /* Timer associated with the delay */
+#endif
 };
 
 /****************************************************************************
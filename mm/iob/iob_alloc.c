@@ -90,6 +90,9 @@ static FAR struct iob_s *iob_alloc_committed(void)
       iob->io_len    = 0;    /* Length of the data in the entry */
       iob->io_offset = 0;    /* Offset to the beginning of data */
       iob->io_pktlen = 0;    /* Total length of the packet */
+#ifdef CONFIG_NETDEV_CHECKSUM_OFFLOAD
+      iob->io_csumflags = 0; /* No checksum offload */
+#endif
     }
 
   leave_critical_section(flags);
@@ -322,6 +325,9 @@ FAR struct iob_s *iob_tryalloc(bool throttled)
           iob->io_len    = 0;    /* Length of the data in the entry */
           iob->io_offset = 0;    /* Offset to the beginning of data */
           iob->io_pktlen = 0;    /* Total length of the packet */
+#ifdef CONFIG_NETDEV_CHECKSUM_OFFLOAD
+          iob->io_csumflags = 0; /* No checksum offload */
+#endif
           return iob;
         }
     }
@@ -27,6 +27,8 @@
 #include <stdio.h>
 #include <syslog.h>
 
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/mm/mempool.h>
 #include <nuttx/sched.h>
@@ -42,6 +44,29 @@
 #undef  ALIGN_UP
 #define ALIGN_UP(x, a) (((x) + ((a) - 1)) & (~((a) - 1)))
 
+/* The pool lock is a ticket spinlock if they are available, so that CPUs
+ * allocating from a busy pool are served in order.
+ */
+
+#ifdef CONFIG_TICKET_SPINLOCK
+#  define mempool_lock(pool)          ticket_lock_irqsave(&(pool)->lock)
+#  define mempool_unlock(pool, flags) \
+     ticket_unlock_irqrestore(&(pool)->lock, flags)
+#else
+#  define mempool_lock(pool)          spin_lock_irqsave(&(pool)->lock)
+#  define mempool_unlock(pool, flags) \
+     spin_unlock_irqrestore(&(pool)->lock, flags)
+#endif
+
+/* Pools that wait for free blocks must see every free, so they always use
+ * the shared free list.
+ */
+
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+#  define MEMPOOL_PERCPU(pool) (!(pool)->wait || (pool)->expandsize != 0)
+#  define MEMPOOL_PERCPU_BATCH CONFIG_MM_MEMPOOL_PERCPU_BATCH
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -83,6 +108,139 @@ static inline void mempool_add_queue(FAR sq_queue_t *queue,
     }
 }
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+static inline size_t mempool_move_queue(FAR sq_queue_t *dst,
+                                        FAR sq_queue_t *src, size_t nblks)
+{
+  FAR sq_entry_t *blk;
+  size_t count = 0;
+
+  while (count < nblks && (blk = mempool_remove_queue(src)) != NULL)
+    {
+      sq_addfirst(blk, dst);
+      count++;
+    }
+
+  return count;
+}
+
+/* The blocks in the CPU free lists are counted as allocated by nalloc.
+ * The shared lock is only taken to move a batch of blocks, the rest of
+ * the accesses are made by the owning CPU with local interrupts disabled
+ * and the lock of its list held.  That lock is only contended when
+ * another CPU drains the list, the pool lock is always taken after it.
+ */
+
+static inline size_t mempool_percpu_count(FAR struct mempool_s *pool)
+{
+  size_t count = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      count += pool->percpu[cpu].nblks;
+    }
+
+  return count;
+}
+
+static FAR sq_entry_t *mempool_percpu_alloc(FAR struct mempool_s *pool)
+{
+  FAR struct mempool_percpu_s *percpu;
+  FAR sq_entry_t *blk;
+  irqstate_t flags;
+
+  flags  = up_irq_save();
+  percpu = &pool->percpu[up_cpu_index()];
+  spin_lock(&percpu->lock);
+  if (percpu->nblks == 0)
+    {
+      irqstate_t lockflags = mempool_lock(pool);
+
+      percpu->nblks  = mempool_move_queue(&percpu->queue, &pool->queue,
+                                          MEMPOOL_PERCPU_BATCH);
+      pool->nalloc  += percpu->nblks;
+      mempool_unlock(pool, lockflags);
+      percpu->nmiss++;
+    }
+  else
+    {
+      percpu->nhit++;
+    }
+
+  blk = mempool_remove_queue(&percpu->queue);
+  if (blk != NULL)
+    {
+      percpu->nblks--;
+    }
+
+  spin_unlock(&percpu->lock);
+  up_irq_restore(flags);
+  return blk;
+}
+
+static void mempool_percpu_free(FAR struct mempool_s *pool,
+                                FAR sq_entry_t *blk)
+{
+  FAR struct mempool_percpu_s *percpu;
+  irqstate_t flags;
+
+  flags  = up_irq_save();
+  percpu = &pool->percpu[up_cpu_index()];
+  spin_lock(&percpu->lock);
+  if (percpu->nblks >= 2 * MEMPOOL_PERCPU_BATCH)
+    {
+      irqstate_t lockflags = mempool_lock(pool);
+      size_t count;
+
+      count          = mempool_move_queue(&pool->queue, &percpu->queue,
+                                          MEMPOOL_PERCPU_BATCH);
+      percpu->nblks -= count;
+      pool->nalloc  -= count;
+      mempool_unlock(pool, lockflags);
+    }
+
+  sq_addfirst(blk, &percpu->queue);
+  percpu->nblks++;
+  kasan_poison(blk, pool->blocksize);
+  spin_unlock(&percpu->lock);
+  up_irq_restore(flags);
+}
+
+/* Give the blocks of every CPU free list back to the shared free list.
+ * This is done when the shared list runs empty, before the pool is
+ * expanded or the allocation fails, so that the blocks cached by other
+ * CPUs can still be allocated.
+ */
+
+static void mempool_percpu_drain(FAR struct mempool_s *pool)
+{
+  irqstate_t flags = up_irq_save();
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      FAR struct mempool_percpu_s *percpu = &pool->percpu[cpu];
+      irqstate_t lockflags;
+
+      if (percpu->nblks == 0)
+        {
+          continue;
+        }
+
+      spin_lock(&percpu->lock);
+      lockflags      = mempool_lock(pool);
+      pool->nalloc  -= mempool_move_queue(&pool->queue, &percpu->queue,
+                                          percpu->nblks);
+      percpu->nblks  = 0;
+      mempool_unlock(pool, lockflags);
+      spin_unlock(&percpu->lock);
+    }
+
+  up_irq_restore(flags);
+}
+#endif
+
 #if CONFIG_MM_BACKTRACE >= 0
 static inline void mempool_add_backtrace(FAR struct mempool_s *pool,
                                          FAR struct mempool_backtrace_s *buf)
@@ -133,6 +291,9 @@ static inline void mempool_add_backtrace(FAR struct mempool_s *pool,
 int mempool_init(FAR struct mempool_s *pool, FAR const char *name)
 {
   size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  int i;
+#endif
 
   sq_init(&pool->queue);
   sq_init(&pool->iqueue);
@@ -144,6 +305,14 @@ int mempool_init(FAR struct mempool_s *pool, FAR const char *name)
   pool->nalloc = 0;
 #endif
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  memset(pool->percpu, 0, sizeof(pool->percpu));
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      spin_initialize(&pool->percpu[i].lock, SP_UNLOCKED);
+    }
+#endif
+
   if (pool->interruptsize >= blocksize)
     {
       size_t ninterrupt = pool->interruptsize / blocksize;
@@ -186,7 +355,11 @@ int mempool_init(FAR struct mempool_s *pool, FAR const char *name)
       kasan_poison(base, size);
     }
 
+#ifdef CONFIG_TICKET_SPINLOCK
+  pool->lock.value = 0;
+#else
   spin_initialize(&pool->lock, SP_UNLOCKED);
+#endif
   if (pool->wait && pool->expandsize == 0)
     {
       nxsem_init(&pool->waitsem, 0, 0);
@@ -223,10 +396,40 @@ FAR void *mempool_alloc(FAR struct mempool_s *pool)
 {
   FAR sq_entry_t *blk;
   irqstate_t flags;
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  bool drained = false;
+#endif
+
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  if (MEMPOOL_PERCPU(pool))
+    {
+      blk = mempool_percpu_alloc(pool);
+      if (blk != NULL)
+        {
+#  ifdef CONFIG_MM_FILL_ALLOCATIONS
+          memset(blk, 0xaa, pool->blocksize);
+#  endif
+          kasan_unpoison(blk, pool->blocksize);
+          return blk;
+        }
+    }
+#endif
 
 retry:
-  flags = spin_lock_irqsave(&pool->lock);
+  flags = mempool_lock(pool);
   blk = mempool_remove_queue(&pool->queue);
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  if (blk == NULL && MEMPOOL_PERCPU(pool) && !drained)
+    {
+      /* Collect the free blocks cached by the CPUs before giving up */
+
+      mempool_unlock(pool, flags);
+      mempool_percpu_drain(pool);
+      drained = true;
+      goto retry;
+    }
+#endif
+
   if (blk == NULL)
     {
       if (up_interrupt_context())
@@ -241,7 +444,7 @@ retry:
         {
           size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
 
-          spin_unlock_irqrestore(&pool->lock, flags);
+          mempool_unlock(pool, flags);
           if (pool->expandsize >= blocksize + sizeof(sq_entry_t))
             {
               size_t nexpand = (pool->expandsize - sizeof(sq_entry_t)) /
@@ -255,7 +458,7 @@ retry:
                 }
 
               kasan_poison(base, size);
-              flags = spin_lock_irqsave(&pool->lock);
+              flags = mempool_lock(pool);
               mempool_add_queue(&pool->queue, base, nexpand, blocksize);
               sq_addlast((FAR sq_entry_t *)(base + nexpand * blocksize),
                          &pool->equeue);
@@ -285,7 +488,7 @@ retry:
 #endif
   kasan_unpoison(blk, pool->blocksize);
 out_with_lock:
-  spin_unlock_irqrestore(&pool->lock, flags);
+  mempool_unlock(pool, flags);
   return blk;
 }
 
@@ -302,8 +505,26 @@ out_with_lock:
 
 void mempool_free(FAR struct mempool_s *pool, FAR void *blk)
 {
-  irqstate_t flags = spin_lock_irqsave(&pool->lock);
   size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
+  irqstate_t flags;
+
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  /* Blocks of the interrupt pool go back to the shared iqueue */
+
+  if (MEMPOOL_PERCPU(pool) &&
+      (pool->interruptsize <= blocksize ||
+       (FAR char *)blk < pool->ibase ||
+       (FAR char *)blk >= pool->ibase + pool->interruptsize - blocksize))
+    {
+#  ifdef CONFIG_MM_FILL_ALLOCATIONS
+      memset(blk, 0x55, pool->blocksize);
+#  endif
+      mempool_percpu_free(pool, blk);
+      return;
+    }
+#endif
+
+  flags = mempool_lock(pool);
 #if CONFIG_MM_BACKTRACE >= 0
   FAR struct mempool_backtrace_s *buf =
     (FAR struct mempool_backtrace_s *)((FAR char *)blk + pool->blocksize);
@@ -338,7 +559,7 @@ void mempool_free(FAR struct mempool_s *pool, FAR void *blk)
     }
 
   kasan_poison(blk, pool->blocksize);
-  spin_unlock_irqrestore(&pool->lock, flags);
+  mempool_unlock(pool, flags);
   if (pool->wait && pool->expandsize == 0)
     {
       int semcount;
@@ -369,21 +590,30 @@ int mempool_info(FAR struct mempool_s *pool, FAR struct mempoolinfo_s *info)
 {
   size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
   irqstate_t flags;
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  size_t count;
+  int cpu;
+#endif
 
   DEBUGASSERT(pool != NULL && info != NULL);
 
-  flags = spin_lock_irqsave(&pool->lock);
+  flags = mempool_lock(pool);
   info->ordblks = mempool_queue_lenth(&pool->queue);
   info->iordblks = mempool_queue_lenth(&pool->iqueue);
 #if CONFIG_MM_BACKTRACE >= 0
   info->aordblks = list_length(&pool->alist);
 #else
   info->aordblks = pool->nalloc;
+#endif
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  count           = mempool_percpu_count(pool);
+  info->ordblks  += count;
+  info->aordblks -= count;
 #endif
   info->arena =
     mempool_queue_lenth(&pool->equeue) * sizeof(sq_entry_t) +
     (info->aordblks + info->ordblks + info->iordblks) * blocksize;
-  spin_unlock_irqrestore(&pool->lock, flags);
+  mempool_unlock(pool, flags);
   info->sizeblks = blocksize;
   if (pool->wait && pool->expandsize == 0)
     {
@@ -397,6 +627,16 @@ int mempool_info(FAR struct mempool_s *pool, FAR struct mempoolinfo_s *info)
       info->nwaiter = 0;
     }
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  info->nhit  = 0;
+  info->nmiss = 0;
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      info->nhit  += pool->percpu[cpu].nhit;
+      info->nmiss += pool->percpu[cpu].nmiss;
+    }
+#endif
+
   return 0;
 }
 
@@ -409,7 +649,7 @@ mempool_info_task(FAR struct mempool_s *pool,
                   FAR const struct malltask *task)
 {
   size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
-  irqstate_t flags = spin_lock_irqsave(&pool->lock);
+  irqstate_t flags = mempool_lock(pool);
   struct mallinfo_task info =
     {
       0, 0
@@ -420,14 +660,22 @@ mempool_info_task(FAR struct mempool_s *pool,
       size_t count = mempool_queue_lenth(&pool->queue) +
                      mempool_queue_lenth(&pool->iqueue);
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+      count += mempool_percpu_count(pool);
+#endif
       info.aordblks += count;
       info.uordblks += count * blocksize;
     }
 #if CONFIG_MM_BACKTRACE < 0
   else if (task->pid == PID_MM_ALLOC)
     {
-      info.aordblks += pool->nalloc;
-      info.uordblks += pool->nalloc * blocksize;
+      size_t count = pool->nalloc;
+
+#  ifdef CONFIG_MM_MEMPOOL_PERCPU
+      count -= mempool_percpu_count(pool);
+#  endif
+      info.aordblks += count;
+      info.uordblks += count * blocksize;
     }
 #else
   else
@@ -449,7 +697,7 @@ mempool_info_task(FAR struct mempool_s *pool,
     }
 #endif
 
-  spin_unlock_irqrestore(&pool->lock, flags);
+  mempool_unlock(pool, flags);
   return info;
 }
 
@@ -480,6 +728,9 @@ void mempool_memdump(FAR struct mempool_s *pool,
   if (dump->pid == PID_MM_FREE)
     {
       FAR sq_entry_t *entry;
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+      int cpu;
+#endif
 
       sq_for_every(&pool->queue, entry)
         {
@@ -492,6 +743,17 @@ void mempool_memdump(FAR struct mempool_s *pool,
           syslog(LOG_INFO, "%12zu%*p\n",
                  blocksize, MM_PTR_FMT_WIDTH, (FAR char *)entry);
         }
+
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+        {
+          sq_for_every(&pool->percpu[cpu].queue, entry)
+            {
+              syslog(LOG_INFO, "%12zu%*p\n",
+                     blocksize, MM_PTR_FMT_WIDTH, (FAR char *)entry);
+            }
+        }
+#endif
     }
 #if CONFIG_MM_BACKTRACE >= 0
   else
@@ -544,6 +806,20 @@ int mempool_deinit(FAR struct mempool_s *pool)
   size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
   FAR sq_entry_t *blk;
   size_t count = 0;
+#ifdef CONFIG_MM_MEMPOOL_PERCPU
+  int cpu;
+
+  /* Give the blocks of the CPU free lists back to the shared list */
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      FAR struct mempool_percpu_s *percpu = &pool->percpu[cpu];
+
+      pool->nalloc -= mempool_move_queue(&pool->queue, &percpu->queue,
+                                         percpu->nblks);
+      percpu->nblks = 0;
+    }
+#endif
 
 #if CONFIG_MM_BACKTRACE >= 0
   if (!list_is_empty(&pool->alist))
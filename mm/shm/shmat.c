@@ -269,6 +269,7 @@ FAR void *shmat(int shmid, FAR const void *shmaddr, int shmflg)
   entry.length = region->sr_ds.shm_segsz;
   entry.offset = 0;
   entry.munmap = munmap_shm;
+  entry.msync = NULL;
   entry.priv.i = shmid;
 
   ret = mm_map_add(get_current_mm(), &entry);
@@ -37,12 +37,14 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <errno.h>
 
 #include <netinet/arp.h>
 #include <netinet/in.h>
 
+#include <nuttx/hashtable.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/semaphore.h>
 
@@ -66,6 +68,24 @@
 #  define CONFIG_ARP_SEND_DELAYMSEC 20
 #endif
 
+#ifndef CONFIG_NET_ARPTAB_ALLOC
+#  define CONFIG_NET_ARPTAB_ALLOC 0
+#endif
+
+/* The largest number of entries that the ARP table may hold */
+
+#if CONFIG_NET_ARPTAB_ALLOC > 0
+#  define ARP_TABLE_MAXSIZE CONFIG_NET_ARPTAB_MAXSIZE
+#else
+#  define ARP_TABLE_MAXSIZE CONFIG_NET_ARPTAB_SIZE
+#endif
+
+/* Remember the addresses that did not answer ARP requests */
+
+#if defined(CONFIG_NET_ARP_SEND) && CONFIG_NET_ARP_NEGATIVE_TIMEOUT > 0
+#  define NET_ARP_HAVE_NEGATIVE 1
+#endif
+
 /* ARP Definitions **********************************************************/
 
 #define ARP_REQUEST    1
@@ -156,10 +176,15 @@ struct arp_notify_s
 
 struct arp_entry_s
 {
+  hash_node_t              at_hash;     /* Link in the hash bucket */
+  dq_entry_t               at_lru;      /* Link in the LRU or free list */
   in_addr_t                at_ipaddr;   /* IP address */
   struct ether_addr        at_ethaddr;  /* Hardware address */
-  clock_t                  at_time;     /* Time of last usage */
+  clock_t                  at_time;     /* Time of last update */
   FAR struct net_driver_s *at_dev;      /* The device driver structure */
+#ifdef NET_ARP_HAVE_NEGATIVE
+  bool                     at_negative; /* No answer to ARP requests */
+#endif
 };
 
 /****************************************************************************
@@ -262,7 +287,8 @@ void arp_out(FAR struct net_driver_s *dev);
  *   found in the ARP table.  On error a negated errno value is returned:
  *
  *     -ETIMEDOUT:    The number or retry counts has been exceed.
- *     -EHOSTUNREACH: Could not find a route to the host
+ *     -EHOSTUNREACH: Could not find a route to the host, or the host did
+ *                    not answer recent ARP requests
  *
  * Assumptions:
  *   This function is called from the normal tasking context.
@@ -386,6 +412,10 @@ void arp_notify(in_addr_t ipaddr);
  *             available.
  *   dev     - Device structure
  *
+ * Returned Value:
+ *   Zero (OK) if the address mapping is available.  -EHOSTUNREACH if the
+ *   address recently did not answer ARP requests, -ENOENT otherwise.
+ *
  * Assumptions
  *   The network is locked to assure exclusive access to the ARP table.
  *
@@ -476,6 +506,27 @@ int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
 void arp_hdr_update(FAR struct net_driver_s *dev, FAR uint16_t *pipaddr,
                     FAR const uint8_t *ethaddr);
 
+/****************************************************************************
+ * Name: arp_unreachable
+ *
+ * Description:
+ *   Record that the IP address did not answer ARP requests.  arp_find()
+ *   fails with -EHOSTUNREACH for the address until the entry expires after
+ *   CONFIG_NET_ARP_NEGATIVE_TIMEOUT seconds or an ARP reply updates it.
+ *
+ * Input Parameters:
+ *   dev     - The device driver structure
+ *   ipaddr  - The IP address as an inaddr_t
+ *
+ * Assumptions
+ *   The network is locked to assure exclusive access to the ARP table
+ *
+ ****************************************************************************/
+
+#ifdef NET_ARP_HAVE_NEGATIVE
+void arp_unreachable(FAR struct net_driver_s *dev, in_addr_t ipaddr);
+#endif
+
 /****************************************************************************
  * Name: arp_snapshot
  *
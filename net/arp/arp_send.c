@@ -162,7 +162,8 @@ static uint16_t arp_send_eventhandler(FAR struct net_driver_s *dev,
  *   found in the ARP table.  On error a negated errno value is returned:
  *
  *     -ETIMEDOUT:    The number or retry counts has been exceed.
- *     -EHOSTUNREACH: Could not find a route to the host
+ *     -EHOSTUNREACH: Could not find a route to the host, or the host did
+ *                    not answer recent ARP requests
  *
  * Assumptions:
  *   This function is called from the normal tasking context.
@@ -295,12 +296,10 @@ int arp_send(in_addr_t ipaddr)
     {
       /* Check if the address mapping is present in the ARP table.  This
        * is only really meaningful on the first time through the loop.
-       *
-       * NOTE: If the ARP table is large than this could be a performance
-       * issue.
        */
 
-      if (arp_find(ipaddr, NULL, dev) >= 0)
+      ret = arp_find(ipaddr, NULL, dev);
+      if (ret >= 0)
         {
           /* We have it!  Break out with success */
 
@@ -308,6 +307,15 @@ int arp_send(in_addr_t ipaddr)
           break;
         }
 
+#ifdef NET_ARP_HAVE_NEGATIVE
+      if (ret == -EHOSTUNREACH)
+        {
+          /* The address did not answer recently, do not wait for it */
+
+          goto errout_with_callback;
+        }
+#endif
+
       /* Set up the ARP response wait BEFORE we send the ARP request */
 
       arp_wait_setup(ipaddr, &notify);
@@ -377,6 +385,16 @@ timeout:
            ip4_addr3(ipaddr), ip4_addr4(ipaddr));
     }
 
+#ifdef NET_ARP_HAVE_NEGATIVE
+  /* Remember that none of the requests was answered */
+
+  if (ret == -ETIMEDOUT)
+    {
+      arp_unreachable(dev, ipaddr);
+    }
+
+errout_with_callback:
+#endif
   nxsem_destroy(&state.snd_sem);
   arp_callback_free(dev, state.snd_cb);
 errout_with_lock:
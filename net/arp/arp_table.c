@@ -55,6 +55,8 @@
 #include <net/ethernet.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/hashtable.h>
+#include <nuttx/kmalloc.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -71,6 +73,10 @@
 
 #define ARP_MAXAGE_TICK SEC2TICK(10 * CONFIG_NET_ARP_MAXAGE)
 
+#ifdef NET_ARP_HAVE_NEGATIVE
+#  define ARP_NEGATIVE_TICK SEC2TICK(CONFIG_NET_ARP_NEGATIVE_TIMEOUT)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -85,10 +91,25 @@ struct arp_table_info_s
  * Private Data
  ****************************************************************************/
 
-/* The table of known address mappings */
+/* The preallocated entries of the ARP table */
 
 static struct arp_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
 
+/* The entries in use, hashed by IP address */
+
+static DECLARE_HASHTABLE(g_arphash, CONFIG_NET_ARPTAB_HASH_BITS);
+
+/* The entries in use from the least to the most recently used, and the
+ * entries that are free again.
+ */
+
+static dq_queue_t g_arplru;
+static dq_queue_t g_arpfree;
+
+/* The number of entries taken from g_arptable or allocated from the heap */
+
+static unsigned int g_arpsize;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -140,32 +161,177 @@ static int arp_match(FAR struct net_driver_s *dev, FAR void *arg)
 }
 
 /****************************************************************************
- * Name: arp_return_old_entry
+ * Name: arp_expired
  *
  * Description:
- *   Compare and return the old ARP table entry.
+ *   Return true if the ARP table entry is too old to be used.
  *
  ****************************************************************************/
 
-static FAR struct arp_entry_s *
-arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
+static bool arp_expired(FAR struct arp_entry_s *tabptr, clock_t now)
 {
-  if (e1->at_ipaddr == 0)
+#ifdef NET_ARP_HAVE_NEGATIVE
+  if (tabptr->at_negative)
     {
-      return e1;
+      return now - tabptr->at_time > ARP_NEGATIVE_TICK;
     }
-  else if (e2->at_ipaddr == 0)
+#endif
+
+  return now - tabptr->at_time > ARP_MAXAGE_TICK;
+}
+
+/****************************************************************************
+ * Name: arp_search
+ *
+ * Description:
+ *   Find the ARP table entry of this IP address and device, whether it has
+ *   expired or not.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_entry_s *arp_search(in_addr_t ipaddr,
+                                          FAR struct net_driver_s *dev)
+{
+  FAR struct arp_entry_s *tabptr;
+  FAR hash_node_t *node;
+
+  hashtable_for_every_possible(g_arphash, node, ipaddr)
     {
-      return e2;
+      tabptr = container_of(node, struct arp_entry_s, at_hash);
+      if (tabptr->at_dev == dev &&
+          net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr))
+        {
+          return tabptr;
+        }
     }
-  else if ((int)(e1->at_time - e2->at_time) <= 0)
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: arp_free
+ *
+ * Description:
+ *   Remove an entry from the ARP table and keep it for reuse.
+ *
+ ****************************************************************************/
+
+static void arp_free(FAR struct arp_entry_s *tabptr)
+{
+  hashtable_delete(g_arphash, &tabptr->at_hash, tabptr->at_ipaddr);
+  dq_rem(&tabptr->at_lru, &g_arplru);
+  dq_addlast(&tabptr->at_lru, &g_arpfree);
+}
+
+/****************************************************************************
+ * Name: arp_alloc
+ *
+ * Description:
+ *   Return an unused ARP table entry.  If the table is full, the least
+ *   recently used entry is removed from it and returned.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_entry_s *arp_alloc(void)
+{
+  FAR struct arp_entry_s *tabptr;
+  FAR dq_entry_t *node;
+#if CONFIG_NET_ARPTAB_ALLOC > 0
+  unsigned int nalloc;
+  unsigned int i;
+#endif
+
+  /* Reuse a free entry, or take the next preallocated one */
+
+  node = dq_remfirst(&g_arpfree);
+  if (node != NULL)
+    {
+      return container_of(node, struct arp_entry_s, at_lru);
+    }
+
+  if (g_arpsize < CONFIG_NET_ARPTAB_SIZE)
     {
-      return e1;
+      return &g_arptable[g_arpsize++];
+    }
+
+#if CONFIG_NET_ARPTAB_ALLOC > 0
+  /* Grow the table by a batch of entries, but not beyond its maximum
+   * size.
+   */
+
+  if (g_arpsize < CONFIG_NET_ARPTAB_MAXSIZE)
+    {
+      nalloc = CONFIG_NET_ARPTAB_MAXSIZE - g_arpsize;
+      if (nalloc > CONFIG_NET_ARPTAB_ALLOC)
+        {
+          nalloc = CONFIG_NET_ARPTAB_ALLOC;
+        }
+
+      tabptr = kmm_zalloc(sizeof(*tabptr) * nalloc);
+      if (tabptr != NULL)
+        {
+          for (i = 1; i < nalloc; i++)
+            {
+              dq_addlast(&tabptr[i].at_lru, &g_arpfree);
+            }
+
+          g_arpsize += nalloc;
+          return tabptr;
+        }
+    }
+#endif
+
+  /* The table is full, replace the least recently used entry.  Addresses
+   * that did not answer are kept at the head of the list, so they are
+   * replaced before any valid mapping.
+   */
+
+  node = dq_peek(&g_arplru);
+  if (node == NULL)
+    {
+      return NULL;
+    }
+
+  tabptr = container_of(node, struct arp_entry_s, at_lru);
+  hashtable_delete(g_arphash, &tabptr->at_hash, tabptr->at_ipaddr);
+  dq_rem(&tabptr->at_lru, &g_arplru);
+  return tabptr;
+}
+
+/****************************************************************************
+ * Name: arp_entry
+ *
+ * Description:
+ *   Return the ARP table entry of this IP address and device, adding one
+ *   if there is none.  The entry becomes the most recently used one.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_entry_s *arp_entry(in_addr_t ipaddr,
+                                         FAR struct net_driver_s *dev)
+{
+  FAR struct arp_entry_s *tabptr;
+
+  tabptr = arp_search(ipaddr, dev);
+  if (tabptr != NULL)
+    {
+      dq_rem(&tabptr->at_lru, &g_arplru);
     }
   else
     {
-      return e2;
+      tabptr = arp_alloc();
+      if (tabptr == NULL)
+        {
+          return NULL;
+        }
+
+      tabptr->at_ipaddr = ipaddr;
+      tabptr->at_dev    = dev;
+      hashtable_add(g_arphash, &tabptr->at_hash, ipaddr);
     }
+
+  dq_addlast(&tabptr->at_lru, &g_arplru);
+  return tabptr;
 }
 
 /****************************************************************************
@@ -188,24 +354,19 @@ static FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr,
                                           FAR struct net_driver_s *dev)
 {
   FAR struct arp_entry_s *tabptr;
-  int i;
 
   /* Check if the IPv4 address is already in the ARP table. */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  tabptr = arp_search(ipaddr, dev);
+  if (tabptr != NULL && arp_expired(tabptr, clock_systime_ticks()))
     {
-      tabptr = &g_arptable[i];
-      if (tabptr->at_dev == dev &&
-          net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr) &&
-          clock_systime_ticks() - tabptr->at_time <= ARP_MAXAGE_TICK)
-        {
-          return tabptr;
-        }
-    }
+      /* Drop the expired entry */
 
-  /* Not found */
+      arp_free(tabptr);
+      tabptr = NULL;
+    }
 
-  return NULL;
+  return tabptr;
 }
 
 /****************************************************************************
@@ -236,45 +397,23 @@ static FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr,
 int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
                FAR const uint8_t *ethaddr)
 {
-  FAR struct arp_entry_s *tabptr = &g_arptable[0];
-  int i;
+  FAR struct arp_entry_s *tabptr;
 
-  /* Walk through the ARP mapping table and try to find an entry to
-   * update. If none is found, the IP -> MAC address mapping is
-   * inserted in the ARP table.
+  /* Find the entry to update.  If there is none, the IP -> MAC address
+   * mapping is inserted in a free entry or in the least recently used one.
    */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  tabptr = arp_entry(ipaddr, dev);
+  if (tabptr == NULL)
     {
-      /* Check if the source IP address of the incoming packet matches
-       * the IP address in this ARP table entry.
-       */
-
-      if (g_arptable[i].at_dev == dev &&
-          g_arptable[i].at_ipaddr != 0 &&
-          net_ipv4addr_cmp(ipaddr, g_arptable[i].at_ipaddr))
-        {
-          /* An old entry found, break. */
-
-          tabptr = &g_arptable[i];
-          break;
-        }
-      else
-        {
-          /* Record the oldest entry. */
-
-          tabptr = arp_return_old_entry(tabptr, &g_arptable[i]);
-        }
+      return -ENOMEM;
     }
 
-  /* Now, tabptr is the ARP table entry which we will fill with the new
-   * information.
-   */
-
-  tabptr->at_ipaddr = ipaddr;
   memcpy(tabptr->at_ethaddr.ether_addr_octet, ethaddr, ETHER_ADDR_LEN);
-  tabptr->at_dev = dev;
   tabptr->at_time = clock_systime_ticks();
+#ifdef NET_ARP_HAVE_NEGATIVE
+  tabptr->at_negative = false;
+#endif
   return OK;
 }
 
@@ -309,6 +448,45 @@ void arp_hdr_update(FAR struct net_driver_s *dev, FAR uint16_t *pipaddr,
   arp_update(dev, ipaddr, ethaddr);
 }
 
+/****************************************************************************
+ * Name: arp_unreachable
+ *
+ * Description:
+ *   Record that the IP address did not answer ARP requests.  arp_find()
+ *   fails with -EHOSTUNREACH for the address until the entry expires after
+ *   CONFIG_NET_ARP_NEGATIVE_TIMEOUT seconds or an ARP reply updates it.
+ *
+ * Input Parameters:
+ *   dev     - The device driver structure
+ *   ipaddr  - The IP address as an inaddr_t
+ *
+ * Assumptions
+ *   The network is locked to assure exclusive access to the ARP table
+ *
+ ****************************************************************************/
+
+#ifdef NET_ARP_HAVE_NEGATIVE
+void arp_unreachable(FAR struct net_driver_s *dev, in_addr_t ipaddr)
+{
+  FAR struct arp_entry_s *tabptr;
+
+  tabptr = arp_entry(ipaddr, dev);
+  if (tabptr != NULL)
+    {
+      memset(&tabptr->at_ethaddr, 0, sizeof(tabptr->at_ethaddr));
+      tabptr->at_time     = clock_systime_ticks();
+      tabptr->at_negative = true;
+
+      /* Make it the first entry to be replaced, so that unanswered
+       * addresses never push valid mappings out of a full table.
+       */
+
+      dq_rem(&tabptr->at_lru, &g_arplru);
+      dq_addfirst(&tabptr->at_lru, &g_arplru);
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: arp_find
  *
@@ -324,6 +502,10 @@ void arp_hdr_update(FAR struct net_driver_s *dev, FAR uint16_t *pipaddr,
  *             available.
  *   dev     - Device structure
  *
+ * Returned Value:
+ *   Zero (OK) if the address mapping is available.  -EHOSTUNREACH if the
+ *   address recently did not answer ARP requests, -ENOENT otherwise.
+ *
  * Assumptions
  *   The network is locked to assure exclusive access to the ARP table.
  *
@@ -340,7 +522,19 @@ int arp_find(in_addr_t ipaddr, FAR uint8_t *ethaddr,
   tabptr = arp_lookup(ipaddr, dev);
   if (tabptr != NULL)
     {
-      /* Yes.. return the Ethernet MAC address if the caller has provided a
+#ifdef NET_ARP_HAVE_NEGATIVE
+      if (tabptr->at_negative)
+        {
+          return -EHOSTUNREACH;
+        }
+#endif
+
+      /* This is now the most recently used entry */
+
+      dq_rem(&tabptr->at_lru, &g_arplru);
+      dq_addlast(&tabptr->at_lru, &g_arplru);
+
+      /* Return the Ethernet MAC address if the caller has provided a
        * non-NULL address in 'ethaddr'.
        */
 
@@ -398,9 +592,9 @@ int arp_delete(in_addr_t ipaddr, FAR struct net_driver_s *dev)
   tabptr = arp_lookup(ipaddr, dev);
   if (tabptr != NULL)
     {
-      /* Yes.. Set the IP address to zero to "delete" it */
+      /* Yes.. Remove it from the table */
 
-      tabptr->at_ipaddr = 0;
+      arp_free(tabptr);
       return OK;
     }
 
@@ -423,13 +617,17 @@ int arp_delete(in_addr_t ipaddr, FAR struct net_driver_s *dev)
 
 void arp_cleanup(FAR struct net_driver_s *dev)
 {
-  int i;
+  FAR struct arp_entry_s *tabptr;
+  FAR dq_entry_t *node;
+  FAR dq_entry_t *next;
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  for (node = dq_peek(&g_arplru); node != NULL; node = next)
     {
-      if (dev == g_arptable[i].at_dev)
+      next   = dq_next(node);
+      tabptr = container_of(node, struct arp_entry_s, at_lru);
+      if (tabptr->at_dev == dev)
         {
-          memset(&g_arptable[i], 0, sizeof(g_arptable[i]));
+          arp_free(tabptr);
         }
     }
 }
@@ -460,19 +658,27 @@ unsigned int arp_snapshot(FAR struct arpreq *snapshot,
 {
   FAR struct arp_entry_s *tabptr;
   FAR struct sockaddr_in *outaddr;
+  FAR dq_entry_t *node;
   clock_t now;
   unsigned int ncopied;
-  int i;
 
-  /* Copy all non-empty, non-expired entries in the ARP table. */
+  /* Copy all non-expired entries in the ARP table.  Addresses that did not
+   * answer ARP requests have no mapping to report.
+   */
 
-  for (i = 0, now = clock_systime_ticks(), ncopied = 0;
-       nentries > ncopied && i < CONFIG_NET_ARPTAB_SIZE;
-       i++)
+  for (node = dq_peek(&g_arplru), now = clock_systime_ticks(), ncopied = 0;
+       nentries > ncopied && node != NULL;
+       node = dq_next(node))
     {
-      tabptr = &g_arptable[i];
-      if (tabptr->at_ipaddr != 0 &&
-          now - tabptr->at_time <= ARP_MAXAGE_TICK)
+      tabptr = container_of(node, struct arp_entry_s, at_lru);
+#ifdef NET_ARP_HAVE_NEGATIVE
+      if (tabptr->at_negative)
+        {
+          continue;
+        }
+#endif
+
+      if (!arp_expired(tabptr, now))
         {
           outaddr = (FAR struct sockaddr_in *)&snapshot[ncopied].arp_pa;
           outaddr->sin_family      = AF_INET;
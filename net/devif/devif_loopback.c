@@ -103,6 +103,12 @@ int devif_loopback(FAR struct net_driver_s *dev)
        NETDEV_TXPACKETS(dev);
        NETDEV_RXPACKETS(dev);
 
+      /* The packet does not reach the device, so a checksum left to the
+       * device must be completed here or the input path drops the packet.
+       */
+
+      netdev_txcsum_complete(dev);
+
 #ifdef CONFIG_NET_PKT
       /* When packet sockets are enabled, feed the frame into the tap */
 
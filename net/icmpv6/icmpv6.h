@@ -215,7 +215,8 @@ void icmpv6_input(FAR struct net_driver_s *dev, unsigned int iplen);
  *   On error a negated errno value is returned:
  *
  *     -ETIMEDOUT:    The number or retry counts has been exceed.
- *     -EHOSTUNREACH: Could not find a route to the host
+ *     -EHOSTUNREACH: Could not find a route to the host, or the host did
+ *                    not answer recent Neighbor Solicitations
  *
  * Assumptions:
  *   This function is called from the normal tasking context.
@@ -171,7 +171,8 @@ static uint16_t icmpv6_neighbor_eventhandler(FAR struct net_driver_s *dev,
  *   returned:
  *
  *     -ETIMEDOUT:    The number or retry counts has been exceed.
- *     -EHOSTUNREACH: Could not find a route to the host
+ *     -EHOSTUNREACH: Could not find a route to the host, or the host did
+ *                    not answer recent Neighbor Solicitations
  *
  * Assumptions:
  *   This function is called from the normal tasking context.
@@ -283,12 +284,10 @@ int icmpv6_neighbor(FAR struct net_driver_s *dev,
     {
       /* Check if the address mapping is present in the Neighbor Table.  This
        * is only really meaningful on the first time through the loop.
-       *
-       * NOTE: If the Neighbor Table is large than this could be a
-       * performance issue.
        */
 
-      if (neighbor_lookup(lookup, NULL) >= 0)
+      ret = neighbor_lookup(lookup, NULL);
+      if (ret >= 0)
         {
           /* We have it!  Break out with success */
 
@@ -296,6 +295,15 @@ int icmpv6_neighbor(FAR struct net_driver_s *dev,
           break;
         }
 
+#ifdef NEIGHBOR_HAVE_NEGATIVE
+      if (ret == -EHOSTUNREACH)
+        {
+          /* The address did not answer recently, do not wait for it */
+
+          goto errout_with_callback;
+        }
+#endif
+
       /* Set up the Neighbor Advertisement wait BEFORE we send the Neighbor
        * Solicitation.
        */
@@ -343,6 +351,16 @@ int icmpv6_neighbor(FAR struct net_driver_s *dev,
       state.snd_retries++;
     }
 
+#ifdef NEIGHBOR_HAVE_NEGATIVE
+  /* Remember that none of the solicitations was answered */
+
+  if (ret == -ETIMEDOUT)
+    {
+      neighbor_unreachable(dev, lookup);
+    }
+
+errout_with_callback:
+#endif
   nxsem_destroy(&state.snd_sem);
   devif_dev_callback_free(dev, state.snd_cb);
 
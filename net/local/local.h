@@ -35,6 +35,7 @@
 #include <poll.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/mm/circbuf.h>
 #include <nuttx/queue.h>
 #include <nuttx/net/net.h>
 #include <nuttx/mutex.h>
@@ -102,6 +103,7 @@ enum local_state_s
  */
 
 struct devif_callback_s;       /* Forward reference */
+struct local_rxwait_s;         /* Forward reference */
 
 struct local_conn_s
 {
@@ -152,6 +154,22 @@ struct local_conn_s
   struct pollfd *lc_event_fds[LOCAL_NPOLLWAITERS];
   struct pollfd lc_inout_fds[2*LOCAL_NPOLLWAITERS];
 
+#ifdef CONFIG_NET_LOCAL_DIRECT
+  /* The data of a connected peer in direct mode.  The peer writes into
+   * lc_rxbuf, or directly into the buffer offered by a receiver in
+   * lc_rxwait, which then waits on a semaphore of its offer.
+   */
+
+  struct circbuf_s lc_rxbuf;   /* Data sent by the peer */
+  sem_t lc_rxsem;              /* Use to wait for data in lc_rxbuf */
+  sem_t lc_txsem;              /* Use to wait for space in the peer's buffer */
+  uint8_t lc_shutdown;         /* SHUT_RD and/or SHUT_WR */
+#ifdef CONFIG_NET_LOCAL_DIRECT_HANDOFF
+  FAR struct local_rxwait_s *lc_rxwait; /* Offer of a waiting receiver */
+  pid_t lc_rxwaiter;           /* The thread that offered lc_rxwait */
+#endif
+#endif
+
   /* Union of fields unique to SOCK_STREAM client, server, and connected
    * peers.
    */
@@ -684,6 +702,124 @@ int local_pollteardown(FAR struct socket *psock, FAR struct pollfd *fds);
 
 int32_t local_generate_instance_id(void);
 
+/****************************************************************************
+ * Name: local_direct_setup
+ *
+ * Description:
+ *   Allocate the receive buffer of a SOCK_STREAM connection in direct mode.
+ *   This is done before the connection is established.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_DIRECT
+int local_direct_setup(FAR struct local_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: local_direct_disconnect
+ *
+ * Description:
+ *   Break the connection between conn and its peer, waking up any thread
+ *   of the peer waiting to send or receive.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_DIRECT
+void local_direct_disconnect(FAR struct local_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: local_direct_send
+ *
+ * Description:
+ *   Send data on a connected SOCK_STREAM socket in direct mode.
+ *
+ * Input Parameters:
+ *   psock    An instance of the internal socket structure.
+ *   buf      Data to send
+ *   len      Length of data to send
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes sent.  On error, a negated
+ *   errno value is returned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_DIRECT
+ssize_t local_direct_send(FAR struct socket *psock,
+                          FAR const struct iovec *buf,
+                          size_t len, int flags);
+#endif
+
+/****************************************************************************
+ * Name: local_direct_recv
+ *
+ * Description:
+ *   Receive data on a connected SOCK_STREAM socket in direct mode.
+ *
+ * Input Parameters:
+ *   psock   - An instance of the internal socket structure.
+ *   buf     - Local to store the received data
+ *   readlen - Length of data to receive [in]
+ *             Length of data actually received [out]
+ *   flags   - Receive flags
+ *
+ * Returned Value:
+ *   Zero is returned on success; a negated errno value is returned on any
+ *   failure.  A returned readlen of zero means that the peer has closed
+ *   the connection or shut down its sending side.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_DIRECT
+int local_direct_recv(FAR struct socket *psock, FAR void *buf,
+                      FAR size_t *readlen, int flags);
+#endif
+
+/****************************************************************************
+ * Name: local_direct_shutdown
+ *
+ * Description:
+ *   Disable further receive and/or send operations on a SOCK_STREAM socket
+ *   in direct mode.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_DIRECT
+void local_direct_shutdown(FAR struct local_conn_s *conn, int how);
+#endif
+
+/****************************************************************************
+ * Name: local_direct_pollstate
+ *
+ * Description:
+ *   Return the poll events that are currently set for a SOCK_STREAM socket
+ *   in direct mode.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_DIRECT
+pollevent_t local_direct_pollstate(FAR struct local_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: local_direct_ioctl
+ *
+ * Description:
+ *   Handle the buffer related ioctl commands of a SOCK_STREAM socket in
+ *   direct mode.  -ENOTTY is returned for any other command.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_DIRECT
+int local_direct_ioctl(FAR struct local_conn_s *conn, int cmd,
+                       unsigned long arg);
+#endif
+
 /****************************************************************************
  * Name: local_set_pollthreshold
  *
@@ -103,7 +103,9 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
   FAR struct local_conn_s *client;
   FAR struct local_conn_s *conn;
   FAR dq_entry_t *waiter;
+#ifndef CONFIG_NET_LOCAL_DIRECT
   bool nonblock = !!(flags & SOCK_NONBLOCK);
+#endif
   int ret;
 
   /* Some sanity checks */
@@ -177,6 +179,16 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
               strlcpy(conn->lc_path, client->lc_path, sizeof(conn->lc_path));
               conn->lc_instance_id = client->lc_instance_id;
 
+#ifdef CONFIG_NET_LOCAL_DIRECT
+              /* Allocate the buffer that the client sends to */
+
+              ret = local_direct_setup(conn);
+              if (ret < 0)
+                {
+                  nerr("ERROR: Failed to allocate buffer for %s: %d\n",
+                       conn->lc_path, ret);
+                }
+#else
               /* Open the server-side write-only FIFO.  This should not
                * block.
                */
@@ -187,8 +199,10 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
                   nerr("ERROR: Failed to open write-only FIFOs for %s: %d\n",
                      conn->lc_path, ret);
                 }
+#endif
             }
 
+#ifndef CONFIG_NET_LOCAL_DIRECT
           /* Do we have a connection?  Is the write-side FIFO opened? */
 
           if (ret == OK)
@@ -207,12 +221,15 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
                         conn->lc_path, ret);
                 }
             }
+#endif
 
           /* Do we have a connection?  Are the FIFOs opened? */
 
           if (ret == OK)
             {
+#ifndef CONFIG_NET_LOCAL_DIRECT
               DEBUGASSERT(conn->lc_infile.f_inode != NULL);
+#endif
 
               /* Return the address family */
 
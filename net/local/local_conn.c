@@ -121,6 +121,10 @@ FAR struct local_conn_s *local_alloc(void)
 #ifdef CONFIG_NET_LOCAL_STREAM
       nxsem_init(&conn->lc_waitsem, 0, 0);
       nxsem_init(&conn->lc_donesem, 0, 0);
+#ifdef CONFIG_NET_LOCAL_DIRECT
+      nxsem_init(&conn->lc_rxsem, 0, 0);
+      nxsem_init(&conn->lc_txsem, 0, 0);
+#endif
 
 #endif
 
@@ -169,6 +173,10 @@ void local_free(FAR struct local_conn_s *conn)
   net_lock();
   dq_rem(&conn->lc_conn.node, &g_local_connections);
 
+#ifdef CONFIG_NET_LOCAL_DIRECT
+  local_direct_disconnect(conn);
+#endif
+
   if (local_peerconn(conn) && conn->lc_peer)
     {
       conn->lc_peer->lc_peer = NULL;
@@ -207,14 +215,28 @@ void local_free(FAR struct local_conn_s *conn)
     }
 #endif /* CONFIG_NET_LOCAL_SCM */
 
-  /* Destroy all FIFOs associted with the connection */
+  /* Destroy all FIFOs associted with the connection.  There are none for
+   * a stream socket in direct mode.
+   */
+
+#ifdef CONFIG_NET_LOCAL_DIRECT
+  if (conn->lc_proto != SOCK_STREAM)
+#endif
+    {
+      local_release_fifos(conn);
+    }
 
-  local_release_fifos(conn);
 #ifdef CONFIG_NET_LOCAL_STREAM
   nxsem_destroy(&conn->lc_waitsem);
   nxsem_destroy(&conn->lc_donesem);
 #endif
 
+#ifdef CONFIG_NET_LOCAL_DIRECT
+  circbuf_uninit(&conn->lc_rxbuf);
+  nxsem_destroy(&conn->lc_rxsem);
+  nxsem_destroy(&conn->lc_txsem);
+#endif
+
   /* Destory sem associated with the connection */
 
   nxmutex_destroy(&conn->lc_sendlock);
@@ -86,11 +86,25 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
       return -ECONNREFUSED;
     }
 
+#ifdef CONFIG_NET_LOCAL_DIRECT
+  /* Allocate the buffer that the server side of the connection sends to */
+
+  ret = local_direct_setup(client);
+  if (ret < 0)
+    {
+      nerr("ERROR: Failed to allocate buffer for %s: %d\n",
+           client->lc_path, ret);
+
+      return ret;
+    }
+#endif
+
   /* Increment the number of pending server connection s */
 
   server->u.server.lc_pending++;
   DEBUGASSERT(server->u.server.lc_pending != 0);
 
+#ifndef CONFIG_NET_LOCAL_DIRECT
   /* Create the FIFOs needed for the connection */
 
   ret = local_create_fifos(client);
@@ -116,6 +130,7 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
     }
 
   DEBUGASSERT(client->lc_outfile.f_inode != NULL);
+#endif
 
   /* Set the busy "result" before giving the semaphore. */
 
@@ -152,6 +167,7 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
         }
     }
 
+#ifndef CONFIG_NET_LOCAL_DIRECT
   /* Yes.. open the read-only FIFO */
 
   ret = local_open_client_rx(client, nonblock);
@@ -163,6 +179,7 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
     }
 
   DEBUGASSERT(client->lc_infile.f_inode != NULL);
+#endif
 
   nxsem_post(&client->lc_donesem);
 
@@ -176,11 +193,13 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
   return -EINPROGRESS;
 
 errout_with_outfd:
+#ifndef CONFIG_NET_LOCAL_DIRECT
   file_close(&client->lc_outfile);
   client->lc_outfile.f_inode = NULL;
 
 errout_with_fifos:
   local_release_fifos(client);
+#endif
   client->lc_state = LOCAL_STATE_BOUND;
   return ret;
 }
@@ -0,0 +1,690 @@
+/****************************************************************************
+ * net/local/local_direct.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/mm/circbuf.h>
+#include <nuttx/net/net.h>
+#include <nuttx/sched.h>
+#include <nuttx/semaphore.h>
+
+#include "socket/socket.h"
+#include "local/local.h"
+
+#ifdef CONFIG_NET_LOCAL_DIRECT
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_DIRECT_HANDOFF
+/* The buffer that a blocked receiver offers to the sender.  The receiver
+ * waits on rw_sem rather than lc_rxsem, so that the data handed off wakes
+ * this receiver and not another one receiving on the same socket.
+ */
+
+struct local_rxwait_s
+{
+  struct iovec rw_iov;         /* Remaining buffer of the receiver */
+  sem_t rw_sem;                /* Use to wait for data in the buffer */
+};
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_direct_post
+ *
+ * Description:
+ *   Wake up a thread waiting on sem, without counting more than one post.
+ *
+ ****************************************************************************/
+
+static void local_direct_post(FAR sem_t *sem)
+{
+  int sval;
+
+  if (nxsem_get_value(sem, &sval) >= 0 && sval < 1)
+    {
+      nxsem_post(sem);
+    }
+}
+
+/****************************************************************************
+ * Name: local_direct_notify
+ *
+ * Description:
+ *   Wake up a thread of conn waiting on sem and any poll waiters of conn.
+ *
+ ****************************************************************************/
+
+static void local_direct_notify(FAR struct local_conn_s *conn,
+                                FAR sem_t *sem, pollevent_t eventset)
+{
+  local_direct_post(sem);
+  local_event_pollnotify(conn, eventset);
+}
+
+/****************************************************************************
+ * Name: local_rxwait_valid
+ *
+ * Description:
+ *   Check that the receiver that offered lc_rxwait is still blocked on
+ *   the semaphore of its offer.  A receiver that was killed while waiting
+ *   never clears lc_rxwait, which then points into its released stack, so
+ *   a stale offer is dropped here.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_DIRECT_HANDOFF
+static bool local_rxwait_valid(FAR struct local_conn_s *conn)
+{
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  bool valid;
+
+  if (conn->lc_rxwait == NULL)
+    {
+      return false;
+    }
+
+  flags = enter_critical_section();
+  tcb   = nxsched_get_tcb(conn->lc_rxwaiter);
+  valid = tcb != NULL && tcb->waitobj == &conn->lc_rxwait->rw_sem;
+  leave_critical_section(flags);
+
+  if (!valid)
+    {
+      conn->lc_rxwait = NULL;
+    }
+
+  return valid;
+}
+#endif
+
+/****************************************************************************
+ * Name: local_direct_rxnotify
+ *
+ * Description:
+ *   Wake up the threads of conn waiting to receive: the receiver that
+ *   offered its buffer, one receiver waiting on lc_rxsem and any poll
+ *   waiters.
+ *
+ ****************************************************************************/
+
+static void local_direct_rxnotify(FAR struct local_conn_s *conn,
+                                  pollevent_t eventset)
+{
+#ifdef CONFIG_NET_LOCAL_DIRECT_HANDOFF
+  if (local_rxwait_valid(conn))
+    {
+      local_direct_post(&conn->lc_rxwait->rw_sem);
+    }
+#endif
+
+  local_direct_notify(conn, &conn->lc_rxsem, eventset);
+}
+
+/****************************************************************************
+ * Name: local_direct_write
+ *
+ * Description:
+ *   Pass as much of the data as possible to the peer without waiting.
+ *
+ * Returned Value:
+ *   The number of bytes passed to the peer.
+ *
+ ****************************************************************************/
+
+static size_t local_direct_write(FAR struct local_conn_s *peer,
+                                 FAR const uint8_t *data, size_t len)
+{
+  size_t nwritten = 0;
+  ssize_t ret;
+
+#ifdef CONFIG_NET_LOCAL_DIRECT_HANDOFF
+  FAR struct local_rxwait_s *rxwait = peer->lc_rxwait;
+
+  /* If the receiver is waiting for data and nothing is buffered ahead of
+   * this data, copy it straight into the buffer of the receiver.
+   */
+
+  if (rxwait != NULL && rxwait->rw_iov.iov_len > 0 &&
+      circbuf_is_empty(&peer->lc_rxbuf) && local_rxwait_valid(peer))
+    {
+      nwritten = len < rxwait->rw_iov.iov_len ? len :
+                                                rxwait->rw_iov.iov_len;
+      memcpy(rxwait->rw_iov.iov_base, data, nwritten);
+
+      rxwait->rw_iov.iov_base  = (FAR uint8_t *)rxwait->rw_iov.iov_base +
+                                 nwritten;
+      rxwait->rw_iov.iov_len  -= nwritten;
+    }
+#endif
+
+  if (nwritten < len)
+    {
+      ret = circbuf_write(&peer->lc_rxbuf, data + nwritten, len - nwritten);
+      if (ret > 0)
+        {
+          nwritten += ret;
+        }
+    }
+
+  if (nwritten > 0)
+    {
+      local_direct_rxnotify(peer, POLLIN);
+    }
+
+  return nwritten;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_direct_setup
+ *
+ * Description:
+ *   Allocate the receive buffer of a SOCK_STREAM connection in direct mode.
+ *   This is done before the connection is established.
+ *
+ ****************************************************************************/
+
+int local_direct_setup(FAR struct local_conn_s *conn)
+{
+  conn->lc_shutdown = 0;
+
+  /* The buffer is kept when a failed connect() is retried */
+
+  if (circbuf_is_init(&conn->lc_rxbuf))
+    {
+      circbuf_reset(&conn->lc_rxbuf);
+      return OK;
+    }
+
+  return circbuf_init(&conn->lc_rxbuf, NULL,
+                      CONFIG_NET_LOCAL_DIRECT_BUFSIZE);
+}
+
+/****************************************************************************
+ * Name: local_direct_disconnect
+ *
+ * Description:
+ *   Break the connection between conn and its peer, waking up any thread
+ *   of the peer waiting to send or receive.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+void local_direct_disconnect(FAR struct local_conn_s *conn)
+{
+  FAR struct local_conn_s *peer = conn->lc_peer;
+
+  if (peer != NULL)
+    {
+      peer->lc_peer = NULL;
+      conn->lc_peer = NULL;
+
+      /* The peer now reads the end of file after the buffered data and
+       * fails to send with EPIPE.
+       */
+
+      local_direct_rxnotify(peer, POLLIN | POLLHUP);
+      local_direct_notify(peer, &peer->lc_txsem, POLLOUT);
+    }
+}
+
+/****************************************************************************
+ * Name: local_direct_send
+ *
+ * Description:
+ *   Send data on a connected SOCK_STREAM socket in direct mode.
+ *
+ * Input Parameters:
+ *   psock    An instance of the internal socket structure.
+ *   buf      Data to send
+ *   len      Length of data to send
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes sent.  On error, a negated
+ *   errno value is returned.
+ *
+ ****************************************************************************/
+
+ssize_t local_direct_send(FAR struct socket *psock,
+                          FAR const struct iovec *buf,
+                          size_t len, int flags)
+{
+  FAR struct local_conn_s *conn = psock->s_conn;
+  FAR const struct iovec *end = buf + len;
+  FAR const struct iovec *iov;
+  FAR struct local_conn_s *peer;
+  FAR const uint8_t *data;
+  size_t remaining;
+  size_t nwritten;
+  ssize_t nsent = 0;
+  bool nonblock;
+  int ret = OK;
+
+  if (conn->lc_state != LOCAL_STATE_CONNECTED)
+    {
+      if (conn->lc_state == LOCAL_STATE_CONNECTING)
+        {
+          return -EAGAIN;
+        }
+
+      nerr("ERROR: not connected\n");
+      return -ENOTCONN;
+    }
+
+  nonblock = _SS_ISNONBLOCK(conn->lc_conn.s_flags) ||
+             (flags & MSG_DONTWAIT) != 0;
+
+  /* Keep the data of concurrent senders from being interleaved */
+
+  ret = nxmutex_lock(&conn->lc_sendlock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  net_lock();
+
+  for (iov = buf; iov != end && ret >= 0; iov++)
+    {
+      data      = iov->iov_base;
+      remaining = iov->iov_len;
+
+      while (remaining > 0)
+        {
+          peer = conn->lc_peer;
+          if ((conn->lc_shutdown & SHUT_WR) != 0)
+            {
+              ret = -ENOTCONN;
+              break;
+            }
+          else if (peer == NULL || (peer->lc_shutdown & SHUT_RD) != 0)
+            {
+              ret = -EPIPE;
+              break;
+            }
+
+          nwritten = local_direct_write(peer, data, remaining);
+          if (nwritten > 0)
+            {
+              data      += nwritten;
+              remaining -= nwritten;
+              nsent     += nwritten;
+              continue;
+            }
+
+          /* The buffer of the peer is full */
+
+          if (nonblock)
+            {
+              ret = -EAGAIN;
+              break;
+            }
+
+          ret = net_sem_timedwait(&conn->lc_txsem,
+                                  _SO_TIMEOUT(conn->lc_conn.s_sndtimeo));
+          if (ret < 0)
+            {
+              if (ret == -ETIMEDOUT)
+                {
+                  ret = -EAGAIN;
+                }
+
+              break;
+            }
+        }
+    }
+
+  net_unlock();
+  nxmutex_unlock(&conn->lc_sendlock);
+
+  return nsent > 0 ? nsent : ret;
+}
+
+/****************************************************************************
+ * Name: local_direct_recv
+ *
+ * Description:
+ *   Receive data on a connected SOCK_STREAM socket in direct mode.
+ *
+ * Input Parameters:
+ *   psock   - An instance of the internal socket structure.
+ *   buf     - Local to store the received data
+ *   readlen - Length of data to receive [in]
+ *             Length of data actually received [out]
+ *   flags   - Receive flags
+ *
+ * Returned Value:
+ *   Zero is returned on success; a negated errno value is returned on any
+ *   failure.  A returned readlen of zero means that the peer has closed
+ *   the connection or shut down its sending side.
+ *
+ ****************************************************************************/
+
+int local_direct_recv(FAR struct socket *psock, FAR void *buf,
+                      FAR size_t *readlen, int flags)
+{
+  FAR struct local_conn_s *conn = psock->s_conn;
+  FAR struct local_conn_s *peer;
+#ifdef CONFIG_NET_LOCAL_DIRECT_HANDOFF
+  struct local_rxwait_s rxwait;
+#endif
+  FAR sem_t *sem;
+  size_t len = *readlen;
+  bool nonblock;
+  ssize_t ret;
+
+  *readlen = 0;
+
+  if (conn->lc_state != LOCAL_STATE_CONNECTED)
+    {
+      if (conn->lc_state == LOCAL_STATE_CONNECTING)
+        {
+          return -EAGAIN;
+        }
+
+      nerr("ERROR: not connected\n");
+      return -ENOTCONN;
+    }
+
+  nonblock = _SS_ISNONBLOCK(conn->lc_conn.s_flags) ||
+             (flags & MSG_DONTWAIT) != 0;
+
+  net_lock();
+
+  for (; ; )
+    {
+      if ((conn->lc_shutdown & SHUT_RD) != 0)
+        {
+          ret = -ENOTCONN;
+          break;
+        }
+
+      if (!circbuf_is_empty(&conn->lc_rxbuf))
+        {
+          if ((flags & MSG_PEEK) != 0)
+            {
+              ret = circbuf_peek(&conn->lc_rxbuf, buf, len);
+            }
+          else
+            {
+              ret = circbuf_read(&conn->lc_rxbuf, buf, len);
+
+              /* Let another receiver take the rest of the data */
+
+              if (!circbuf_is_empty(&conn->lc_rxbuf))
+                {
+                  local_direct_post(&conn->lc_rxsem);
+                }
+
+              /* Let the peer send more */
+
+              peer = conn->lc_peer;
+              if (ret > 0 && peer != NULL)
+                {
+                  local_direct_notify(peer, &peer->lc_txsem, POLLOUT);
+                }
+            }
+
+          break;
+        }
+
+      /* Nothing is buffered.  Return the end of file if no more data will
+       * be sent.
+       */
+
+      peer = conn->lc_peer;
+      if (peer == NULL || (peer->lc_shutdown & SHUT_WR) != 0 || len == 0)
+        {
+          ret = 0;
+          break;
+        }
+
+      if (nonblock)
+        {
+          ret = -EAGAIN;
+          break;
+        }
+
+      sem = &conn->lc_rxsem;
+
+#ifdef CONFIG_NET_LOCAL_DIRECT_HANDOFF
+      /* Offer the buffer of the caller to the sender, unless another
+       * receiver already did.
+       */
+
+      rxwait.rw_iov.iov_base = buf;
+      rxwait.rw_iov.iov_len  = len;
+
+      if ((flags & MSG_PEEK) == 0 && !local_rxwait_valid(conn))
+        {
+          nxsem_init(&rxwait.rw_sem, 0, 0);
+          conn->lc_rxwait   = &rxwait;
+          conn->lc_rxwaiter = nxsched_gettid();
+          sem               = &rxwait.rw_sem;
+        }
+#endif
+
+      ret = net_sem_timedwait(sem, _SO_TIMEOUT(conn->lc_conn.s_rcvtimeo));
+
+#ifdef CONFIG_NET_LOCAL_DIRECT_HANDOFF
+      if (sem == &rxwait.rw_sem)
+        {
+          if (conn->lc_rxwait == &rxwait)
+            {
+              conn->lc_rxwait = NULL;
+            }
+
+          nxsem_destroy(&rxwait.rw_sem);
+        }
+
+      /* Return the data that was handed off, even if the wait failed */
+
+      if (rxwait.rw_iov.iov_len < len)
+        {
+          ret = len - rxwait.rw_iov.iov_len;
+          break;
+        }
+#endif
+
+      if (ret < 0)
+        {
+          if (ret == -ETIMEDOUT)
+            {
+              ret = -EAGAIN;
+            }
+
+          break;
+        }
+    }
+
+  net_unlock();
+
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  *readlen = ret;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: local_direct_shutdown
+ *
+ * Description:
+ *   Disable further receive and/or send operations on a SOCK_STREAM socket
+ *   in direct mode.
+ *
+ ****************************************************************************/
+
+void local_direct_shutdown(FAR struct local_conn_s *conn, int how)
+{
+  FAR struct local_conn_s *peer;
+
+  net_lock();
+
+  conn->lc_shutdown |= how & SHUT_RDWR;
+  peer = conn->lc_peer;
+
+  if ((how & SHUT_RD) != 0)
+    {
+      /* Discard the buffered data and fail any further send of the peer */
+
+      circbuf_reset(&conn->lc_rxbuf);
+      local_direct_rxnotify(conn, POLLIN);
+
+      if (peer != NULL)
+        {
+          local_direct_notify(peer, &peer->lc_txsem, POLLOUT);
+        }
+    }
+
+  if ((how & SHUT_WR) != 0)
+    {
+      /* The peer reads the end of file after the buffered data */
+
+      local_direct_notify(conn, &conn->lc_txsem, POLLOUT);
+
+      if (peer != NULL)
+        {
+          local_direct_rxnotify(peer, POLLIN);
+        }
+    }
+
+  net_unlock();
+}
+
+/****************************************************************************
+ * Name: local_direct_pollstate
+ *
+ * Description:
+ *   Return the poll events that are currently set for a SOCK_STREAM socket
+ *   in direct mode.
+ *
+ ****************************************************************************/
+
+pollevent_t local_direct_pollstate(FAR struct local_conn_s *conn)
+{
+  FAR struct local_conn_s *peer;
+  pollevent_t eventset = 0;
+
+  net_lock();
+
+  peer = conn->lc_peer;
+  if (!circbuf_is_empty(&conn->lc_rxbuf) ||
+      (peer != NULL && (peer->lc_shutdown & SHUT_WR) != 0))
+    {
+      eventset |= POLLIN;
+    }
+
+  if (peer == NULL)
+    {
+      eventset |= POLLIN | POLLHUP;
+    }
+  else if (circbuf_space(&peer->lc_rxbuf) > 0 ||
+           (peer->lc_shutdown & SHUT_RD) != 0)
+    {
+      /* A send would not block, even if only to fail with EPIPE */
+
+      eventset |= POLLOUT;
+    }
+
+  net_unlock();
+  return eventset;
+}
+
+/****************************************************************************
+ * Name: local_direct_ioctl
+ *
+ * Description:
+ *   Handle the buffer related ioctl commands of a SOCK_STREAM socket in
+ *   direct mode.  -ENOTTY is returned for any other command.
+ *
+ ****************************************************************************/
+
+int local_direct_ioctl(FAR struct local_conn_s *conn, int cmd,
+                       unsigned long arg)
+{
+  FAR struct local_conn_s *peer;
+  FAR int *value = (FAR int *)(uintptr_t)arg;
+  int ret = OK;
+
+  if (cmd != FIONREAD && cmd != FIONWRITE && cmd != FIONSPACE)
+    {
+      return -ENOTTY;
+    }
+
+  if (conn->lc_state != LOCAL_STATE_CONNECTED)
+    {
+      return -ENOTCONN;
+    }
+
+  net_lock();
+
+  peer = conn->lc_peer;
+  if (cmd == FIONREAD)
+    {
+      *value = circbuf_used(&conn->lc_rxbuf);
+    }
+  else if (peer == NULL)
+    {
+      ret = -ENOTCONN;
+    }
+  else if (cmd == FIONWRITE)
+    {
+      /* The data sent but not yet received by the peer */
+
+      *value = circbuf_used(&peer->lc_rxbuf);
+    }
+  else
+    {
+      *value = circbuf_space(&peer->lc_rxbuf);
+    }
+
+  net_unlock();
+  return ret;
+}
+
+#endif /* CONFIG_NET_LOCAL_DIRECT */
@@ -86,6 +86,13 @@ static int local_event_pollsetup(FAR struct local_conn_s *conn,
         {
           eventset |= POLLIN;
         }
+#ifdef CONFIG_NET_LOCAL_DIRECT
+      else if (conn->lc_state != LOCAL_STATE_LISTENING &&
+               conn->lc_state != LOCAL_STATE_CONNECTING)
+        {
+          eventset |= local_direct_pollstate(conn);
+        }
+#endif
 
       local_event_pollnotify(conn, eventset);
     }
@@ -115,12 +122,14 @@ static int local_event_pollsetup(FAR struct local_conn_s *conn,
  * Name: local_inout_poll_cb
  ****************************************************************************/
 
+#ifndef CONFIG_NET_LOCAL_DIRECT
 static void local_inout_poll_cb(FAR struct pollfd *fds)
 {
   FAR struct pollfd *originfds = fds->arg;
 
   poll_notify(&originfds, 1, fds->revents);
 }
+#endif
 
 #endif
 
@@ -183,6 +192,11 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
       goto pollerr;
     }
 
+#ifdef CONFIG_NET_LOCAL_DIRECT
+  /* In direct mode all events are reported through the event list */
+
+  ret = local_event_pollsetup(conn, fds, true);
+#else
   switch (fds->events & (POLLIN | POLLOUT))
     {
       case (POLLIN | POLLOUT):
@@ -284,6 +298,7 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
         ret = OK;
         break;
     }
+#endif
 #endif
 
   return ret;
@@ -335,6 +350,9 @@ int local_pollteardown(FAR struct socket *psock, FAR struct pollfd *fds)
       return OK;
     }
 
+#ifdef CONFIG_NET_LOCAL_DIRECT
+  ret = local_event_pollsetup(conn, fds, false);
+#else
   switch (fds->events & (POLLIN | POLLOUT))
     {
       case (POLLIN | POLLOUT):
@@ -387,6 +405,7 @@ int local_pollteardown(FAR struct socket *psock, FAR struct pollfd *fds)
       default:
         break;
     }
+#endif
 #endif
 
   return ret;
@@ -55,6 +55,7 @@
  *
  ****************************************************************************/
 
+#if !defined(CONFIG_NET_LOCAL_DIRECT) || defined(CONFIG_NET_LOCAL_DGRAM)
 static int psock_fifo_read(FAR struct socket *psock, FAR void *buf,
                            FAR size_t *readlen, int flags, bool once)
 {
@@ -123,6 +124,7 @@ static int psock_fifo_read(FAR struct socket *psock, FAR void *buf,
 
   return OK;
 }
+#endif
 
 /****************************************************************************
  * Name: local_recvctl
@@ -233,6 +235,11 @@ psock_stream_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
   size_t readlen = len;
   int ret;
 
+#ifdef CONFIG_NET_LOCAL_DIRECT
+  /* Read from the buffer that the peer sends to */
+
+  ret = local_direct_recv(psock, buf, &readlen, flags);
+#else
   /* Verify that this is a connected peer socket */
 
   if (conn->lc_state != LOCAL_STATE_CONNECTED ||
@@ -269,6 +276,8 @@ psock_stream_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
   /* Read the packet */
 
   ret = psock_fifo_read(psock, buf, &readlen, flags, true);
+#endif
+
   if (ret < 0)
     {
       return ret;
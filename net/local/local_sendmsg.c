@@ -166,6 +166,15 @@ static ssize_t local_send(FAR struct socket *psock,
 {
   ssize_t ret;
 
+#ifdef CONFIG_NET_LOCAL_DIRECT
+  /* Connected stream sockets do not use the FIFOs in direct mode */
+
+  if (psock->s_type == SOCK_STREAM)
+    {
+      return local_direct_send(psock, buf, len, flags);
+    }
+#endif
+
   switch (psock->s_type)
     {
 #ifdef CONFIG_NET_LOCAL_STREAM
@@ -802,6 +802,19 @@ static int local_ioctl(FAR struct socket *psock, int cmd, unsigned long arg)
 
   conn = psock->s_conn;
 
+#ifdef CONFIG_NET_LOCAL_DIRECT
+  if (conn->lc_proto == SOCK_STREAM)
+    {
+      ret = local_direct_ioctl(conn, cmd, arg);
+      if (ret != -ENOTTY)
+        {
+          return ret;
+        }
+
+      ret = OK;
+    }
+#endif
+
   switch (cmd)
     {
       case FIONBIO:
@@ -907,6 +920,28 @@ static int local_socketpair(FAR struct socket *psocks[2])
                            = -1;
 #endif
 
+#ifdef CONFIG_NET_LOCAL_DIRECT
+  /* Connect stream sockets through their buffers */
+
+  if (psocks[0]->s_type == SOCK_STREAM)
+    {
+      for (i = 0; i < 2; i++)
+        {
+          ret = local_direct_setup(conns[i]);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+
+      conns[0]->lc_peer  = conns[1];
+      conns[1]->lc_peer  = conns[0];
+      conns[0]->lc_state = conns[1]->lc_state
+                         = LOCAL_STATE_CONNECTED;
+      return OK;
+    }
+#endif
+
   /* Create the FIFOs needed for the connection */
 
   ret = local_create_fifos(conns[0]);
@@ -1000,6 +1035,9 @@ static int local_shutdown(FAR struct socket *psock, int how)
       case SOCK_STREAM:
         {
           FAR struct local_conn_s *conn = psock->s_conn;
+#ifdef CONFIG_NET_LOCAL_DIRECT
+          local_direct_shutdown(conn, how);
+#else
           if (how & SHUT_RD)
             {
               if (conn->lc_infile.f_inode != NULL)
@@ -1017,6 +1055,7 @@ static int local_shutdown(FAR struct socket *psock, int how)
                   conn->lc_outfile.f_inode = NULL;
                 }
             }
+#endif
         }
 
         return OK;
@@ -26,10 +26,12 @@
  * Included Files
  ****************************************************************************/
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <net/ethernet.h>
 
+#include <nuttx/hashtable.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/sixlowpan.h>
@@ -37,15 +39,64 @@
 
 #ifdef CONFIG_NET_IPv6
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_NET_IPv6_NCONF_ALLOC
+#  define CONFIG_NET_IPv6_NCONF_ALLOC 0
+#endif
+
+/* The largest number of entries that the Neighbor Table may hold */
+
+#if CONFIG_NET_IPv6_NCONF_ALLOC > 0
+#  define NEIGHBOR_MAXENTRIES CONFIG_NET_IPv6_NCONF_MAXENTRIES
+#else
+#  define NEIGHBOR_MAXENTRIES CONFIG_NET_IPv6_NCONF_ENTRIES
+#endif
+
+/* Remember the addresses that did not answer Neighbor Solicitations */
+
+#if defined(CONFIG_NET_ICMPv6_NEIGHBOR) && \
+    CONFIG_NET_IPv6_NCONF_NEGATIVE_TIMEOUT > 0
+#  define NEIGHBOR_HAVE_NEGATIVE 1
+#  define NEIGHBOR_NEGATIVE_TICK \
+     SEC2TICK(CONFIG_NET_IPv6_NCONF_NEGATIVE_TIMEOUT)
+#endif
+
+/* Fold an IPv6 address into the key of the hashtable */
+
+#define NEIGHBOR_HASHKEY(a) \
+  (((uint32_t)((a)[0] ^ (a)[2] ^ (a)[4] ^ (a)[6]) << 16) | \
+   (uint16_t)((a)[1] ^ (a)[3] ^ (a)[5] ^ (a)[7]))
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* A Neighbor Table entry with its links in the table */
+
+struct neighbor_node_s
+{
+  hash_node_t             nn_hash;     /* Link in the hash bucket */
+  dq_entry_t              nn_lru;      /* Link in the LRU list */
+  struct neighbor_entry_s nn_entry;    /* The entry */
+#ifdef NEIGHBOR_HAVE_NEGATIVE
+  bool                    nn_negative; /* No answer to Neighbor Solicitations */
+#endif
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
 
-/* This is the Neighbor table.  The network should be locked when accessing
- * this table.
+/* This is the Neighbor table, hashed by IPv6 address and listed from the
+ * least to the most recently used entry.  The network should be locked when
+ * accessing this table.
  */
 
-extern struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+extern DECLARE_HASHTABLE(g_neighbor_hash, CONFIG_NET_IPv6_NCONF_HASH_BITS);
+extern dq_queue_t g_neighbor_lru;
 
 /****************************************************************************
  * Public Function Prototypes
@@ -71,6 +122,25 @@ struct net_driver_s; /* Forward reference */
 
 FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr);
 
+/****************************************************************************
+ * Name: neighbor_findnode
+ *
+ * Description:
+ *   Find the node of an IPv6 address in the Neighbor Table.  Unlike
+ *   neighbor_findentry(), this also returns the node of an address that
+ *   recently did not answer Neighbor Solicitations.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address to use in the lookup;
+ *
+ * Returned Value:
+ *   The Neighbor Table node corresponding to the IPv6 address;  NULL is
+ *   returned if there is no matching node in the Neighbor Table.
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_node_s *neighbor_findnode(const net_ipv6addr_t ipaddr);
+
 /****************************************************************************
  * Name: neighbor_add
  *
@@ -91,6 +161,29 @@ FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr);
 void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
                   FAR uint8_t *addr);
 
+/****************************************************************************
+ * Name: neighbor_unreachable
+ *
+ * Description:
+ *   Record that the IPv6 address did not answer Neighbor Solicitations.
+ *   neighbor_lookup() fails with -EHOSTUNREACH for the address until the
+ *   entry expires after CONFIG_NET_IPv6_NCONF_NEGATIVE_TIMEOUT seconds or
+ *   the address is added again.
+ *
+ * Input Parameters:
+ *   dev    - Driver instance used to query the address
+ *   ipaddr - The IPv6 address that did not answer
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef NEIGHBOR_HAVE_NEGATIVE
+void neighbor_unreachable(FAR struct net_driver_s *dev,
+                          const net_ipv6addr_t ipaddr);
+#endif
+
 /****************************************************************************
  * Name:  neighbor_lookup
  *
@@ -105,8 +198,9 @@ void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
  *            available.
  *
  * Returned Value:
- *   Zero (OK) if the link layer address is returned.  A negated errno value
- *   is returned on any error.
+ *   Zero (OK) if the link layer address is returned.  -EHOSTUNREACH if the
+ *   address recently did not answer Neighbor Solicitations, -ENOENT
+ *   otherwise.
  *
  ****************************************************************************/
 
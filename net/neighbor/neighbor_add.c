@@ -31,6 +31,7 @@
 
 #include <net/if.h>
 
+#include <nuttx/kmalloc.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/neighbor.h>
@@ -38,6 +39,144 @@
 #include "netdev/netdev.h"
 #include "neighbor/neighbor.h"
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The preallocated entries of the Neighbor Table */
+
+static struct neighbor_node_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+
+#if CONFIG_NET_IPv6_NCONF_ALLOC > 0
+/* The entries allocated from the heap that are not in use yet */
+
+static dq_queue_t g_neighbor_free;
+#endif
+
+/* The number of entries taken from g_neighbors or allocated from the heap */
+
+static unsigned int g_neighbor_size;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_alloc
+ *
+ * Description:
+ *   Return an unused Neighbor Table node.  If the table is full, the least
+ *   recently used node is removed from it and returned.
+ *
+ ****************************************************************************/
+
+static FAR struct neighbor_node_s *neighbor_alloc(void)
+{
+  FAR struct neighbor_node_s *node;
+  FAR dq_entry_t *entry;
+#if CONFIG_NET_IPv6_NCONF_ALLOC > 0
+  unsigned int nalloc;
+  unsigned int i;
+
+  entry = dq_remfirst(&g_neighbor_free);
+  if (entry != NULL)
+    {
+      return container_of(entry, struct neighbor_node_s, nn_lru);
+    }
+#endif
+
+  if (g_neighbor_size < CONFIG_NET_IPv6_NCONF_ENTRIES)
+    {
+      return &g_neighbors[g_neighbor_size++];
+    }
+
+#if CONFIG_NET_IPv6_NCONF_ALLOC > 0
+  /* Grow the table by a batch of entries, but not beyond its maximum
+   * size.
+   */
+
+  if (g_neighbor_size < CONFIG_NET_IPv6_NCONF_MAXENTRIES)
+    {
+      nalloc = CONFIG_NET_IPv6_NCONF_MAXENTRIES - g_neighbor_size;
+      if (nalloc > CONFIG_NET_IPv6_NCONF_ALLOC)
+        {
+          nalloc = CONFIG_NET_IPv6_NCONF_ALLOC;
+        }
+
+      node = kmm_zalloc(sizeof(*node) * nalloc);
+      if (node != NULL)
+        {
+          for (i = 1; i < nalloc; i++)
+            {
+              dq_addlast(&node[i].nn_lru, &g_neighbor_free);
+            }
+
+          g_neighbor_size += nalloc;
+          return node;
+        }
+    }
+#endif
+
+  /* The table is full, replace the least recently used entry.  Addresses
+   * that did not answer are kept at the head of the list, so they are
+   * replaced before any valid mapping.
+   */
+
+  entry = dq_peek(&g_neighbor_lru);
+  if (entry == NULL)
+    {
+      return NULL;
+    }
+
+  node = container_of(entry, struct neighbor_node_s, nn_lru);
+  hashtable_delete(g_neighbor_hash, &node->nn_hash,
+                   NEIGHBOR_HASHKEY(node->nn_entry.ne_ipaddr));
+  dq_rem(&node->nn_lru, &g_neighbor_lru);
+  return node;
+}
+
+/****************************************************************************
+ * Name: neighbor_node
+ *
+ * Description:
+ *   Return the Neighbor Table node of the IPv6 address on the link layer
+ *   of the device, adding one if there is none.  The node becomes the most
+ *   recently used one.
+ *
+ ****************************************************************************/
+
+static FAR struct neighbor_node_s *
+neighbor_node(FAR struct net_driver_s *dev, const net_ipv6addr_t ipaddr)
+{
+  FAR struct neighbor_node_s *node;
+  FAR hash_node_t *p;
+  uint8_t lltype = dev->d_lltype;
+
+  hashtable_for_every_possible(g_neighbor_hash, p, NEIGHBOR_HASHKEY(ipaddr))
+    {
+      node = container_of(p, struct neighbor_node_s, nn_hash);
+      if (node->nn_entry.ne_addr.na_lltype == lltype &&
+          net_ipv6addr_cmp(node->nn_entry.ne_ipaddr, ipaddr))
+        {
+          dq_rem(&node->nn_lru, &g_neighbor_lru);
+          dq_addlast(&node->nn_lru, &g_neighbor_lru);
+          return node;
+        }
+    }
+
+  node = neighbor_alloc();
+  if (node != NULL)
+    {
+      net_ipv6addr_copy(node->nn_entry.ne_ipaddr, ipaddr);
+      node->nn_entry.ne_addr.na_lltype = lltype;
+      hashtable_add(g_neighbor_hash, &node->nn_hash,
+                    NEIGHBOR_HASHKEY(ipaddr));
+      dq_addlast(&node->nn_lru, &g_neighbor_lru);
+    }
+
+  return node;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -62,53 +201,71 @@
 void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
                   FAR uint8_t *addr)
 {
-  uint8_t lltype;
-  clock_t oldest_time;
-  int     oldest_ndx;
-  int     i;
+  FAR struct neighbor_node_s *node;
 
   DEBUGASSERT(dev != NULL && addr != NULL);
 
-  /* Find the matching entry, first unused entry, or the oldest used entry.
-   * The unused entry will have ne_time == 0 and should generate the oldest
-   * time.  REVISIT:  Could this fail on clock wraparound?  A more explicit
-   * check might be to compare ne_ipaddr with the IPv6 unspecified address.
+  /* Find the matching entry, or use a free entry or the least recently
+   * used one.
    */
 
-  oldest_time = g_neighbors[0].ne_time;
-  oldest_ndx  = 0;
-  lltype      = dev->d_lltype;
-
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  node = neighbor_node(dev, ipaddr);
+  if (node == NULL)
     {
-      if (g_neighbors[i].ne_addr.na_lltype == lltype &&
-          net_ipv6addr_cmp(g_neighbors[i].ne_ipaddr, ipaddr))
-        {
-          oldest_ndx = i;
-          break;
-        }
-
-      if ((int)(g_neighbors[i].ne_time - oldest_time) < 0)
-        {
-          oldest_ndx = i;
-          oldest_time = g_neighbors[i].ne_time;
-        }
+      nerr("ERROR: No Neighbor Table entry\n");
+      return;
     }
 
-  /* Use the oldest or first free entry (either pointed to by the
-   * "oldest_ndx" variable).
-   */
+  node->nn_entry.ne_time = clock_systime_ticks();
+  node->nn_entry.ne_addr.na_llsize = netdev_lladdrsize(dev);
+  memcpy(&node->nn_entry.ne_addr.u, addr,
+         node->nn_entry.ne_addr.na_llsize);
+#ifdef NEIGHBOR_HAVE_NEGATIVE
+  node->nn_negative = false;
+#endif
 
-  g_neighbors[oldest_ndx].ne_time = clock_systime_ticks();
-  net_ipv6addr_copy(g_neighbors[oldest_ndx].ne_ipaddr, ipaddr);
+  /* Dump the contents of the new entry */
 
-  g_neighbors[oldest_ndx].ne_addr.na_lltype = lltype;
-  g_neighbors[oldest_ndx].ne_addr.na_llsize = netdev_lladdrsize(dev);
+  neighbor_dumpentry("Added entry", &node->nn_entry);
+}
 
-  memcpy(&g_neighbors[oldest_ndx].ne_addr.u, addr,
-         g_neighbors[oldest_ndx].ne_addr.na_llsize);
+/****************************************************************************
+ * Name: neighbor_unreachable
+ *
+ * Description:
+ *   Record that the IPv6 address did not answer Neighbor Solicitations.
+ *   neighbor_lookup() fails with -EHOSTUNREACH for the address until the
+ *   entry expires after CONFIG_NET_IPv6_NCONF_NEGATIVE_TIMEOUT seconds or
+ *   the address is added again.
+ *
+ * Input Parameters:
+ *   dev    - Driver instance used to query the address
+ *   ipaddr - The IPv6 address that did not answer
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
 
-  /* Dump the contents of the new entry */
+#ifdef NEIGHBOR_HAVE_NEGATIVE
+void neighbor_unreachable(FAR struct net_driver_s *dev,
+                          const net_ipv6addr_t ipaddr)
+{
+  FAR struct neighbor_node_s *node;
+
+  node = neighbor_node(dev, ipaddr);
+  if (node != NULL)
+    {
+      node->nn_entry.ne_time = clock_systime_ticks();
+      node->nn_entry.ne_addr.na_llsize = 0;
+      node->nn_negative = true;
 
-  neighbor_dumpentry("Added entry", &g_neighbors[oldest_ndx]);
+      /* Make it the first entry to be replaced, so that unanswered
+       * addresses never push valid mappings out of a full table.
+       */
+
+      dq_rem(&node->nn_lru, &g_neighbor_lru);
+      dq_addfirst(&node->nn_lru, &g_neighbor_lru);
+    }
 }
+#endif
@@ -33,6 +33,53 @@
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: neighbor_findnode
+ *
+ * Description:
+ *   Find the node of an IPv6 address in the Neighbor Table.  Unlike
+ *   neighbor_findentry(), this also returns the node of an address that
+ *   recently did not answer Neighbor Solicitations.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address to use in the lookup;
+ *
+ * Returned Value:
+ *   The Neighbor Table node corresponding to the IPv6 address;  NULL is
+ *   returned if there is no matching node in the Neighbor Table.
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_node_s *neighbor_findnode(const net_ipv6addr_t ipaddr)
+{
+  FAR struct neighbor_node_s *node;
+  FAR hash_node_t *p;
+
+  hashtable_for_every_possible(g_neighbor_hash, p, NEIGHBOR_HASHKEY(ipaddr))
+    {
+      node = container_of(p, struct neighbor_node_s, nn_hash);
+      if (!net_ipv6addr_cmp(node->nn_entry.ne_ipaddr, ipaddr))
+        {
+          continue;
+        }
+
+#ifdef NEIGHBOR_HAVE_NEGATIVE
+      /* An address that did not answer is only remembered for a while */
+
+      if (node->nn_negative &&
+          clock_systime_ticks() - node->nn_entry.ne_time >
+          NEIGHBOR_NEGATIVE_TICK)
+        {
+          continue;
+        }
+#endif
+
+      return node;
+    }
+
+  return NULL;
+}
+
 /****************************************************************************
  * Name: neighbor_findentry
  *
@@ -51,17 +98,20 @@
 
 FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr)
 {
-  int i;
+  FAR struct neighbor_node_s *node;
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  node = neighbor_findnode(ipaddr);
+#ifdef NEIGHBOR_HAVE_NEGATIVE
+  if (node != NULL && node->nn_negative)
     {
-      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
+      node = NULL;
+    }
+#endif
 
-      if (net_ipv6addr_cmp(neighbor->ne_ipaddr, ipaddr))
-        {
-          neighbor_dumpentry("Entry found", neighbor);
-          return neighbor;
-        }
+  if (node != NULL)
+    {
+      neighbor_dumpentry("Entry found", &node->nn_entry);
+      return &node->nn_entry;
     }
 
   neighbor_dumpipaddr("Not found", ipaddr);
@@ -30,11 +30,13 @@
  * Public Data
  ****************************************************************************/
 
-/* This is the Neighbor table.  The network should be locked when accessing
- * this table.
+/* This is the Neighbor table, hashed by IPv6 address and listed from the
+ * least to the most recently used entry.  The network should be locked when
+ * accessing this table.
  */
 
-struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+DECLARE_HASHTABLE(g_neighbor_hash, CONFIG_NET_IPv6_NCONF_HASH_BITS);
+dq_queue_t g_neighbor_lru;
 
 /****************************************************************************
  * Public Functions
@@ -105,29 +105,42 @@ static int neighbor_match(FAR struct net_driver_s *dev, FAR void *arg)
  *            available.
  *
  * Returned Value:
- *   Zero (OK) if the link layer address is returned.  A negated errno value
- *   is returned on any error.
+ *   Zero (OK) if the link layer address is returned.  -EHOSTUNREACH if the
+ *   address recently did not answer Neighbor Solicitations, -ENOENT
+ *   otherwise.
  *
  ****************************************************************************/
 
 int neighbor_lookup(FAR const net_ipv6addr_t ipaddr,
                     FAR struct neighbor_addr_s *laddr)
 {
-  FAR struct neighbor_entry_s *neighbor;
+  FAR struct neighbor_node_s *node;
   struct neighbor_table_info_s info;
 
   /* Check if the IPv6 address is already in the neighbor table. */
 
-  neighbor = neighbor_findentry(ipaddr);
-  if (neighbor != NULL)
+  node = neighbor_findnode(ipaddr);
+  if (node != NULL)
     {
-      /* Yes.. return the link layer address if the caller has provided a
+#ifdef NEIGHBOR_HAVE_NEGATIVE
+      if (node->nn_negative)
+        {
+          return -EHOSTUNREACH;
+        }
+#endif
+
+      /* This is now the most recently used entry */
+
+      dq_rem(&node->nn_lru, &g_neighbor_lru);
+      dq_addlast(&node->nn_lru, &g_neighbor_lru);
+
+      /* Return the link layer address if the caller has provided a
        * non-NULL address in 'laddr'.
        */
 
       if (laddr != NULL)
         {
-          memcpy(laddr, &neighbor->ne_addr, sizeof(*laddr));
+          memcpy(laddr, &node->nn_entry.ne_addr, sizeof(*laddr));
         }
 
       /* Return success in any case meaning that a valid link layer
@@ -61,28 +61,29 @@
 unsigned int neighbor_snapshot(FAR struct neighbor_entry_s *snapshot,
                                unsigned int nentries)
 {
+  FAR struct neighbor_node_s *node;
+  FAR dq_entry_t *entry;
   unsigned int ncopied;
-  int i;
 
-  /* Copy all non-empty entries in the Neighbor table. */
+  /* Copy all entries in the Neighbor table.  Addresses that did not answer
+   * Neighbor Solicitations have no link layer address to report.
+   */
 
-  for (i = 0, ncopied = 0;
-       nentries > ncopied && i < CONFIG_NET_IPv6_NCONF_ENTRIES;
-       i++)
+  for (entry = dq_peek(&g_neighbor_lru), ncopied = 0;
+       nentries > ncopied && entry != NULL;
+       entry = dq_next(entry))
     {
-      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
-
-      /* An unused entry table entry will be nullified.  In particularly,
-       * the Neighbor IP address will be all zero (i.e., the unspecified
-       * IPv6 address).
-       */
-
-      if (!net_ipv6addr_cmp(neighbor->ne_ipaddr, g_ipv6_unspecaddr))
+      node = container_of(entry, struct neighbor_node_s, nn_lru);
+#ifdef NEIGHBOR_HAVE_NEGATIVE
+      if (node->nn_negative)
         {
-          memcpy(&snapshot[ncopied], neighbor,
-                 sizeof(struct neighbor_entry_s));
-          ncopied++;
+          continue;
         }
+#endif
+
+      memcpy(&snapshot[ncopied], &node->nn_entry,
+             sizeof(struct neighbor_entry_s));
+      ncopied++;
     }
 
   /* Return the number of entries copied into the user buffer */
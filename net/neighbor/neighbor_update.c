@@ -48,11 +48,16 @@
 
 void neighbor_update(const net_ipv6addr_t ipaddr)
 {
-  struct neighbor_entry_s *neighbor;
+  FAR struct neighbor_entry_s *neighbor;
+  FAR struct neighbor_node_s *node;
 
   neighbor = neighbor_findentry(ipaddr);
   if (neighbor != NULL)
     {
       neighbor->ne_time = clock_systime_ticks();
+
+      node = container_of(neighbor, struct neighbor_node_s, nn_entry);
+      dq_rem(&node->nn_lru, &g_neighbor_lru);
+      dq_addlast(&node->nn_lru, &g_neighbor_lru);
     }
 }
@@ -0,0 +1,206 @@
+/****************************************************************************
+ * net/netdev/netdev_csum.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/netdev.h>
+
+#ifdef CONFIG_NETDEV_CHECKSUM_OFFLOAD
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_txcsum_offload
+ *
+ * Description:
+ *   Leave the checksum of the outgoing TCP segment in d_iob to the network
+ *   device if it advertises NETDEV_F_TXCSUM.  The checksum field is set to
+ *   the sum of the pseudo-header and the packet is marked so that the
+ *   driver completes it over the upper layer header and payload.
+ *
+ * Input Parameters:
+ *   dev     - The network driver instance.  The packet data is in d_iob.
+ *   proto   - The upper layer protocol.
+ *   iplen   - The size of the IP header, including IPv4 options or IPv6
+ *             extension headers.
+ *   csumoff - The offset of the checksum field in the upper layer header.
+ *
+ * Returned Value:
+ *   true if the device will complete the checksum; false if the caller
+ *   must calculate it.
+ *
+ * Assumptions:
+ *   The caller has locked the network.
+ *
+ ****************************************************************************/
+
+bool netdev_txcsum_offload(FAR struct net_driver_s *dev, uint8_t proto,
+                           unsigned int iplen, unsigned int csumoff)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+  FAR uint16_t *field;
+  uint16_t upperlen;
+  uint16_t sum;
+
+  /* The buffer may have been received with the checksum state of the
+   * device, it never carries over to an outgoing packet.
+   */
+
+  iob->io_csumflags = 0;
+
+  /* The checksum field is updated in place, so it must be in the first
+   * buffer of the chain.
+   */
+
+  if ((dev->d_features & NETDEV_F_TXCSUM) == 0 ||
+      iplen + csumoff + sizeof(uint16_t) > iob->io_len)
+    {
+      return false;
+    }
+
+#ifdef CONFIG_NET_IPv4
+  if ((IPv4BUF->vhl & IP_VERSION_MASK) == IPv4_VERSION)
+    {
+      FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+
+      upperlen = (((uint16_t)ipv4->len[0] << 8) + ipv4->len[1]) - iplen;
+      sum      = upperlen + proto;
+      sum      = chksum(sum, (FAR uint8_t *)&ipv4->srcipaddr,
+                        2 * sizeof(in_addr_t));
+    }
+  else
+#endif
+#ifdef CONFIG_NET_IPv6
+  if ((IPv6BUF->vtc & IP_VERSION_MASK) == IPv6_VERSION)
+    {
+      FAR struct ipv6_hdr_s *ipv6 = IPv6BUF;
+
+      upperlen = (((uint16_t)ipv6->len[0] << 8) + ipv6->len[1]) -
+                 (iplen - IPv6_HDRLEN);
+      sum      = upperlen + proto;
+      sum      = chksum(sum, (FAR uint8_t *)&ipv6->srcipaddr,
+                        2 * sizeof(net_ipv6addr_t));
+    }
+  else
+#endif
+    {
+      return false;
+    }
+
+  /* The device adds the upper layer header and payload to this partial
+   * sum and stores the complement of the result in the field.
+   */
+
+  field  = (FAR uint16_t *)(IOB_DATA(iob) + iplen + csumoff);
+  *field = HTONS(sum);
+
+  iob->io_csumflags  = IOB_CSUM_PARTIAL;
+  iob->io_csumstart  = iplen;
+  iob->io_csumoffset = csumoff;
+  return true;
+}
+
+/****************************************************************************
+ * Name: netdev_csum_complete
+ *
+ * Description:
+ *   Complete a partial checksum of a packet in software.  The checksum
+ *   field holds the sum of the pseudo-header; the upper layer header and
+ *   payload from start on are added to it and the complement of the
+ *   result is stored in the field.
+ *
+ * Input Parameters:
+ *   iob    - The packet, starting with the IP header
+ *   start  - The offset in the packet where the checksum starts
+ *   offset - The offset of the checksum field from 'start'
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int netdev_csum_complete(FAR struct iob_s *iob, unsigned int start,
+                         unsigned int offset)
+{
+  uint16_t sum;
+  int ret;
+
+  if (start + offset + sizeof(uint16_t) > iob->io_pktlen)
+    {
+      return -EINVAL;
+    }
+
+  /* The field holds the pseudo-header sum, so it is simply included in the
+   * sum.  A result of zero is sent as 0xffff, as required by UDP.
+   */
+
+  sum = ~HTONS(chksum_iob(0, iob, start));
+  if (sum == 0)
+    {
+      sum = 0xffff;
+    }
+
+  ret = iob_trycopyin(iob, (FAR const uint8_t *)&sum, sizeof(sum),
+                      start + offset, false);
+  return ret < 0 ? ret : OK;
+}
+
+/****************************************************************************
+ * Name: netdev_txcsum_complete
+ *
+ * Description:
+ *   Complete in software a checksum that netdev_txcsum_offload() left to
+ *   the device.  This is needed when the packet does not reach the device,
+ *   e.g. when devif_loopback() passes it back to the input path.
+ *
+ * Input Parameters:
+ *   dev - The network driver instance.  The packet data is in d_iob.
+ *
+ * Assumptions:
+ *   The caller has locked the network.
+ *
+ ****************************************************************************/
+
+void netdev_txcsum_complete(FAR struct net_driver_s *dev)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+
+  if (iob == NULL || (iob->io_csumflags & IOB_CSUM_PARTIAL) == 0)
+    {
+      return;
+    }
+
+  netdev_csum_complete(iob, iob->io_csumstart, iob->io_csumoffset);
+  iob->io_csumflags = 0;
+}
+
+#endif /* CONFIG_NETDEV_CHECKSUM_OFFLOAD */
@@ -581,7 +581,7 @@ static int netlink_get_arptable(NETLINK_HANDLE handle,
    * the number of valid entries in the ARP table.
    */
 
-  tabsize   = CONFIG_NET_ARPTAB_SIZE * sizeof(struct arpreq);
+  tabsize   = ARP_TABLE_MAXSIZE * sizeof(struct arpreq);
   rspsize   = SIZEOF_NLROUTE_RECVFROM_RESPONSE_S(tabsize);
   allocsize = SIZEOF_NLROUTE_RECVFROM_RSPLIST_S(tabsize);
 
@@ -605,14 +605,14 @@ static int netlink_get_arptable(NETLINK_HANDLE handle,
 
   net_lock();
   ncopied = arp_snapshot((FAR struct arpreq *)entry->payload.data,
-                         CONFIG_NET_ARPTAB_SIZE);
+                         ARP_TABLE_MAXSIZE);
   net_unlock();
 
   /* Now we have the real number of valid entries in the ARP table and
    * we can trim the allocation.
    */
 
-  if (ncopied < CONFIG_NET_ARPTAB_SIZE)
+  if (ncopied < ARP_TABLE_MAXSIZE)
     {
       FAR struct getneigh_recvfrom_rsplist_s *newentry;
 
@@ -663,8 +663,7 @@ static int netlink_get_nbtable(NETLINK_HANDLE handle,
    * the number of valid entries in the Neighbor table.
    */
 
-  tabsize   = CONFIG_NET_IPv6_NCONF_ENTRIES *
-              sizeof(struct neighbor_entry_s);
+  tabsize   = NEIGHBOR_MAXENTRIES * sizeof(struct neighbor_entry_s);
   rspsize   = SIZEOF_NLROUTE_RECVFROM_RESPONSE_S(tabsize);
   allocsize = SIZEOF_NLROUTE_RECVFROM_RSPLIST_S(tabsize);
 
@@ -689,14 +688,14 @@ static int netlink_get_nbtable(NETLINK_HANDLE handle,
   net_lock();
   ncopied = neighbor_snapshot(
     (FAR struct neighbor_entry_s *)entry->payload.data,
-    CONFIG_NET_IPv6_NCONF_ENTRIES);
+    NEIGHBOR_MAXENTRIES);
   net_unlock();
 
   /* Now we have the real number of valid entries in the Neighbor table
    * and we can trim the allocation.
    */
 
-  if (ncopied < CONFIG_NET_IPv6_NCONF_ENTRIES)
+  if (ncopied < NEIGHBOR_MAXENTRIES)
     {
       FAR struct getneigh_recvfrom_rsplist_s *newentry;
 
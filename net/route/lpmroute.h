@@ -0,0 +1,145 @@
+/****************************************************************************
+ * net/route/lpmroute.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __NET_ROUTE_LPMROUTE_H
+#define __NET_ROUTE_LPMROUTE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include "route/route.h"
+
+#if defined(CONFIG_ROUTE_IPv4_LPM) || defined(CONFIG_ROUTE_IPv6_LPM)
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_init_lpmroute
+ *
+ * Description:
+ *   Initialize the longest prefix match index of the in-memory routing
+ *   tables
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called early in initialization so that no special protection is needed.
+ *
+ ****************************************************************************/
+
+void net_init_lpmroute(void);
+
+/****************************************************************************
+ * Name: net_addlpm_ipv4 and net_addlpm_ipv6
+ *
+ * Description:
+ *   Add a route to the longest prefix match index.  If there is already a
+ *   route with the same prefix, the index keeps referring to the older
+ *   route.
+ *
+ * Input Parameters:
+ *   route - The route to add.  It remains referenced by the index until
+ *           it is removed with net_dellpm_ipv4/ipv6().
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  -EINVAL is returned if the netmask
+ *   of the route is not a prefix.
+ *
+ * Assumptions:
+ *   The caller has locked the network.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_LPM
+int net_addlpm_ipv4(FAR struct net_route_ipv4_s *route);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_LPM
+int net_addlpm_ipv6(FAR struct net_route_ipv6_s *route);
+#endif
+
+/****************************************************************************
+ * Name: net_dellpm_ipv4 and net_dellpm_ipv6
+ *
+ * Description:
+ *   Remove a route from the longest prefix match index.  The route must
+ *   already have been removed from the routing table.  If the table holds
+ *   another route with the same prefix, the index then refers to it.
+ *
+ * Input Parameters:
+ *   route - The route to remove
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has locked the network.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_LPM
+void net_dellpm_ipv4(FAR struct net_route_ipv4_s *route);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_LPM
+void net_dellpm_ipv6(FAR struct net_route_ipv6_s *route);
+#endif
+
+/****************************************************************************
+ * Name: net_foreachlpm_ipv4/net_foreachlpm_ipv6
+ *
+ * Description:
+ *   Visit the routes whose network contains the target address, from the
+ *   shortest to the longest prefix.  Only the routes on the path to the
+ *   target are visited, so a handler that records each route that it
+ *   accepts ends up with the longest matching one.
+ *
+ * Input Parameters:
+ *   target  - The address to look up
+ *   handler - Will be called for each route that contains the target.
+ *   arg     - An arbitrary value that will be passed to the handler.
+ *
+ * Returned Value:
+ *   One if the handler returned a non-zero value for any route; zero
+ *   otherwise.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_LPM
+int net_foreachlpm_ipv4(in_addr_t target, route_handler_ipv4_t handler,
+                        FAR void *arg);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_LPM
+int net_foreachlpm_ipv6(FAR const uint16_t *target,
+                        route_handler_ipv6_t handler, FAR void *arg);
+#endif
+
+#endif /* CONFIG_ROUTE_IPv4_LPM || CONFIG_ROUTE_IPv6_LPM */
+#endif /* __NET_ROUTE_LPMROUTE_H */
@@ -35,6 +35,7 @@
 #include <arch/irq.h>
 
 #include "route/ramroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_RAMROUTE)
@@ -60,6 +61,9 @@
 int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
 {
   FAR struct net_route_ipv4_s *route;
+#ifdef CONFIG_ROUTE_IPv4_LPM
+  int ret;
+#endif
 
   /* Allocate a route entry */
 
@@ -81,6 +85,19 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
 
   net_lock();
 
+#ifdef CONFIG_ROUTE_IPv4_LPM
+  /* Index the new entry first, that fails if the netmask is no prefix */
+
+  ret = net_addlpm_ipv4(route);
+  if (ret < 0)
+    {
+      net_unlock();
+      nerr("ERROR:  Failed to index the route: %d\n", ret);
+      net_freeroute_ipv4(route);
+      return ret;
+    }
+#endif
+
   /* Then add the new entry to the table */
 
   ramroute_ipv4_addlast((FAR struct net_route_ipv4_entry_s *)route,
@@ -95,6 +112,9 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
                       net_ipv6addr_t router)
 {
   FAR struct net_route_ipv6_s *route;
+#ifdef CONFIG_ROUTE_IPv6_LPM
+  int ret;
+#endif
 
   /* Allocate a route entry */
 
@@ -116,6 +136,19 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
 
   net_lock();
 
+#ifdef CONFIG_ROUTE_IPv6_LPM
+  /* Index the new entry first, that fails if the netmask is no prefix */
+
+  ret = net_addlpm_ipv6(route);
+  if (ret < 0)
+    {
+      net_unlock();
+      nerr("ERROR:  Failed to index the route: %d\n", ret);
+      net_freeroute_ipv6(route);
+      return ret;
+    }
+#endif
+
   /* Then add the new entry to the table */
 
   ramroute_ipv6_addlast((FAR struct net_route_ipv6_entry_s *)route,
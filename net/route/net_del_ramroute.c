@@ -33,6 +33,7 @@
 #include <nuttx/net/ip.h>
 
 #include "route/ramroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_RAMROUTE)
@@ -109,6 +110,12 @@ static int net_match_ipv4(FAR struct net_route_ipv4_s *route, FAR void *arg)
           ramroute_ipv4_remfirst(&g_ipv4_routes);
         }
 
+#ifdef CONFIG_ROUTE_IPv4_LPM
+      /* Drop the entry from the index before it is reused */
+
+      net_dellpm_ipv4(route);
+#endif
+
       /* And free the routing table entry by adding it to the free list */
 
       net_freeroute_ipv4(route);
@@ -165,6 +172,12 @@ static int net_match_ipv6(
           ramroute_ipv6_remfirst(&g_ipv6_routes);
         }
 
+#ifdef CONFIG_ROUTE_IPv6_LPM
+      /* Drop the entry from the index before it is reused */
+
+      net_dellpm_ipv6(route);
+#endif
+
       /* And free the routing table entry by adding it to the free list */
 
       net_freeroute_ipv6(route);
@@ -0,0 +1,682 @@
+/****************************************************************************
+ * net/route/net_lpmroute.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/net/net.h>
+#include <nuttx/net/ip.h>
+
+#include "route/ramroute.h"
+#include "route/lpmroute.h"
+#include "route/route.h"
+
+#if defined(CONFIG_ROUTE_IPv4_LPM) || defined(CONFIG_ROUTE_IPv6_LPM)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The size of the largest address in the index */
+
+#ifdef CONFIG_ROUTE_IPv6_LPM
+#  define LPM_KEYSIZE sizeof(net_ipv6addr_t)
+#else
+#  define LPM_KEYSIZE sizeof(in_addr_t)
+#endif
+
+/* A path compressed binary trie over N distinct prefixes never has more
+ * than N nodes holding a route and N - 1 branch nodes.
+ */
+
+#define LPM_IPv4_NNODES (2 * CONFIG_ROUTE_MAX_IPv4_RAMROUTES)
+#define LPM_IPv6_NNODES (2 * CONFIG_ROUTE_MAX_IPv6_RAMROUTES)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One node of the trie.  The bits of the prefix that the trie skips over
+ * are kept in the node, so a lookup only visits the nodes of the prefixes
+ * that contain the address and the branch points between them.
+ */
+
+struct lpm_node_s
+{
+  FAR struct lpm_node_s *child[2]; /* Subtries for the next bit 0 and 1 */
+  FAR void *route;                 /* Route with this prefix or NULL */
+  uint8_t plen;                    /* Prefix length in bits */
+  uint8_t prefix[LPM_KEYSIZE];     /* Prefix in network order */
+};
+
+/* The index of one address family */
+
+struct lpm_trie_s
+{
+  FAR struct lpm_node_s *root;     /* The root of the trie */
+  FAR struct lpm_node_s *free;     /* Free nodes, linked through child[0] */
+  uint8_t keysize;                 /* The size of an address in bytes */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_LPM
+static struct lpm_trie_s g_ipv4_lpm;
+static struct lpm_node_s g_ipv4_lpmnodes[LPM_IPv4_NNODES];
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_LPM
+static struct lpm_trie_s g_ipv6_lpm;
+static struct lpm_node_s g_ipv6_lpmnodes[LPM_IPv6_NNODES];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lpm_bit
+ *
+ * Description:
+ *   Return bit n of an address, counting from the most significant bit of
+ *   the first byte.
+ *
+ ****************************************************************************/
+
+static inline unsigned int lpm_bit(FAR const uint8_t *key, unsigned int n)
+{
+  return (key[n >> 3] >> (7 - (n & 7))) & 1;
+}
+
+/****************************************************************************
+ * Name: lpm_common
+ *
+ * Description:
+ *   Return the number of leading bits that are the same in two addresses,
+ *   up to a maximum of maxbits.
+ *
+ ****************************************************************************/
+
+static unsigned int lpm_common(FAR const uint8_t *a, FAR const uint8_t *b,
+                               unsigned int maxbits)
+{
+  unsigned int nbits = 0;
+  uint8_t diff;
+
+  while (nbits < maxbits)
+    {
+      diff = a[nbits >> 3] ^ b[nbits >> 3];
+      if (diff != 0)
+        {
+          while ((diff & 0x80) == 0)
+            {
+              diff <<= 1;
+              nbits++;
+            }
+
+          break;
+        }
+
+      nbits += 8;
+    }
+
+  return nbits < maxbits ? nbits : maxbits;
+}
+
+/****************************************************************************
+ * Name: lpm_preflen
+ *
+ * Description:
+ *   Return the prefix length of a netmask, or -EINVAL if the ones in the
+ *   netmask are not contiguous.
+ *
+ ****************************************************************************/
+
+static int lpm_preflen(FAR const uint8_t *mask, unsigned int size)
+{
+  unsigned int plen = 0;
+  unsigned int i;
+  uint8_t bits;
+
+  for (i = 0; i < size && mask[i] == 0xff; i++)
+    {
+      plen += 8;
+    }
+
+  if (i < size)
+    {
+      for (bits = mask[i]; (bits & 0x80) != 0; bits <<= 1)
+        {
+          plen++;
+        }
+
+      if (bits != 0)
+        {
+          return -EINVAL;
+        }
+
+      while (++i < size)
+        {
+          if (mask[i] != 0)
+            {
+              return -EINVAL;
+            }
+        }
+    }
+
+  return plen;
+}
+
+/****************************************************************************
+ * Name: lpm_initialize
+ ****************************************************************************/
+
+static void lpm_initialize(FAR struct lpm_trie_s *trie,
+                           FAR struct lpm_node_s *nodes,
+                           unsigned int nnodes, unsigned int keysize)
+{
+  unsigned int i;
+
+  trie->root    = NULL;
+  trie->free    = NULL;
+  trie->keysize = keysize;
+
+  for (i = 0; i < nnodes; i++)
+    {
+      nodes[i].child[0] = trie->free;
+      trie->free        = &nodes[i];
+    }
+}
+
+/****************************************************************************
+ * Name: lpm_alloc
+ *
+ * Description:
+ *   Allocate a node for the first plen bits of key.
+ *
+ ****************************************************************************/
+
+static FAR struct lpm_node_s *lpm_alloc(FAR struct lpm_trie_s *trie,
+                                        FAR const uint8_t *key,
+                                        unsigned int plen, FAR void *route)
+{
+  FAR struct lpm_node_s *node = trie->free;
+  unsigned int nbytes = (plen + 7) >> 3;
+
+  if (node != NULL)
+    {
+      trie->free = node->child[0];
+
+      node->child[0] = NULL;
+      node->child[1] = NULL;
+      node->route    = route;
+      node->plen     = plen;
+
+      /* Clear the bits beyond the prefix */
+
+      memset(node->prefix, 0, sizeof(node->prefix));
+      memcpy(node->prefix, key, nbytes);
+      if ((plen & 7) != 0)
+        {
+          node->prefix[nbytes - 1] &= 0xff << (8 - (plen & 7));
+        }
+    }
+
+  return node;
+}
+
+/****************************************************************************
+ * Name: lpm_free
+ ****************************************************************************/
+
+static void lpm_free(FAR struct lpm_trie_s *trie,
+                     FAR struct lpm_node_s *node)
+{
+  node->child[0] = trie->free;
+  trie->free     = node;
+}
+
+/****************************************************************************
+ * Name: lpm_insert
+ *
+ * Description:
+ *   Add the route for the prefix of plen bits of key to the trie.
+ *
+ ****************************************************************************/
+
+static int lpm_insert(FAR struct lpm_trie_s *trie, FAR const uint8_t *key,
+                      unsigned int plen, FAR void *route)
+{
+  FAR struct lpm_node_s **link = &trie->root;
+  FAR struct lpm_node_s *branch;
+  FAR struct lpm_node_s *node;
+  FAR struct lpm_node_s *leaf;
+  unsigned int common = 0;
+
+  /* Descend while the prefix of the node contains the new prefix */
+
+  while ((node = *link) != NULL)
+    {
+      common = lpm_common(node->prefix, key,
+                          node->plen < plen ? node->plen : plen);
+      if (common < node->plen)
+        {
+          break;
+        }
+
+      if (node->plen == plen)
+        {
+          /* The prefix is already in the trie.  Like the linear search of
+           * the routing table, prefer the route that was added first.
+           */
+
+          if (node->route == NULL)
+            {
+              node->route = route;
+            }
+
+          return OK;
+        }
+
+      link = &node->child[lpm_bit(key, node->plen)];
+    }
+
+  leaf = lpm_alloc(trie, key, plen, route);
+  if (leaf == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  if (node != NULL)
+    {
+      if (common == plen)
+        {
+          /* The new prefix contains the prefix of the node */
+
+          leaf->child[lpm_bit(node->prefix, plen)] = node;
+        }
+      else
+        {
+          /* The prefixes differ at bit common, branch there */
+
+          branch = lpm_alloc(trie, key, common, NULL);
+          if (branch == NULL)
+            {
+              lpm_free(trie, leaf);
+              return -ENOMEM;
+            }
+
+          branch->child[lpm_bit(key, common)]          = leaf;
+          branch->child[lpm_bit(node->prefix, common)] = node;
+          leaf = branch;
+        }
+    }
+
+  *link = leaf;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lpm_remove
+ *
+ * Description:
+ *   Remove the route for the prefix of plen bits of key from the trie, or
+ *   replace it by another route with the same prefix.
+ *
+ ****************************************************************************/
+
+static void lpm_remove(FAR struct lpm_trie_s *trie, FAR const uint8_t *key,
+                       unsigned int plen, FAR void *route,
+                       FAR void *replacement)
+{
+  FAR struct lpm_node_s **parent = NULL;
+  FAR struct lpm_node_s **link = &trie->root;
+  FAR struct lpm_node_s *child;
+  FAR struct lpm_node_s *node;
+
+  while ((node = *link) != NULL && node->plen < plen)
+    {
+      if (lpm_common(node->prefix, key, node->plen) < node->plen)
+        {
+          return;
+        }
+
+      parent = link;
+      link   = &node->child[lpm_bit(key, node->plen)];
+    }
+
+  /* A duplicate route that the trie does not refer to needs no update */
+
+  if (node == NULL || node->plen != plen || node->route != route)
+    {
+      return;
+    }
+
+  node->route = replacement;
+  if (replacement != NULL ||
+      (node->child[0] != NULL && node->child[1] != NULL))
+    {
+      return;
+    }
+
+  /* Splice out the node, and its parent if that was only a branch */
+
+  child = node->child[0] != NULL ? node->child[0] : node->child[1];
+  *link = child;
+  lpm_free(trie, node);
+
+  if (child == NULL && parent != NULL && (*parent)->route == NULL)
+    {
+      node    = *parent;
+      *parent = node->child[0] != NULL ? node->child[0] : node->child[1];
+      lpm_free(trie, node);
+    }
+}
+
+/****************************************************************************
+ * Name: lpm_next
+ *
+ * Description:
+ *   Return the next node on the path to key that holds a route, starting
+ *   at the root if prev is NULL.
+ *
+ ****************************************************************************/
+
+static FAR struct lpm_node_s *lpm_next(FAR struct lpm_trie_s *trie,
+                                       FAR const uint8_t *key,
+                                       FAR struct lpm_node_s *prev)
+{
+  unsigned int nbits = trie->keysize << 3;
+  FAR struct lpm_node_s *node;
+
+  if (prev == NULL)
+    {
+      node = trie->root;
+    }
+  else if (prev->plen < nbits)
+    {
+      node = prev->child[lpm_bit(key, prev->plen)];
+    }
+  else
+    {
+      return NULL;
+    }
+
+  while (node != NULL &&
+         lpm_common(node->prefix, key, node->plen) == node->plen)
+    {
+      if (node->route != NULL)
+        {
+          return node;
+        }
+
+      /* A node without a route is a branch, plen is less than nbits */
+
+      node = node->child[lpm_bit(key, node->plen)];
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_init_lpmroute
+ *
+ * Description:
+ *   Initialize the longest prefix match index of the in-memory routing
+ *   tables
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called early in initialization so that no special protection is needed.
+ *
+ ****************************************************************************/
+
+void net_init_lpmroute(void)
+{
+#ifdef CONFIG_ROUTE_IPv4_LPM
+  lpm_initialize(&g_ipv4_lpm, g_ipv4_lpmnodes, LPM_IPv4_NNODES,
+                 sizeof(in_addr_t));
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_LPM
+  lpm_initialize(&g_ipv6_lpm, g_ipv6_lpmnodes, LPM_IPv6_NNODES,
+                 sizeof(net_ipv6addr_t));
+#endif
+}
+
+/****************************************************************************
+ * Name: net_addlpm_ipv4 and net_addlpm_ipv6
+ *
+ * Description:
+ *   Add a route to the longest prefix match index.  If there is already a
+ *   route with the same prefix, the index keeps referring to the older
+ *   route.
+ *
+ * Input Parameters:
+ *   route - The route to add.  It remains referenced by the index until
+ *           it is removed with net_dellpm_ipv4/ipv6().
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  -EINVAL is returned if the netmask
+ *   of the route is not a prefix.
+ *
+ * Assumptions:
+ *   The caller has locked the network.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_LPM
+int net_addlpm_ipv4(FAR struct net_route_ipv4_s *route)
+{
+  int plen;
+
+  plen = lpm_preflen((FAR const uint8_t *)&route->netmask,
+                     sizeof(in_addr_t));
+  if (plen < 0)
+    {
+      return plen;
+    }
+
+  return lpm_insert(&g_ipv4_lpm, (FAR const uint8_t *)&route->target,
+                    plen, route);
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_LPM
+int net_addlpm_ipv6(FAR struct net_route_ipv6_s *route)
+{
+  int plen;
+
+  plen = lpm_preflen((FAR const uint8_t *)route->netmask,
+                     sizeof(net_ipv6addr_t));
+  if (plen < 0)
+    {
+      return plen;
+    }
+
+  return lpm_insert(&g_ipv6_lpm, (FAR const uint8_t *)route->target,
+                    plen, route);
+}
+#endif
+
+/****************************************************************************
+ * Name: net_dellpm_ipv4 and net_dellpm_ipv6
+ *
+ * Description:
+ *   Remove a route from the longest prefix match index.  The route must
+ *   already have been removed from the routing table.  If the table holds
+ *   another route with the same prefix, the index then refers to it.
+ *
+ * Input Parameters:
+ *   route - The route to remove
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has locked the network.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_LPM
+void net_dellpm_ipv4(FAR struct net_route_ipv4_s *route)
+{
+  FAR struct net_route_ipv4_entry_s *entry;
+  int plen;
+
+  plen = lpm_preflen((FAR const uint8_t *)&route->netmask,
+                     sizeof(in_addr_t));
+  if (plen < 0)
+    {
+      return;
+    }
+
+  /* Find the oldest remaining route with the same prefix */
+
+  for (entry = g_ipv4_routes.head; entry != NULL; entry = entry->flink)
+    {
+      if (net_ipv4addr_cmp(entry->entry.netmask, route->netmask) &&
+          net_ipv4addr_maskcmp(entry->entry.target, route->target,
+                               route->netmask))
+        {
+          break;
+        }
+    }
+
+  lpm_remove(&g_ipv4_lpm, (FAR const uint8_t *)&route->target, plen,
+             route, entry != NULL ? &entry->entry : NULL);
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_LPM
+void net_dellpm_ipv6(FAR struct net_route_ipv6_s *route)
+{
+  FAR struct net_route_ipv6_entry_s *entry;
+  int plen;
+
+  plen = lpm_preflen((FAR const uint8_t *)route->netmask,
+                     sizeof(net_ipv6addr_t));
+  if (plen < 0)
+    {
+      return;
+    }
+
+  /* Find the oldest remaining route with the same prefix */
+
+  for (entry = g_ipv6_routes.head; entry != NULL; entry = entry->flink)
+    {
+      if (net_ipv6addr_cmp(entry->entry.netmask, route->netmask) &&
+          net_ipv6addr_maskcmp(entry->entry.target, route->target,
+                               route->netmask))
+        {
+          break;
+        }
+    }
+
+  lpm_remove(&g_ipv6_lpm, (FAR const uint8_t *)route->target, plen,
+             route, entry != NULL ? &entry->entry : NULL);
+}
+#endif
+
+/****************************************************************************
+ * Name: net_foreachlpm_ipv4/net_foreachlpm_ipv6
+ *
+ * Description:
+ *   Visit the routes whose network contains the target address, from the
+ *   shortest to the longest prefix.  Only the routes on the path to the
+ *   target are visited, so a handler that records each route that it
+ *   accepts ends up with the longest matching one.
+ *
+ * Input Parameters:
+ *   target  - The address to look up
+ *   handler - Will be called for each route that contains the target.
+ *   arg     - An arbitrary value that will be passed to the handler.
+ *
+ * Returned Value:
+ *   One if the handler returned a non-zero value for any route; zero
+ *   otherwise.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_LPM
+int net_foreachlpm_ipv4(in_addr_t target, route_handler_ipv4_t handler,
+                        FAR void *arg)
+{
+  FAR struct lpm_node_s *node = NULL;
+  int ret = 0;
+
+  net_lock();
+
+  while ((node = lpm_next(&g_ipv4_lpm, (FAR const uint8_t *)&target,
+                          node)) != NULL)
+    {
+      if (handler(node->route, arg) != 0)
+        {
+          ret = 1;
+        }
+    }
+
+  net_unlock();
+  return ret;
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_LPM
+int net_foreachlpm_ipv6(FAR const uint16_t *target,
+                        route_handler_ipv6_t handler, FAR void *arg)
+{
+  FAR struct lpm_node_s *node = NULL;
+  int ret = 0;
+
+  net_lock();
+
+  while ((node = lpm_next(&g_ipv6_lpm, (FAR const uint8_t *)target,
+                          node)) != NULL)
+    {
+      if (handler(node->route, arg) != 0)
+        {
+          ret = 1;
+        }
+    }
+
+  net_unlock();
+  return ret;
+}
+#endif
+
+#endif /* CONFIG_ROUTE_IPv4_LPM || CONFIG_ROUTE_IPv6_LPM */
@@ -34,6 +34,7 @@
 
 #include "devif/devif.h"
 #include "route/cacheroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_NET) && defined(CONFIG_NET_ROUTE)
@@ -108,8 +109,9 @@ static int net_ipv4_match(FAR struct net_route_ipv4_s *route, FAR void *arg)
                                (FAR struct route_ipv4_match_s *)arg;
 
   /* To match, the masked target addresses must be the same.  In the event
-   * of multiple matches, only the first is returned.  There is not (yet) any
-   * concept for the precedence of networks.
+   * of multiple matches, only the first is returned.  The longest prefix
+   * match index visits the matches from the shortest to the longest prefix
+   * instead, so the last one, with the longest prefix, is returned.
    */
 
   if (net_ipv4addr_maskcmp(route->target, match->target, route->netmask))
@@ -152,8 +154,9 @@ static int net_ipv6_match(FAR struct net_route_ipv6_s *route, FAR void *arg)
                                 (FAR struct route_ipv6_match_s *)arg;
 
   /* To match, the masked target addresses must be the same.  In the event
-   * of multiple matches, only the first is returned.  There is not (yet) any
-   * concept for the precedence of networks.
+   * of multiple matches, only the first is returned.  The longest prefix
+   * match index visits the matches from the shortest to the longest prefix
+   * instead, so the last one, with the longest prefix, is returned.
    */
 
   if (net_ipv6addr_maskcmp(route->target, match->target, route->netmask))
@@ -224,7 +227,11 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
        * routing table that can forward to this address
        */
 
+#ifdef CONFIG_ROUTE_IPv4_LPM
+      ret = net_foreachlpm_ipv4(match.target, net_ipv4_match, &match);
+#else
       ret = net_foreachroute_ipv4(net_ipv4_match, &match);
+#endif
     }
 
   /* Did we find a route? */
@@ -299,7 +306,11 @@ int net_ipv6_router(const net_ipv6addr_t target, net_ipv6addr_t router)
        * routing table that can forward to this address
        */
 
+#ifdef CONFIG_ROUTE_IPv6_LPM
+      ret = net_foreachlpm_ipv6(match.target, net_ipv6_match, &match);
+#else
       ret = net_foreachroute_ipv6(net_ipv6_match, &match);
+#endif
     }
 
   /* Did we find a route? */
@@ -33,6 +33,7 @@
 
 #include "netdev/netdev.h"
 #include "route/cacheroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_NET) && defined(CONFIG_NET_ROUTE)
@@ -113,8 +114,10 @@ static int net_ipv4_devmatch(FAR struct net_route_ipv4_s *route,
   /* To match, (1) the masked target addresses must be the same, and (2) the
    * router address must like on the network provided by the device.
    *
-   * In the event of multiple matches, only the first is returned.  There
-   * not (yet) any concept for the precedence of networks.
+   * In the event of multiple matches, only the first is returned.  The
+   * longest prefix match index visits the matches from the shortest to the
+   * longest prefix instead, so the last one, with the longest prefix, is
+   * returned.
    */
 
   if (net_ipv4addr_maskcmp(route->target, match->target, route->netmask) &&
@@ -162,8 +165,10 @@ static int net_ipv6_devmatch(FAR struct net_route_ipv6_s *route,
   /* To match, (1) the masked target addresses must be the same, and (2) the
    * router address must like on the network provided by the device.
    *
-   * In the event of multiple matches, only the first is returned.  There
-   * not (yet) any concept for the precedence of networks.
+   * In the event of multiple matches, only the first is returned.  The
+   * longest prefix match index visits the matches from the shortest to the
+   * longest prefix instead, so the last one, with the longest prefix, is
+   * returned.
    */
 
   if (net_ipv6addr_maskcmp(route->target, match->target, route->netmask) &&
@@ -235,7 +240,11 @@ void netdev_ipv4_router(FAR struct net_driver_s *dev, in_addr_t target,
        * routing table that can forward to this address
        */
 
+#ifdef CONFIG_ROUTE_IPv4_LPM
+      ret = net_foreachlpm_ipv4(match.target, net_ipv4_devmatch, &match);
+#else
       ret = net_foreachroute_ipv4(net_ipv4_devmatch, &match);
+#endif
     }
 
   /* Did we find a route? */
@@ -314,7 +323,11 @@ void netdev_ipv6_router(FAR struct net_driver_s *dev,
        * routing table that can forward to this address
        */
 
+#ifdef CONFIG_ROUTE_IPv6_LPM
+      ret = net_foreachlpm_ipv6(match.target, net_ipv6_devmatch, &match);
+#else
       ret = net_foreachroute_ipv6(net_ipv6_devmatch, &match);
+#endif
     }
 
   /* Did we find a route? */
@@ -211,6 +211,12 @@ struct tcp_conn_s
   /* TCP-specific content follows */
 
   union ip_binding_u u;   /* IP address binding */
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  sq_entry_t hnode;       /* Link in the 4-tuple hash of active
+                           * connections */
+  sq_entry_t pnode;       /* Link in the local port hash of active
+                           * connections */
+#endif
   uint8_t  rcvseq[4];     /* The sequence number that we expect to
                            * receive next */
   uint8_t  sndseq[4];     /* The sequence number that was last sent by us */
@@ -57,6 +57,7 @@
 
 #include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/nuttx.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -71,6 +72,25 @@
 #include "nat/nat.h"
 #include "netdev/netdev.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CONN_HASH
+#  define TCP_HASH_MASK (CONFIG_NET_TCP_CONN_HASH_SIZE - 1)
+
+#  if (CONFIG_NET_TCP_CONN_HASH_SIZE & TCP_HASH_MASK) != 0
+#    error CONFIG_NET_TCP_CONN_HASH_SIZE must be a power of two
+#  endif
+
+/* Map a hash table entry back to its connection */
+
+#  define TCP_HASH_CONN(node) \
+     ((node) ? container_of(node, struct tcp_conn_s, hnode) : NULL)
+#  define TCP_PORT_CONN(node) \
+     ((node) ? container_of(node, struct tcp_conn_s, pnode) : NULL)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -89,10 +109,136 @@ static dq_queue_t g_free_tcp_connections;
 
 static dq_queue_t g_active_tcp_connections;
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+/* The connected TCP connections hashed by local port, remote port and
+ * remote address, and by local port alone.  The local address is not
+ * part of the key because a connection may be bound to INADDR_ANY.
+ */
+
+static sq_queue_t g_tcp_conn_hash[CONFIG_NET_TCP_CONN_HASH_SIZE];
+static sq_queue_t g_tcp_port_hash[CONFIG_NET_TCP_CONN_HASH_SIZE];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_port_hash and tcp_conn_hash
+ *
+ * Description:
+ *   Return the bucket of a local port, or of a local port, remote port and
+ *   remote address (all in network byte order).  IPv6 addresses are folded
+ *   to 32 bits with tcp_ipv6_fold() first.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CONN_HASH
+static inline unsigned int tcp_port_hash(uint16_t lport)
+{
+  return ((uint32_t)lport * 2654435761u >> 16) & TCP_HASH_MASK;
+}
+
+static inline unsigned int tcp_conn_hash(uint16_t lport, uint16_t rport,
+                                         uint32_t raddr)
+{
+  uint32_t hash = raddr ^ ((uint32_t)lport << 16 | rport);
+
+  hash *= 2654435761u;
+  return (hash ^ hash >> 16) & TCP_HASH_MASK;
+}
+
+#ifdef CONFIG_NET_IPv6
+static inline uint32_t tcp_ipv6_fold(FAR const uint16_t *addr)
+{
+  uint32_t fold = 0;
+  int i;
+
+  for (i = 0; i < 8; i += 2)
+    {
+      fold ^= (uint32_t)addr[i] << 16 | addr[i + 1];
+    }
+
+  return fold;
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_conn_hashkey
+ *
+ * Description:
+ *   Return the 4-tuple hash bucket of an active connection.
+ *
+ ****************************************************************************/
+
+static unsigned int tcp_conn_hashkey(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (conn->domain == PF_INET6)
+#endif
+    {
+      return tcp_conn_hash(conn->lport, conn->rport,
+                           tcp_ipv6_fold(conn->u.ipv6.raddr));
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      return tcp_conn_hash(conn->lport, conn->rport, conn->u.ipv4.raddr);
+    }
+#endif /* CONFIG_NET_IPv4 */
+}
+#endif /* CONFIG_NET_TCP_CONN_HASH */
+
+/****************************************************************************
+ * Name: tcp_active_add
+ *
+ * Description:
+ *   Put a connection whose ports and addresses have been set up into the
+ *   list of active connections.
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+static void tcp_active_add(FAR struct tcp_conn_s *conn)
+{
+  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  /* Append so that each bucket keeps the order of the active list */
+
+  sq_addlast(&conn->hnode, &g_tcp_conn_hash[tcp_conn_hashkey(conn)]);
+  sq_addlast(&conn->pnode, &g_tcp_port_hash[tcp_port_hash(conn->lport)]);
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_active_remove
+ *
+ * Description:
+ *   Remove a connection from the list of active connections.
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+static void tcp_active_remove(FAR struct tcp_conn_s *conn)
+{
+  dq_rem(&conn->sconn.node, &g_active_tcp_connections);
+
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  sq_rem(&conn->hnode, &g_tcp_conn_hash[tcp_conn_hashkey(conn)]);
+  sq_rem(&conn->pnode, &g_tcp_port_hash[tcp_port_hash(conn->lport)]);
+#endif
+}
+
 /****************************************************************************
  * Name: tcp_listener
  *
@@ -109,11 +255,17 @@ static FAR struct tcp_conn_s *
   tcp_listener(uint8_t domain, FAR const union ip_addr_u *ipaddr,
                uint16_t portno)
 {
-  FAR struct tcp_conn_s *conn = NULL;
+  FAR struct tcp_conn_s *conn;
 
   /* Check if this port number is in use by any active UIP TCP connection */
 
-  while ((conn = tcp_nextconn(conn)) != NULL)
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  for (conn = TCP_PORT_CONN(g_tcp_port_hash[tcp_port_hash(portno)].head);
+       conn != NULL;
+       conn = TCP_PORT_CONN(conn->pnode.flink))
+#else
+  for (conn = tcp_nextconn(NULL); conn != NULL; conn = tcp_nextconn(conn))
+#endif
     {
       /* Check if this connection is open and the local port assignment
        * matches the requested port number.
@@ -187,9 +339,14 @@ static inline FAR struct tcp_conn_s *
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  conn       = TCP_HASH_CONN(g_tcp_conn_hash[tcp_conn_hash(tcp->destport,
+                             tcp->srcport, srcipaddr)].head);
+#else
+  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
 
   while (conn)
     {
@@ -226,7 +383,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+      conn = TCP_HASH_CONN(conn->hnode.flink);
+#else
       conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+#endif
     }
 
   return conn;
@@ -254,9 +415,14 @@ static inline FAR struct tcp_conn_s *
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  conn       = TCP_HASH_CONN(g_tcp_conn_hash[tcp_conn_hash(tcp->destport,
+                             tcp->srcport, tcp_ipv6_fold(*srcipaddr))].head);
+#else
+  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
 
   while (conn)
     {
@@ -293,7 +459,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+      conn = TCP_HASH_CONN(conn->hnode.flink);
+#else
       conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+#endif
     }
 
   return conn;
@@ -942,7 +1112,7 @@ void tcp_free(FAR struct tcp_conn_s *conn)
     {
       /* Remove the connection from the active list */
 
-      dq_rem(&conn->sconn.node, &g_active_tcp_connections);
+      tcp_active_remove(conn);
     }
 
   tcp_free_rx_buffers(conn);
@@ -1251,7 +1421,7 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
        * Interrupts should already be disabled in this context.
        */
 
-      dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+      tcp_active_add(conn);
       tcp_update_retrantimer(conn, TCP_RTO);
     }
 
@@ -1559,7 +1729,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
   /* And, finally, put the connection structure into the active list. */
 
-  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+  tcp_active_add(conn);
   ret = OK;
 
 errout_with_lock:
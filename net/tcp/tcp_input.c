@@ -720,12 +720,12 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
   tcpiplen = iplen + TCP_HDRLEN;
 
-  /* Start of TCP input header processing code. */
+  /* Start of TCP input header processing code.  Compute and check the TCP
+   * checksum, unless the device has already verified it.
+   */
 
-  if (tcp_chksum(dev) != 0xffff)
+  if (!NETDEV_RXCSUM_VALID(dev) && tcp_chksum(dev) != 0xffff)
     {
-      /* Compute and check the TCP checksum. */
-
 #ifdef CONFIG_NET_STATISTICS
       g_netstats.tcp.drop++;
       g_netstats.tcp.chkerr++;
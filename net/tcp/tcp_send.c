@@ -46,6 +46,7 @@
 #if defined(CONFIG_NET) && defined(CONFIG_NET_TCP)
 
 #include <assert.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 #include <debug.h>
@@ -184,10 +185,14 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
                         IP_PROTO_TCP, dev->d_ipv6addr, conn->u.ipv6.raddr,
                         conn->sconn.ttl, conn->sconn.s_tclass);
 
-      /* Calculate TCP checksum. */
+      /* Calculate TCP checksum, unless the device completes it */
 
-      tcp->tcpchksum = 0;
-      tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+      if (!netdev_txcsum_offload(dev, IP_PROTO_TCP, IPv6_HDRLEN,
+                                 offsetof(struct tcp_hdr_s, tcpchksum)))
+        {
+          tcp->tcpchksum = 0;
+          tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+        }
 #ifdef CONFIG_NET_STATISTICS
       g_netstats.ipv6.sent++;
 #endif
@@ -204,10 +209,14 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
                         &dev->d_ipaddr, &conn->u.ipv4.raddr,
                         conn->sconn.ttl, conn->sconn.s_tos, NULL);
 
-      /* Calculate TCP checksum. */
+      /* Calculate TCP checksum, unless the device completes it */
 
-      tcp->tcpchksum = 0;
-      tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+      if (!netdev_txcsum_offload(dev, IP_PROTO_TCP, IPv4_HDRLEN,
+                                 offsetof(struct tcp_hdr_s, tcpchksum)))
+        {
+          tcp->tcpchksum = 0;
+          tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+        }
 #ifdef CONFIG_NET_STATISTICS
       g_netstats.ipv4.sent++;
 #endif
@@ -479,8 +488,12 @@ void tcp_reset(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
                         IP_PROTO_TCP, dev->d_ipv6addr, ipv6->srcipaddr,
                         conn ? conn->sconn.ttl : IP_TTL_DEFAULT,
                         conn ? conn->sconn.s_tos : 0);
-      tcp->tcpchksum = 0;
-      tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+      if (!netdev_txcsum_offload(dev, IP_PROTO_TCP, IPv6_HDRLEN,
+                                 offsetof(struct tcp_hdr_s, tcpchksum)))
+        {
+          tcp->tcpchksum = 0;
+          tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+        }
     }
 #endif /* CONFIG_NET_IPv6 */
 
@@ -496,8 +509,12 @@ void tcp_reset(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
                         conn ? conn->sconn.ttl : IP_TTL_DEFAULT,
                         conn ? conn->sconn.s_tos : 0, NULL);
 
-      tcp->tcpchksum = 0;
-      tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+      if (!netdev_txcsum_offload(dev, IP_PROTO_TCP, IPv4_HDRLEN,
+                                 offsetof(struct tcp_hdr_s, tcpchksum)))
+        {
+          tcp->tcpchksum = 0;
+          tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+        }
     }
 #endif /* CONFIG_NET_IPv4 */
 }
@@ -71,6 +71,9 @@ struct sendfile_s
   FAR struct tcp_conn_s *snd_conn;         /* Connection associated with the socket */
   FAR struct devif_callback_s *snd_cb;     /* Reference to callback instance */
   FAR struct file   *snd_file;             /* File structure of the input file */
+#ifdef CONFIG_SENDFILE_DIRECT
+  FAR const uint8_t *snd_data;             /* File data accessed in place */
+#endif
   sem_t              snd_sem;              /* Used to wake up the waiting thread */
   off_t              snd_foffset;          /* Input file offset */
   size_t             snd_flen;             /* File length */
@@ -94,6 +97,34 @@ struct sendfile_s
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: sendfile_copyin
+ *
+ * Description:
+ *   Copy the next segment into the device buffer, straight from the file
+ *   data when it is accessible in memory or by reading the file otherwise.
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+static int sendfile_copyin(FAR struct net_driver_s *dev,
+                           FAR struct sendfile_s *pstate,
+                           uint32_t sndlen, uint32_t offset,
+                           unsigned int hdrlen)
+{
+#ifdef CONFIG_SENDFILE_DIRECT
+  if (pstate->snd_data != NULL)
+    {
+      return devif_send(dev, pstate->snd_data + offset, sndlen, hdrlen);
+    }
+#endif
+
+  return devif_file_send(dev, pstate->snd_file, sndlen,
+                         pstate->snd_foffset + offset, hdrlen);
+}
+
 /****************************************************************************
  * Name: sendfile_eventhandler
  *
@@ -267,8 +298,7 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
        * happen until the polling cycle completes).
        */
 
-      ret = devif_file_send(dev, pstate->snd_file, sndlen,
-                            pstate->snd_foffset + pstate->snd_acked,
+      ret = sendfile_copyin(dev, pstate, sndlen, pstate->snd_acked,
                             tcpip_hdrsize(conn));
       if (ret < 0)
         {
@@ -338,8 +368,7 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
            * happen until the polling cycle completes).
            */
 
-          ret = devif_file_send(dev, pstate->snd_file, sndlen,
-                                pstate->snd_foffset + pstate->snd_sent,
+          ret = sendfile_copyin(dev, pstate, sndlen, pstate->snd_sent,
                                 tcpip_hdrsize(conn));
           if (ret < 0)
             {
@@ -416,6 +445,9 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
 {
   FAR struct tcp_conn_s *conn;
   struct sendfile_s state;
+#ifdef CONFIG_SENDFILE_DIRECT
+  struct mm_map_entry_s map;
+#endif
   off_t startpos;
   int ret;
 
@@ -471,6 +503,18 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
       return startpos;
     }
 
+#ifdef CONFIG_SENDFILE_DIRECT
+  /* Send the file data in place if the file system allows it.  Otherwise
+   * the data is read from the file for every segment.
+   */
+
+  ret = file_sendfile_map(infile, offset ? *offset : startpos, count, &map);
+  if (ret >= 0 && map.length == 0)
+    {
+      return 0; /* At end of file */
+    }
+#endif
+
   /* Initialize the state structure.  This is done with the network
    * locked because we don't want anything to happen until we are
    * ready.
@@ -488,6 +532,14 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
   state.snd_flen    = count;                       /* Number of bytes to send */
   state.snd_file    = infile;                      /* File to read from */
 
+#ifdef CONFIG_SENDFILE_DIRECT
+  if (map.vaddr != NULL)
+    {
+      state.snd_data = map.vaddr;                  /* File data in memory */
+      state.snd_flen = map.length;                 /* Clipped at EOF */
+    }
+#endif
+
   /* Allocate resources to receive a callback */
 
   state.snd_cb = tcp_callback_alloc(conn);
@@ -546,6 +598,38 @@ errout_locked:
 #endif
   net_unlock();
 
+#ifdef CONFIG_SENDFILE_DIRECT
+  if (state.snd_data != NULL)
+    {
+      file_sendfile_unmap(&map);
+
+      /* The file position was not used: Report the new offset or advance
+       * the file position past the data that was sent.
+       */
+
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      startpos = state.snd_foffset + state.snd_sent;
+      if (offset)
+        {
+          *offset = startpos;
+        }
+      else
+        {
+          startpos = file_seek(infile, startpos, SEEK_SET);
+          if (startpos < 0)
+            {
+              return startpos;
+            }
+        }
+
+      return state.snd_sent;
+    }
+#endif
+
   /* Return the current file position */
 
   if (offset)
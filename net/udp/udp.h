@@ -111,6 +111,9 @@ struct udp_conn_s
   /* UDP-specific content follows */
 
   union ip_binding_u u;   /* IP address binding */
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  sq_entry_t hnode;       /* Link in the local port hash */
+#endif
   uint16_t lport;         /* Bound local port number (network byte order) */
   uint16_t rport;         /* Remote port number (network byte order) */
   uint8_t  flags;         /* See _UDP_FLAG_* definitions */
@@ -264,6 +267,18 @@ FAR struct udp_conn_s *udp_nextconn(FAR struct udp_conn_s *conn);
 
 uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u);
 
+/****************************************************************************
+ * Name: udp_set_lport
+ *
+ * Description:
+ *   Bind a UDP connection to a local port (network byte order).  All
+ *   changes of lport of an allocated connection must go through here so
+ *   that the connection can be found by its port.
+ *
+ ****************************************************************************/
+
+void udp_set_lport(FAR struct udp_conn_s *conn, uint16_t portno);
+
 /****************************************************************************
  * Name: udp_bind
  *
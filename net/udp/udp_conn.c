@@ -57,6 +57,7 @@
 #include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/mutex.h>
+#include <nuttx/nuttx.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -70,6 +71,26 @@
 #include "socket/socket.h"
 #include "udp/udp.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_CONN_HASH
+#  define UDP_HASH_MASK (CONFIG_NET_UDP_CONN_HASH_SIZE - 1)
+
+#  if (CONFIG_NET_UDP_CONN_HASH_SIZE & UDP_HASH_MASK) != 0
+#    error CONFIG_NET_UDP_CONN_HASH_SIZE must be a power of two
+#  endif
+
+#  define UDP_HASH(lport) \
+     (((uint32_t)(lport) * 2654435761u >> 16) & UDP_HASH_MASK)
+
+/* Map a hash table entry back to its connection */
+
+#  define UDP_HASH_CONN(node) \
+     ((node) ? container_of(node, struct udp_conn_s, hnode) : NULL)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -89,6 +110,15 @@ static mutex_t g_free_lock = NXMUTEX_INITIALIZER;
 
 static dq_queue_t g_active_udp_connections;
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+/* The allocated UDP connections with a local port, hashed by that port.
+ * All of the connections sharing a port, including SO_REUSEADDR ones, are
+ * on the same chain.
+ */
+
+static sq_queue_t g_udp_port_hash[CONFIG_NET_UDP_CONN_HASH_SIZE];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -122,7 +152,13 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
 
   /* Now search each connection structure. */
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  for (conn = UDP_HASH_CONN(g_udp_port_hash[UDP_HASH(portno)].head);
+       conn != NULL;
+       conn = UDP_HASH_CONN(conn->hnode.flink))
+#else
   while ((conn = udp_nextconn(conn)) != NULL)
+#endif
     {
       /* With SO_REUSEADDR set for both sockets, we do not need to check its
        * address and port.
@@ -195,7 +231,11 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
   FAR struct udp_conn_s *conn;
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  conn = UDP_HASH_CONN(g_udp_port_hash[UDP_HASH(udp->destport)].head);
+#else
   conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+#endif
   while (conn)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -308,7 +348,11 @@ static inline FAR struct udp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+      conn = UDP_HASH_CONN(conn->hnode.flink);
+#else
       conn = (FAR struct udp_conn_s *)conn->sconn.node.flink;
+#endif
     }
 
   return conn;
@@ -334,7 +378,11 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
   FAR struct udp_conn_s *conn;
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  conn = UDP_HASH_CONN(g_udp_port_hash[UDP_HASH(udp->destport)].head);
+#else
   conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+#endif
   while (conn != NULL)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -447,7 +495,11 @@ static inline FAR struct udp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+      conn = UDP_HASH_CONN(conn->hnode.flink);
+#else
       conn = (FAR struct udp_conn_s *)conn->sconn.node.flink;
+#endif
     }
 
   return conn;
@@ -582,6 +634,41 @@ uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u)
   return portno;
 }
 
+/****************************************************************************
+ * Name: udp_set_lport
+ *
+ * Description:
+ *   Bind a UDP connection to a local port (network byte order), or unbind
+ *   it if portno is zero.
+ *
+ * Input Parameters:
+ *   conn   - A reference to UDP connection structure.
+ *   portno - The new local port number.
+ *
+ ****************************************************************************/
+
+void udp_set_lport(FAR struct udp_conn_s *conn, uint16_t portno)
+{
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  net_lock();
+
+  if (conn->lport != 0)
+    {
+      sq_rem(&conn->hnode, &g_udp_port_hash[UDP_HASH(conn->lport)]);
+    }
+
+  if (portno != 0)
+    {
+      sq_addlast(&conn->hnode, &g_udp_port_hash[UDP_HASH(portno)]);
+    }
+
+  conn->lport = portno;
+  net_unlock();
+#else
+  conn->lport = portno;
+#endif
+}
+
 /****************************************************************************
  * Name: udp_initialize
  *
@@ -684,8 +771,8 @@ void udp_free(FAR struct udp_conn_s *conn)
 
   DEBUGASSERT(conn->crefs == 0);
 
+  udp_set_lport(conn, 0);
   nxmutex_lock(&g_free_lock);
-  conn->lport = 0;
 
   /* Remove the connection from the active list */
 
@@ -916,7 +1003,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
     {
       /* Yes.. Select any unused local port number */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
+      udp_set_lport(conn, HTONS(udp_select_port(conn->domain, &conn->u)));
       ret         = OK;
     }
   else
@@ -945,7 +1032,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         {
           /* No.. then bind the socket to the port */
 
-          conn->lport = portno;
+          udp_set_lport(conn, portno);
           ret         = OK;
         }
       else
@@ -998,7 +1085,7 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
        * connection structure.
        */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
+      udp_set_lport(conn, HTONS(udp_select_port(conn->domain, &conn->u)));
     }
 
   /* Is there a remote port (rport)? */
@@ -121,7 +121,9 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
   dev->d_appdata = IPBUF(udpiplen);
 
 #ifdef CONFIG_NET_UDP_CHECKSUMS
-  chksum = udp->udpchksum;
+  /* Skip the checksum if the device has already verified it */
+
+  chksum = NETDEV_RXCSUM_VALID(dev) ? 0 : udp->udpchksum;
   if (chksum != 0)
     {
 #ifdef CONFIG_NET_IPv6
@@ -262,7 +262,7 @@ static int sendto_next_transfer(FAR struct udp_conn_s *conn)
        * connection structure.
        */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
+      udp_set_lport(conn, HTONS(udp_select_port(conn->domain, &conn->u)));
     }
 
   /* Get the device that will handle the remote packet transfers.  This
@@ -25,8 +25,69 @@
 #include <nuttx/config.h>
 #ifdef CONFIG_NET
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include "utils/utils.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The value of a byte when it is the first or the second byte in memory of
+ * a 16-bit word in host byte order.
+ */
+
+#ifdef CONFIG_ENDIAN_BIG
+#  define CHKSUM_BYTE0(b)  ((chksum_acc_t)(b) << 8)
+#  define CHKSUM_BYTE1(b)  ((chksum_acc_t)(b))
+#else
+#  define CHKSUM_BYTE0(b)  ((chksum_acc_t)(b))
+#  define CHKSUM_BYTE1(b)  ((chksum_acc_t)(b) << 8)
+#endif
+
+#define CHKSUM_SWAP(s)     ((uint16_t)(((s) << 8) | ((s) >> 8)))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The data is summed one word at a time into a wider accumulator that
+ * cannot overflow for the 64KiB maximum length of a chksum() call.
+ */
+
+#ifdef CONFIG_HAVE_LONG_LONG
+typedef uint64_t chksum_acc_t;
+typedef uint32_t chksum_word_t;
+#else
+typedef uint32_t chksum_acc_t;
+typedef uint16_t chksum_word_t;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: chksum_add
+ *
+ * Description:
+ *   Add two 16-bit values with the end-around carry of the one's complement
+ *   sum.
+ *
+ ****************************************************************************/
+
+static inline uint16_t chksum_add(uint16_t sum, uint16_t t)
+{
+  sum += t;
+  if (sum < t)
+    {
+      sum++; /* carry */
+    }
+
+  return sum;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -53,40 +114,90 @@
 #ifndef CONFIG_NET_ARCH_CHKSUM
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 {
-  FAR const uint8_t *dataptr;
-  FAR const uint8_t *last_byte;
+  FAR const chksum_word_t *words;
+  chksum_acc_t acc = 0;
+  bool odd;
   uint16_t t;
 
-  dataptr = data;
-  last_byte = data + len - 1;
+  if (len == 0)
+    {
+      return sum;
+    }
+
+  /* The words are summed in host byte order from naturally aligned
+   * addresses.  The one's complement sum is independent of byte order up
+   * to a final byte swap (RFC 1071, section 2(B)), and starting at an odd
+   * address only shifts the byte pairing, which also swaps the sum.
+   */
 
-  while (dataptr < last_byte)
+  odd = ((uintptr_t)data & 1) != 0;
+  if (odd)
     {
-      /* At least two more bytes */
+      acc = CHKSUM_BYTE1(*data++);
+      len--;
+    }
 
-      t = ((uint16_t)dataptr[0] << 8) + dataptr[1];
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+  while (((uintptr_t)data & (sizeof(chksum_word_t) - 1)) != 0 && len >= 2)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
 
-      dataptr += 2;
+  words = (FAR const chksum_word_t *)data;
+  while (len >= 8 * sizeof(chksum_word_t))
+    {
+      acc += words[0];
+      acc += words[1];
+      acc += words[2];
+      acc += words[3];
+      acc += words[4];
+      acc += words[5];
+      acc += words[6];
+      acc += words[7];
+      words += 8;
+      len   -= 8 * sizeof(chksum_word_t);
     }
 
-  if (dataptr == last_byte)
+  while (len >= sizeof(chksum_word_t))
     {
-      t = (dataptr[0] << 8) + 0;
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+      acc += *words++;
+      len -= sizeof(chksum_word_t);
     }
 
-  /* Return sum in host byte order. */
+  data = (FAR const uint8_t *)words;
+  while (len >= 2)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
 
-  return sum;
+  if (len > 0)
+    {
+      acc += CHKSUM_BYTE0(*data);
+    }
+
+  /* Fold the carries back into 16 bits */
+
+  while ((acc >> 16) != 0)
+    {
+      acc = (acc & 0xffff) + (acc >> 16);
+    }
+
+  /* Convert to network byte order pairing, returned in host byte order */
+
+  t = (uint16_t)acc;
+#ifdef CONFIG_ENDIAN_BIG
+  if (odd)
+#else
+  if (!odd)
+#endif
+    {
+      t = CHKSUM_SWAP(t);
+    }
+
+  return chksum_add(sum, t);
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
 
@@ -111,6 +222,10 @@ uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 #ifdef CONFIG_MM_IOB
 uint16_t chksum_iob(uint16_t sum, FAR struct iob_s *iob, uint16_t offset)
 {
+  bool odd = false;
+  uint16_t len;
+  uint16_t t;
+
   /* Skip to the I/O buffer containing the data offset */
 
   while (iob != NULL && offset > iob->io_len)
@@ -120,13 +235,18 @@ uint16_t chksum_iob(uint16_t sum, FAR struct iob_s *iob, uint16_t offset)
     }
 
   /* If the link pointer is not empty, loop to walk through all I/O buffer
-   * and accumulate the sum
+   * and accumulate the sum.  After an odd number of bytes the next buffer
+   * starts in the middle of a 16-bit word, so its partial sum has to be
+   * byte swapped.
    */
 
   while (iob != NULL)
     {
-      sum = chksum(sum, iob->io_data + iob->io_offset + offset,
-                   iob->io_len - offset);
+      len = iob->io_len - offset;
+      t   = chksum(0, iob->io_data + iob->io_offset + offset, len);
+      sum = chksum_add(sum, odd ? CHKSUM_SWAP(t) : t);
+      odd ^= (len & 1) != 0;
+
       iob = iob->io_flink;
       offset = 0;
     }
@@ -72,6 +72,17 @@ typedef CODE int (*irq_foreach_t)(int irq, FAR struct irq_info_s *info,
                                   FAR void *arg);
 #endif
 
+#ifdef CONFIG_SCHED_CSECTION_CONTENTION
+/* Contention statistics for one enter_critical_section() call site */
+
+struct irq_contention_s
+{
+  FAR void *site;    /* Return address of the enter_critical_section() call */
+  uint32_t count;    /* Number of times the critical section was contended */
+  uint32_t spins;    /* Number of times the CPU spun waiting for the lock */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -117,6 +128,16 @@ extern volatile cpu_set_t g_cpu_irqset;
 extern volatile uint8_t g_cpu_nestcount[CONFIG_SMP_NCPUS];
 #endif
 
+#ifdef CONFIG_SCHED_CSECTION_CONTENTION
+/* Per call site contention statistics, indexed by a hash of the call site.
+ * The last entry accumulates the call sites that did not fit in the table.
+ * Updated with g_cpu_irqlock held.
+ */
+
+extern struct irq_contention_s
+  g_irq_contention[CONFIG_SCHED_CSECTION_CONTENTION_NSITES + 1];
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -58,10 +58,82 @@ volatile cpu_set_t g_cpu_irqset;
 volatile uint8_t g_cpu_nestcount[CONFIG_SMP_NCPUS];
 #endif
 
+#ifdef CONFIG_SCHED_CSECTION_CONTENTION
+/* Per call site contention statistics */
+
+struct irq_contention_s
+  g_irq_contention[CONFIG_SCHED_CSECTION_CONTENTION_NSITES + 1];
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CSECTION_CONTENTION
+/* The call site of the enter_critical_section() in progress on each CPU */
+
+static FAR void *g_cpu_csection_site[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: irq_contention
+ *
+ * Description:
+ *   Account for a contended entry into the critical section from the call
+ *   site recorded for this CPU.
+ *
+ * Input Parameters:
+ *   cpu   - The CPU that has just taken g_cpu_irqlock
+ *   spins - The number of times that the CPU spun waiting for the lock
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called with g_cpu_irqlock held.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CSECTION_CONTENTION
+static void irq_contention(int cpu, uint32_t spins)
+{
+  FAR struct irq_contention_s *entry;
+  FAR void *site = g_cpu_csection_site[cpu];
+  int ndx;
+  int i;
+
+  /* Find the entry of the call site with open addressing, falling back to
+   * the overflow entry at the end of the table if it is full.
+   */
+
+  ndx   = ((uintptr_t)site >> 2) % CONFIG_SCHED_CSECTION_CONTENTION_NSITES;
+  entry = &g_irq_contention[CONFIG_SCHED_CSECTION_CONTENTION_NSITES];
+
+  for (i = 0; i < CONFIG_SCHED_CSECTION_CONTENTION_NSITES; i++)
+    {
+      if (g_irq_contention[ndx].site == site ||
+          g_irq_contention[ndx].count == 0)
+        {
+          entry       = &g_irq_contention[ndx];
+          entry->site = site;
+          break;
+        }
+
+      if (++ndx >= CONFIG_SCHED_CSECTION_CONTENTION_NSITES)
+        {
+          ndx = 0;
+        }
+    }
+
+  entry->count++;
+  entry->spins += spins;
+}
+#endif
+
 /****************************************************************************
  * Name: irq_waitlock
  *
@@ -108,6 +180,9 @@ volatile uint8_t g_cpu_nestcount[CONFIG_SMP_NCPUS];
 #ifdef CONFIG_SMP
 static bool irq_waitlock(int cpu)
 {
+#ifdef CONFIG_SCHED_CSECTION_CONTENTION
+  uint32_t spins = 0;
+#endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   FAR struct tcb_s *tcb = current_task(cpu);
 
@@ -122,6 +197,10 @@ static bool irq_waitlock(int cpu)
 
   while (spin_trylock_wo_note(&g_cpu_irqlock) == SP_LOCKED)
     {
+#ifdef CONFIG_SCHED_CSECTION_CONTENTION
+      spins++;
+#endif
+
       /* Is a pause request pending? */
 
       if (up_cpu_pausereq(cpu))
@@ -142,6 +221,13 @@ static bool irq_waitlock(int cpu)
 
   /* We have g_cpu_irqlock! */
 
+#ifdef CONFIG_SCHED_CSECTION_CONTENTION
+  if (spins > 0)
+    {
+      irq_contention(cpu, spins);
+    }
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   /* Notify that we have the spinlock */
 
@@ -188,6 +274,12 @@ irqstate_t enter_critical_section(void)
 try_again:
   ret = up_irq_save();
 
+#ifdef CONFIG_SCHED_CSECTION_CONTENTION
+  /* Remember the call site in case the critical section is contended */
+
+  g_cpu_csection_site[this_cpu()] = return_address(0);
+#endif
+
   /* Verify that the system has sufficiently initialized so that the task
    * lists are valid.
    */
@@ -37,10 +37,27 @@
  * Public Data
  ****************************************************************************/
 
-/* Used for access control */
+/* Used for access control.  This is a ticket spinlock if they are
+ * enabled, unless the atomic operations that ticket spinlocks are built on
+ * are themselves implemented with spin_lock_irqsave(NULL).
+ */
 
+#if defined(CONFIG_TICKET_SPINLOCK) && !defined(CONFIG_LIBC_ARCH_ATOMIC)
+static ticketlock_t g_irq_spin = TICKET_UNLOCKED;
+
+#  define irq_spin_lock()           ticket_lock(&g_irq_spin)
+#  define irq_spin_unlock()         ticket_unlock(&g_irq_spin)
+#  define irq_spin_lock_wo_note()   ticket_lock(&g_irq_spin)
+#  define irq_spin_unlock_wo_note() ticket_unlock(&g_irq_spin)
+#else
 static volatile spinlock_t g_irq_spin = SP_UNLOCKED;
 
+#  define irq_spin_lock()           spin_lock(&g_irq_spin)
+#  define irq_spin_unlock()         spin_unlock(&g_irq_spin)
+#  define irq_spin_lock_wo_note()   spin_lock_wo_note(&g_irq_spin)
+#  define irq_spin_unlock_wo_note() spin_unlock_wo_note(&g_irq_spin)
+#endif
+
 /* Handles nested calls to spin_lock_irqsave and spin_unlock_irqrestore */
 
 static volatile uint8_t g_irq_spin_count[CONFIG_SMP_NCPUS];
@@ -92,7 +109,7 @@ irqstate_t spin_lock_irqsave(spinlock_t *lock)
       int me = this_cpu();
       if (0 == g_irq_spin_count[me])
         {
-          spin_lock(&g_irq_spin);
+          irq_spin_lock();
         }
 
       g_irq_spin_count[me]++;
@@ -120,7 +137,7 @@ irqstate_t spin_lock_irqsave_wo_note(spinlock_t *lock)
       int me = this_cpu();
       if (0 == g_irq_spin_count[me])
         {
-          spin_lock_wo_note(&g_irq_spin);
+          irq_spin_lock_wo_note();
         }
 
       g_irq_spin_count[me]++;
@@ -173,7 +190,7 @@ void spin_unlock_irqrestore(spinlock_t *lock, irqstate_t flags)
 
       if (0 == g_irq_spin_count[me])
         {
-          spin_unlock(&g_irq_spin);
+          irq_spin_unlock();
         }
     }
   else
@@ -198,7 +215,7 @@ void spin_unlock_irqrestore_wo_note(spinlock_t *lock, irqstate_t flags)
 
       if (0 == g_irq_spin_count[me])
         {
-          spin_unlock_wo_note(&g_irq_spin);
+          irq_spin_unlock_wo_note();
         }
     }
   else
@@ -209,4 +226,159 @@ void spin_unlock_irqrestore_wo_note(spinlock_t *lock, irqstate_t flags)
   up_irq_restore(flags);
 }
 
+/****************************************************************************
+ * Name: ticket_lock_irqsave
+ *
+ * Description:
+ *   Disable local interrupts, take the ticket spinlock and return the
+ *   interrupt state.
+ *
+ * Input Parameters:
+ *   lock - Caller specific ticket spinlock.  Nested calls for the same
+ *          lock would cause a deadlock.
+ *
+ * Returned Value:
+ *   An opaque, architecture-specific value that represents the state of
+ *   the interrupts prior to the call to ticket_lock_irqsave(lock);
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_TICKET_SPINLOCK
+irqstate_t ticket_lock_irqsave(FAR ticketlock_t *lock)
+{
+  irqstate_t ret;
+  ret = up_irq_save();
+
+  ticket_lock(lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ticket_unlock_irqrestore
+ *
+ * Description:
+ *   Release the ticket spinlock and restore the interrupt state as it was
+ *   prior to the previous call to ticket_lock_irqsave(lock).
+ *
+ * Input Parameters:
+ *   lock  - Caller specific ticket spinlock.
+ *   flags - The architecture-specific value that represents the state of
+ *           the interrupts prior to the call to ticket_lock_irqsave(lock);
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ticket_unlock_irqrestore(FAR ticketlock_t *lock, irqstate_t flags)
+{
+  ticket_unlock(lock);
+  up_irq_restore(flags);
+}
+#endif
+
+/****************************************************************************
+ * Name: mcs_lock_irqsave
+ *
+ * Description:
+ *   Disable local interrupts, take the MCS spinlock and return the
+ *   interrupt state.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MCS_SPINLOCK
+irqstate_t mcs_lock_irqsave(FAR mcslock_t *lock,
+                            FAR struct mcs_node_s *node)
+{
+  irqstate_t ret;
+  ret = up_irq_save();
+
+  mcs_lock(lock, node);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mcs_unlock_irqrestore
+ *
+ * Description:
+ *   Release the MCS spinlock and restore the interrupt state.
+ *
+ ****************************************************************************/
+
+void mcs_unlock_irqrestore(FAR mcslock_t *lock, FAR struct mcs_node_s *node,
+                           irqstate_t flags)
+{
+  mcs_unlock(lock, node);
+  up_irq_restore(flags);
+}
+#endif
+
+/****************************************************************************
+ * Name: read_lock_irqsave
+ *
+ * Description:
+ *   Disable local interrupts, take the read-write spinlock for reading and
+ *   return the interrupt state.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RW_SPINLOCK
+irqstate_t read_lock_irqsave(FAR volatile rwlock_t *lock)
+{
+  irqstate_t ret;
+  ret = up_irq_save();
+
+  read_lock(lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: read_unlock_irqrestore
+ *
+ * Description:
+ *   Release the read-write spinlock held for reading and restore the
+ *   interrupt state.
+ *
+ ****************************************************************************/
+
+void read_unlock_irqrestore(FAR volatile rwlock_t *lock, irqstate_t flags)
+{
+  read_unlock(lock);
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: write_lock_irqsave
+ *
+ * Description:
+ *   Disable local interrupts, take the read-write spinlock for writing and
+ *   return the interrupt state.
+ *
+ ****************************************************************************/
+
+irqstate_t write_lock_irqsave(FAR volatile rwlock_t *lock)
+{
+  irqstate_t ret;
+  ret = up_irq_save();
+
+  write_lock(lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: write_unlock_irqrestore
+ *
+ * Description:
+ *   Release the read-write spinlock held for writing and restore the
+ *   interrupt state.
+ *
+ ****************************************************************************/
+
+void write_unlock_irqrestore(FAR volatile rwlock_t *lock, irqstate_t flags)
+{
+  write_unlock(lock);
+  up_irq_restore(flags);
+}
+#endif
+
 #endif /* CONFIG_SMP */
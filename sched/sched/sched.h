@@ -336,6 +336,25 @@ void nxsched_remove_blocked(FAR struct tcb_s *btcb);
 int  nxsched_set_priority(FAR struct tcb_s *tcb, int sched_priority);
 bool nxsched_reprioritize_rtr(FAR struct tcb_s *tcb, int priority);
 
+/* Priority bitmap index of the ready-to-run lists */
+
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+struct prioindex_s;
+FAR struct prioindex_s *nxsched_prioindex(FAR dq_queue_t *list);
+bool nxsched_prioindex_insert(FAR struct prioindex_s *index,
+                              FAR struct tcb_s *tcb, FAR dq_queue_t *list);
+void nxsched_remove_prioritized(FAR struct tcb_s *tcb, FAR dq_queue_t *list);
+void nxsched_addfirst_prioritized(FAR struct tcb_s *tcb,
+                                  FAR dq_queue_t *list);
+void nxsched_change_priority(FAR struct tcb_s *tcb, int priority);
+#else
+#  define nxsched_remove_prioritized(t,l) dq_rem((FAR dq_entry_t *)(t), l)
+#  define nxsched_addfirst_prioritized(t,l) \
+     dq_addfirst((FAR dq_entry_t *)(t), l)
+#  define nxsched_change_priority(t,p) \
+     ((t)->sched_priority = (uint8_t)(p))
+#endif
+
 /* Priority inheritance support */
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
@@ -385,6 +404,10 @@ FAR struct tcb_s *this_task(void);
 
 int  nxsched_select_cpu(cpu_set_t affinity);
 int  nxsched_pause_cpu(FAR struct tcb_s *tcb);
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+FAR struct tcb_s *nxsched_peek_task(int cpu, uint8_t minprio);
+FAR struct tcb_s *nxsched_steal_task(int cpu, uint8_t minprio);
+#endif
 
 #  define nxsched_islocked_global() spin_islocked(&g_cpu_schedlock)
 #  define nxsched_islocked_tcb(tcb) nxsched_islocked_global()
@@ -66,6 +66,9 @@ bool nxsched_add_prioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 {
   FAR struct tcb_s *next;
   FAR struct tcb_s *prev;
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+  FAR struct prioindex_s *index;
+#endif
   uint8_t sched_priority = tcb->sched_priority;
   bool ret = false;
 
@@ -73,6 +76,18 @@ bool nxsched_add_prioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 
   DEBUGASSERT(sched_priority >= SCHED_PRIORITY_MIN);
 
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+  /* Use the priority bitmap of the ready-to-run lists, if any, to find the
+   * insertion point without walking the list.
+   */
+
+  index = nxsched_prioindex(list);
+  if (index != NULL)
+    {
+      return nxsched_prioindex_insert(index, tcb, list);
+    }
+#endif
+
   /* Search the list to find the location to insert the new Tcb.
    * Each is list is maintained in descending sched_priority order.
    */
@@ -32,6 +32,20 @@
 #include "irq/irq.h"
 #include "sched/sched.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* A task preempted on a CPU stays in the g_assignedtasks[] list of that
+ * CPU if it is locked to the CPU or if per-CPU run queues are used.
+ */
+
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+#  define nxsched_keep_assigned(t) true
+#else
+#  define nxsched_keep_assigned(t) (((t)->flags & TCB_FLAG_CPU_LOCKED) != 0)
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -155,6 +169,7 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
   FAR dq_queue_t *tasklist;
   bool switched;
   bool doswitch;
+  bool pause;
   int task_state;
   int cpu;
   int me;
@@ -205,8 +220,16 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
 
   else
     {
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+      /* Queue it on the CPU running the lowest priority task.  It may
+       * still be stolen by another CPU before it runs.
+       */
+
+      task_state = TSTATE_TASK_ASSIGNED;
+#else
       task_state = TSTATE_TASK_READYTORUN;
       cpu        = 0;  /* CPU does not matter */
+#endif
     }
 
   /* If the selected state is TSTATE_TASK_RUNNING, then we would like to
@@ -252,10 +275,17 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
   else /* (task_state == TSTATE_TASK_ASSIGNED || task_state == TSTATE_TASK_RUNNING) */
     {
       /* If we are modifying some assigned task list other than our own, we
-       * will need to stop that CPU.
+       * will need to stop that CPU.  A task merely queued behind the
+       * running task of a per-CPU run queue does not touch the head of
+       * the list, so that CPU may keep running.
        */
 
-      if (cpu != me)
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+      pause = cpu != me && task_state == TSTATE_TASK_RUNNING;
+#else
+      pause = cpu != me;
+#endif
+      if (pause)
         {
           DEBUGVERIFY(up_cpu_pause(cpu));
         }
@@ -309,16 +339,16 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
            * this CPU already has a critical section
            */
 
-          /* If the following task is not locked to this CPU, then it must
-           * be moved to the g_readytorun list.  Since it cannot be at the
-           * head of the list, we can do this without invoking any heavy
-           * lifting machinery.
+          /* If the following task is not locked to this CPU (nor kept in
+           * a per-CPU run queue), then it must be moved to the g_readytorun
+           * list.  Since it cannot be at the head of the list, we can do
+           * this without invoking any heavy lifting machinery.
            */
 
           DEBUGASSERT(btcb->flink != NULL);
           next = btcb->flink;
 
-          if ((next->flags & TCB_FLAG_CPU_LOCKED) != 0)
+          if (nxsched_keep_assigned(next))
             {
               DEBUGASSERT(next->cpu == cpu);
               next->task_state = TSTATE_TASK_ASSIGNED;
@@ -327,7 +357,7 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
             {
               /* Remove the task from the assigned task list */
 
-              dq_rem((FAR dq_entry_t *)next, tasklist);
+              nxsched_remove_prioritized(next, tasklist);
 
               /* Add the task to the g_readytorun or to the g_pendingtasks
                * list.  NOTE: That the above operations may cause the
@@ -370,9 +400,13 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
 
       /* All done, restart the other CPU (if it was paused). */
 
-      if (cpu != me)
+      if (pause)
         {
           DEBUGVERIFY(up_cpu_resume(cpu));
+        }
+
+      if (cpu != me)
+        {
           doswitch = false;
         }
     }
@@ -105,4 +105,102 @@ int nxsched_select_cpu(cpu_set_t affinity)
   return cpu;
 }
 
+/****************************************************************************
+ * Name:  nxsched_peek_task
+ *
+ * Description:
+ *   Find the highest priority task that is queued, but not running, in the
+ *   run queue of some other CPU and that may migrate to 'cpu'.  The task is
+ *   left in its run queue.
+ *
+ * Input Parameters:
+ *   cpu     - The CPU that is looking for work.
+ *   minprio - The priority of the task that 'cpu' would run otherwise.
+ *
+ * Returned Value:
+ *   The TCB of a task whose priority is higher than 'minprio' or NULL if
+ *   there is no such task.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+FAR struct tcb_s *nxsched_peek_task(int cpu, uint8_t minprio)
+{
+  FAR struct tcb_s *found = NULL;
+  FAR struct tcb_s *tcb;
+  int i;
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      if (i == cpu)
+        {
+          continue;
+        }
+
+      /* Skip the running task at the head of the list.  The list is
+       * ordered by priority, so the first task that may migrate is the
+       * best candidate of this CPU.
+       */
+
+      for (tcb = ((FAR struct tcb_s *)g_assignedtasks[i].head)->flink;
+           tcb != NULL && tcb->sched_priority > minprio;
+           tcb = tcb->flink)
+        {
+          if ((tcb->flags & TCB_FLAG_CPU_LOCKED) == 0 &&
+              CPU_ISSET(cpu, &tcb->affinity))
+            {
+              break;
+            }
+        }
+
+      if (tcb != NULL && tcb->sched_priority > minprio)
+        {
+          found   = tcb;
+          minprio = tcb->sched_priority;
+        }
+    }
+
+  return found;
+}
+
+/****************************************************************************
+ * Name:  nxsched_steal_task
+ *
+ * Description:
+ *   Remove the task found by nxsched_peek_task() from the run queue of the
+ *   CPU that it is queued on.
+ *
+ * Input Parameters:
+ *   cpu     - The CPU that is looking for work.
+ *   minprio - The priority of the task that 'cpu' would run otherwise.
+ *
+ * Returned Value:
+ *   The TCB of the stolen task or NULL if there is no suitable task.  The
+ *   caller must add the TCB to the g_assignedtasks[] list of 'cpu'.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+FAR struct tcb_s *nxsched_steal_task(int cpu, uint8_t minprio)
+{
+  FAR struct tcb_s *stolen = nxsched_peek_task(cpu, minprio);
+
+  /* Removing a task behind the running one does not disturb the victim
+   * CPU, so there is no need to pause it.
+   */
+
+  if (stolen != NULL)
+    {
+      nxsched_remove_prioritized(stolen, &g_assignedtasks[stolen->cpu]);
+    }
+
+  return stolen;
+}
+#endif
+
 #endif /* CONFIG_SMP */
@@ -73,9 +73,11 @@
 bool nxsched_merge_pending(void)
 {
   FAR struct tcb_s *ptcb;
+#ifndef CONFIG_SCHED_PRIORITY_BITMAP
   FAR struct tcb_s *pnext;
-  FAR struct tcb_s *rtcb;
   FAR struct tcb_s *rprev;
+#endif
+  FAR struct tcb_s *rtcb;
   bool ret = false;
 
   /* Initialize the inner search loop */
@@ -89,6 +91,28 @@ bool nxsched_merge_pending(void)
 
   if (rtcb->lockcount == 0)
     {
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+      /* Move each pending task into its priority level of the ready-to-run
+       * list using the priority bitmap.
+       */
+
+      while ((ptcb = (FAR struct tcb_s *)dq_peek(&g_pendingtasks)) != NULL)
+        {
+          nxsched_remove_prioritized(ptcb, &g_pendingtasks);
+          if (nxsched_add_prioritized(ptcb, &g_readytorun))
+            {
+              /* Inserting ptcb at the head of the list */
+
+              ptcb->flink->task_state = TSTATE_TASK_READYTORUN;
+              ptcb->task_state        = TSTATE_TASK_RUNNING;
+              ret                     = true;
+            }
+          else
+            {
+              ptcb->task_state        = TSTATE_TASK_READYTORUN;
+            }
+        }
+#else
       for (ptcb = (FAR struct tcb_s *)g_pendingtasks.head;
            ptcb;
            ptcb = pnext)
@@ -153,6 +177,7 @@ bool nxsched_merge_pending(void)
 
       g_pendingtasks.head = NULL;
       g_pendingtasks.tail = NULL;
+#endif
     }
 
   return ret;
@@ -226,7 +251,8 @@ bool nxsched_merge_pending(void)
         {
           /* Remove the task from the pending task list */
 
-          tcb = (FAR struct tcb_s *)dq_remfirst(&g_pendingtasks);
+          tcb = (FAR struct tcb_s *)dq_peek(&g_pendingtasks);
+          nxsched_remove_prioritized(tcb, &g_pendingtasks);
 
           /* Add the pending task to the correct ready-to-run list. */
 
@@ -71,6 +71,24 @@ void nxsched_merge_prioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
 
   DEBUGASSERT(list1 != NULL && list2 != NULL);
 
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+  /* The priority bitmap makes each insertion constant time, so move the
+   * TCBs one at a time to keep the indexes of both lists up to date.
+   */
+
+  if (nxsched_prioindex(list2) != NULL)
+    {
+      while ((tmp = (FAR struct tcb_s *)dq_peek(list1)) != NULL)
+        {
+          nxsched_remove_prioritized(tmp, list1);
+          tmp->task_state = task_state;
+          nxsched_add_prioritized(tmp, list2);
+        }
+
+      return;
+    }
+#endif
+
   /* Get a private copy of list1, clearing list1.  We do this early so that
    * we can be assured that the list is stationary before we start any
    * operations on it.
@@ -0,0 +1,353 @@
+/****************************************************************************
+ * sched/sched/sched_prioindex.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <strings.h>
+#include <assert.h>
+
+#include <nuttx/queue.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PRIOINDEX_NLEVELS  (SCHED_PRIORITY_MAX + 1)
+#define PRIOINDEX_NWORDS   ((PRIOINDEX_NLEVELS + 31) >> 5)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The TCBs of one priority level are always contiguous in a prioritized
+ * list, so each level can be treated as a FIFO living inside of the list.
+ * The index records which levels are non-empty and where each FIFO ends.
+ */
+
+struct prioindex_s
+{
+  uint32_t bitmap[PRIOINDEX_NWORDS];         /* Set for non-empty levels */
+  FAR struct tcb_s *tail[PRIOINDEX_NLEVELS]; /* Last TCB of each level */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct prioindex_s g_readytorun_index;
+static struct prioindex_s g_pendingtasks_index;
+
+#ifdef CONFIG_SMP
+static struct prioindex_s g_assignedtasks_index[CONFIG_SMP_NCPUS];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_prioindex_add
+ *
+ * Description:
+ *   Account for a TCB that has just been linked into an indexed list at a
+ *   position consistent with its priority.
+ *
+ ****************************************************************************/
+
+static void nxsched_prioindex_add(FAR struct prioindex_s *index,
+                                  FAR struct tcb_s *tcb)
+{
+  uint8_t priority = tcb->sched_priority;
+  uint32_t bit = (uint32_t)1 << (priority & 31);
+  FAR uint32_t *word = &index->bitmap[priority >> 5];
+
+  if ((*word & bit) == 0)
+    {
+      /* First TCB at this priority level */
+
+      *word |= bit;
+      index->tail[priority] = tcb;
+    }
+  else if (index->tail[priority] == tcb->blink)
+    {
+      /* Appended after the previous end of the level */
+
+      index->tail[priority] = tcb;
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_prioindex_remove
+ *
+ * Description:
+ *   Account for a TCB that is about to be unlinked from an indexed list.
+ *
+ ****************************************************************************/
+
+static void nxsched_prioindex_remove(FAR struct prioindex_s *index,
+                                     FAR struct tcb_s *tcb)
+{
+  uint8_t priority = tcb->sched_priority;
+  FAR struct tcb_s *prev;
+
+  DEBUGASSERT((index->bitmap[priority >> 5] &
+               ((uint32_t)1 << (priority & 31))) != 0);
+
+  if (index->tail[priority] == tcb)
+    {
+      prev = tcb->blink;
+      if (prev != NULL && prev->sched_priority == priority)
+        {
+          index->tail[priority] = prev;
+        }
+      else
+        {
+          /* That was the last TCB at this priority level */
+
+          index->bitmap[priority >> 5] &= ~((uint32_t)1 << (priority & 31));
+          index->tail[priority] = NULL;
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_prioindex
+ *
+ * Description:
+ *   Return the priority index associated with a task list.
+ *
+ * Input Parameters:
+ *   list - Points to a prioritized task list
+ *
+ * Returned Value:
+ *   The priority index of the list or NULL if the list is not indexed.
+ *   Only g_readytorun, g_pendingtasks and g_assignedtasks[] are indexed.
+ *
+ ****************************************************************************/
+
+FAR struct prioindex_s *nxsched_prioindex(FAR dq_queue_t *list)
+{
+  if (list == &g_readytorun)
+    {
+      return &g_readytorun_index;
+    }
+  else if (list == &g_pendingtasks)
+    {
+      return &g_pendingtasks_index;
+    }
+#ifdef CONFIG_SMP
+  else if (list >= &g_assignedtasks[0] &&
+           list < &g_assignedtasks[CONFIG_SMP_NCPUS])
+    {
+      return &g_assignedtasks_index[list - g_assignedtasks];
+    }
+#endif
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: nxsched_prioindex_insert
+ *
+ * Description:
+ *   Insert a TCB into an indexed task list.  The new TCB is placed after
+ *   the last TCB of the lowest non-empty priority level that is greater
+ *   than or equal to its own priority, found with a find-first-set over
+ *   the level bitmap.
+ *
+ * Input Parameters:
+ *   index - The priority index of the list
+ *   tcb   - Points to the TCB to add
+ *   list  - Points to the indexed task list
+ *
+ * Returned Value:
+ *   true if the head of the list has changed.
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+bool nxsched_prioindex_insert(FAR struct prioindex_s *index,
+                              FAR struct tcb_s *tcb, FAR dq_queue_t *list)
+{
+  FAR struct tcb_s *prev = NULL;
+  int priority = tcb->sched_priority;
+  int ndx = priority >> 5;
+  uint32_t bits;
+
+  /* Ignore the levels below the priority of the new TCB */
+
+  bits = index->bitmap[ndx] & ~(((uint32_t)1 << (priority & 31)) - 1);
+  for (; ; )
+    {
+      if (bits != 0)
+        {
+          prev = index->tail[(ndx << 5) + ffs(bits) - 1];
+          break;
+        }
+
+      if (++ndx >= PRIOINDEX_NWORDS)
+        {
+          break;
+        }
+
+      bits = index->bitmap[ndx];
+    }
+
+  if (prev == NULL)
+    {
+      /* No TCB of equal or higher priority: The TCB becomes the new head */
+
+      dq_addfirst((FAR dq_entry_t *)tcb, list);
+    }
+  else
+    {
+      dq_addafter((FAR dq_entry_t *)prev, (FAR dq_entry_t *)tcb, list);
+    }
+
+  nxsched_prioindex_add(index, tcb);
+  return prev == NULL;
+}
+
+/****************************************************************************
+ * Name: nxsched_remove_prioritized
+ *
+ * Description:
+ *   Remove a TCB from a prioritized task list, updating the priority index
+ *   of the list if it has one.
+ *
+ * Input Parameters:
+ *   tcb  - Points to the TCB to remove
+ *   list - Points to the prioritized list that holds the TCB
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void nxsched_remove_prioritized(FAR struct tcb_s *tcb, FAR dq_queue_t *list)
+{
+  FAR struct prioindex_s *index = nxsched_prioindex(list);
+
+  if (index != NULL)
+    {
+      nxsched_prioindex_remove(index, tcb);
+    }
+
+  dq_rem((FAR dq_entry_t *)tcb, list);
+}
+
+/****************************************************************************
+ * Name: nxsched_addfirst_prioritized
+ *
+ * Description:
+ *   Add a TCB at the head of a prioritized task list.  The TCB must have
+ *   a priority greater than or equal to every TCB already in the list.
+ *
+ * Input Parameters:
+ *   tcb  - Points to the TCB to add
+ *   list - Points to the prioritized list
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void nxsched_addfirst_prioritized(FAR struct tcb_s *tcb,
+                                  FAR dq_queue_t *list)
+{
+  FAR struct prioindex_s *index = nxsched_prioindex(list);
+
+  DEBUGASSERT(list->head == NULL ||
+              tcb->sched_priority >=
+              ((FAR struct tcb_s *)list->head)->sched_priority);
+
+  dq_addfirst((FAR dq_entry_t *)tcb, list);
+
+  if (index != NULL)
+    {
+      nxsched_prioindex_add(index, tcb);
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_change_priority
+ *
+ * Description:
+ *   Change the priority of a ready-to-run TCB without moving it within its
+ *   task list.  This is used for the running task when the new priority
+ *   keeps the list ordered.
+ *
+ * Input Parameters:
+ *   tcb      - Points to the TCB to reprioritize
+ *   priority - The new task priority
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void nxsched_change_priority(FAR struct tcb_s *tcb, int priority)
+{
+  FAR struct prioindex_s *index;
+
+#ifdef CONFIG_SMP
+  index = nxsched_prioindex(TLIST_HEAD(tcb, tcb->cpu));
+#else
+  index = nxsched_prioindex(TLIST_HEAD(tcb));
+#endif
+
+  if (index != NULL)
+    {
+      nxsched_prioindex_remove(index, tcb);
+    }
+
+  tcb->sched_priority = (uint8_t)priority;
+
+  if (index != NULL)
+    {
+      nxsched_prioindex_add(index, tcb);
+    }
+}
+
+#endif /* CONFIG_SCHED_PRIORITY_BITMAP */
@@ -91,7 +91,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb, bool merge)
    * is always the g_readytorun list.
    */
 
-  dq_rem((FAR dq_entry_t *)rtcb, tasklist);
+  nxsched_remove_prioritized(rtcb, tasklist);
 
   /* Since the TCB is not in any list, it is now invalid */
 
@@ -188,7 +188,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb, bool merge)
        * or the g_assignedtasks[cpu] list.
        */
 
-      dq_rem((FAR dq_entry_t *)rtcb, tasklist);
+      nxsched_remove_prioritized(rtcb, tasklist);
 
       /* Which task will go at the head of the list?  It will be either the
        * next tcb in the assigned task list (nxttcb) or a TCB in the
@@ -225,13 +225,29 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb, bool merge)
            * list and add to the head of the g_assignedtasks[cpu] list.
            */
 
-          dq_rem((FAR dq_entry_t *)rtrtcb, &g_readytorun);
-          dq_addfirst((FAR dq_entry_t *)rtrtcb, tasklist);
+          nxsched_remove_prioritized(rtrtcb, &g_readytorun);
+          nxsched_addfirst_prioritized(rtrtcb, tasklist);
 
           rtrtcb->cpu = cpu;
           nxttcb = rtrtcb;
         }
 
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+      /* Otherwise, steal a higher priority task queued on another CPU, if
+       * any.  This is how an otherwise idle CPU picks up work.
+       */
+
+      else if (!nxsched_islocked_global() && !irq_cpu_locked(me) &&
+               (rtrtcb = nxsched_steal_task(cpu,
+                                            nxttcb->sched_priority)) != NULL)
+        {
+          nxsched_addfirst_prioritized(rtrtcb, tasklist);
+
+          rtrtcb->cpu = cpu;
+          nxttcb = rtrtcb;
+        }
+#endif
+
       /* Will pre-emption be disabled after the switch?  If the lockcount is
        * greater than zero, then this task/this CPU holds the scheduler lock.
        */
@@ -279,7 +295,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb, bool merge)
        * g_assignedtasks[cpu] list.
        */
 
-      dq_rem((FAR dq_entry_t *)rtcb, tasklist);
+      nxsched_remove_prioritized(rtcb, tasklist);
     }
 
   /* Since the TCB is no longer in any list, it is now invalid */
@@ -37,6 +37,21 @@
 
 #if CONFIG_RR_INTERVAL > 0
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* With per-CPU run queues, a task of the same priority may be queued on
+ * another CPU instead of behind the running task.
+ */
+
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+#  define nxsched_rr_queued(t) \
+     (nxsched_peek_task((t)->cpu, (t)->sched_priority - 1) != NULL)
+#else
+#  define nxsched_rr_queued(t) false
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -126,8 +141,9 @@ uint32_t nxsched_process_roundrobin(FAR struct tcb_s *tcb, uint32_t ticks,
            * give that task a shot.
            */
 
-          if (tcb->flink &&
-              tcb->flink->sched_priority >= tcb->sched_priority)
+          if ((tcb->flink &&
+               tcb->flink->sched_priority >= tcb->sched_priority) ||
+              nxsched_rr_queued(tcb))
             {
               FAR struct tcb_s *rtcb = this_task();
 
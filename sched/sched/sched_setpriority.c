@@ -60,9 +60,9 @@ static FAR struct tcb_s *nxsched_nexttcb(FAR struct tcb_s *tcb)
   FAR struct tcb_s *rtrtcb;
 
   /* Which task should run next?  It will be either the next tcb in the
-   * assigned task list (nxttcb) or a TCB in the g_readytorun list.  We can
-   * only select a task from that list if the affinity mask includes the
-   * tcb->cpu.
+   * assigned task list (nxttcb) or a TCB in the g_readytorun list (or in
+   * the run queue of another CPU).  We can only select a task from that
+   * list if the affinity mask includes the tcb->cpu.
    *
    * If pre-emption is locked or another CPU is in a critical section,
    * then use the 'nxttcb' which will probably be the IDLE thread.
@@ -85,6 +85,19 @@ static FAR struct tcb_s *nxsched_nexttcb(FAR struct tcb_s *tcb)
         {
           return rtrtcb;
         }
+
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+      /* With per-CPU run queues, a higher priority task may be queued
+       * behind the running task of another CPU.  nxsched_remove_readytorun()
+       * will steal that task when tcb is removed.
+       */
+
+      rtrtcb = nxsched_peek_task(tcb->cpu, nxttcb->sched_priority);
+      if (rtrtcb != NULL)
+        {
+          return rtrtcb;
+        }
+#endif
     }
 
   /* Otherwise, return the next TCB in the g_assignedtasks[] list...
@@ -167,7 +180,7 @@ static inline void nxsched_running_setpriority(FAR struct tcb_s *tcb,
 
           /* Change the task priority */
 
-          tcb->sched_priority = (uint8_t)sched_priority;
+          nxsched_change_priority(tcb, sched_priority);
         }
       else
         {
@@ -186,7 +199,7 @@ static inline void nxsched_running_setpriority(FAR struct tcb_s *tcb,
     {
       /* Change the task priority */
 
-      tcb->sched_priority = (uint8_t)sched_priority;
+      nxsched_change_priority(tcb, sched_priority);
     }
 }
 
@@ -215,6 +228,27 @@ static void nxsched_readytorun_setpriority(FAR struct tcb_s *tcb,
 #ifdef CONFIG_SMP
   int cpu;
 
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+  /* With per-CPU run queues, a task that is not locked to a CPU is queued
+   * again on the CPU that nxsched_add_readytorun() selects for its new
+   * priority.  That need not be the CPU it was queued on, and the task may
+   * become the running task of either one.  nxsched_add_readytorun()
+   * pauses another CPU that has to switch, so only this CPU is left to
+   * us.
+   */
+
+  if ((tcb->flags & TCB_FLAG_CPU_LOCKED) == 0)
+    {
+      rtcb = this_task();
+      if (nxsched_reprioritize_rtr(tcb, sched_priority))
+        {
+          up_switch_context(this_task(), rtcb);
+        }
+
+      return;
+    }
+#endif
+
   /* CASE 2a. The task is ready-to-run (but not running) but not assigned to
    * a CPU. An increase in priority could cause a context switch may be
    * caused by the re-prioritization.  The task is not assigned and may run
@@ -965,7 +965,7 @@ void nxsem_release_all(FAR struct tcb_s *htcb)
        * that was taken by sem_wait() or sem_post().
        */
 
-      sem->semcount++;
+      nxsem_count_inc(sem);
     }
 }
 
@@ -78,6 +78,17 @@ int nxsem_post(FAR sem_t *sem)
 
   DEBUGASSERT(sem != NULL);
 
+  /* Release an uncontended mutex without entering the critical section */
+
+  if (NXSEM_FASTPATH(sem))
+    {
+      sem_count = 0;
+      if (nxsem_count_cmpxchg(sem, &sem_count, 1))
+        {
+          return OK;
+        }
+    }
+
   /* The following operations must be performed with interrupts
    * disabled because sem_post() may be called from an interrupt
    * handler.
@@ -113,8 +124,7 @@ int nxsem_post(FAR sem_t *sem)
    */
 
   nxsem_release_holder(sem);
-  sem_count++;
-  sem->semcount = sem_count;
+  sem_count = nxsem_count_inc(sem) + 1;
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
   /* Don't let any unblocked tasks run until we complete any priority
@@ -97,7 +97,7 @@ void nxsem_recover(FAR struct tcb_s *tcb)
        * place.
        */
 
-      sem->semcount++;
+      nxsem_count_inc(sem);
     }
 
   /* Release all semphore holders for the task */
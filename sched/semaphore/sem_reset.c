@@ -58,6 +58,7 @@
 int nxsem_reset(FAR sem_t *sem, int16_t count)
 {
   irqstate_t flags;
+  int16_t semcount;
 
   DEBUGASSERT(sem != NULL && count >= 0);
 
@@ -93,13 +94,13 @@ int nxsem_reset(FAR sem_t *sem, int16_t count)
    * (i.e., with sem->semcount >= 0).  In this case, 'count' holds the
    * the new value of the semaphore count.  OR (2) with threads still
    * waiting but all of the semaphore counts exhausted:  The current
-   * value of sem->semcount is already correct in this case.
+   * value of sem->semcount is already correct in this case.  The count
+   * may still be changed by the fast path of a mutex, so it is replaced
+   * atomically.
    */
 
-  if (sem->semcount >= 0)
-    {
-      sem->semcount = count;
-    }
+  semcount = sem->semcount;
+  while (semcount >= 0 && !nxsem_count_cmpxchg(sem, &semcount, count));
 
   /* Allow any pending context switches to occur now */
 
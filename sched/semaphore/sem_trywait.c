@@ -68,6 +68,7 @@ int nxsem_trywait(FAR sem_t *sem)
 {
   FAR struct tcb_s *rtcb = this_task();
   irqstate_t flags;
+  int16_t count;
   int ret;
 
   /* This API should not be called from the idleloop */
@@ -76,6 +77,18 @@ int nxsem_trywait(FAR sem_t *sem)
   DEBUGASSERT(!OSINIT_IDLELOOP() || !sched_idletask() ||
               up_interrupt_context());
 
+  /* Take an uncontended mutex without entering the critical section */
+
+  if (NXSEM_FASTPATH(sem))
+    {
+      count = 1;
+      if (nxsem_count_cmpxchg(sem, &count, 0))
+        {
+          rtcb->waitobj = NULL;
+          return OK;
+        }
+    }
+
   /* The following operations must be performed with interrupts disabled
    * because sem_post() may be called from an interrupt handler.
    */
@@ -84,20 +97,20 @@ int nxsem_trywait(FAR sem_t *sem)
 
   /* If the semaphore is available, give it to the requesting task */
 
-  if (sem->semcount > 0)
-    {
-      /* It is, let the task take the semaphore */
+  ret   = -EAGAIN;
+  count = sem->semcount;
 
-      sem->semcount--;
-      nxsem_add_holder(sem);
-      rtcb->waitobj = NULL;
-      ret = OK;
-    }
-  else
+  while (count > 0)
     {
-      /* Semaphore is not available */
+      /* It is, let the task take the semaphore */
 
-      ret = -EAGAIN;
+      if (nxsem_count_cmpxchg(sem, &count, count - 1))
+        {
+          nxsem_add_holder(sem);
+          rtcb->waitobj = NULL;
+          ret = OK;
+          break;
+        }
     }
 
   /* Interrupts may now be enabled. */
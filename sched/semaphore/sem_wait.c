@@ -80,6 +80,19 @@ int nxsem_wait(FAR sem_t *sem)
   DEBUGASSERT(sem != NULL && up_interrupt_context() == false);
   DEBUGASSERT(!OSINIT_IDLELOOP() || !sched_idletask());
 
+  /* Take an uncontended mutex without entering the critical section */
+
+  if (NXSEM_FASTPATH(sem))
+    {
+      int16_t count = 1;
+
+      if (nxsem_count_cmpxchg(sem, &count, 0))
+        {
+          rtcb->waitobj = NULL;
+          return OK;
+        }
+    }
+
   /* The following operations must be performed with interrupts
    * disabled because nxsem_post() may be called from an interrupt
    * handler.
@@ -87,15 +100,15 @@ int nxsem_wait(FAR sem_t *sem)
 
   flags = enter_critical_section();
 
-  /* Make sure we were supplied with a valid semaphore. */
-
-  /* Check if the lock is available */
+  /* Check if the lock is available.  The count is decremented in either
+   * case, a count that was not positive makes this task a waiter (but
+   * does not set the owner yet).
+   */
 
-  if (sem->semcount > 0)
+  if (nxsem_count_dec(sem) > 0)
     {
       /* It is, let the task take the semaphore. */
 
-      sem->semcount--;
       nxsem_add_holder(sem);
       rtcb->waitobj = NULL;
       ret = OK;
@@ -117,10 +130,6 @@ int nxsem_wait(FAR sem_t *sem)
 
       DEBUGASSERT(rtcb->waitobj == NULL);
 
-      /* Handle the POSIX semaphore (but don't set the owner yet) */
-
-      sem->semcount--;
-
       /* Save the waited on semaphore in the TCB */
 
       rtcb->waitobj = sem;
@@ -33,6 +33,74 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* A mutex without priority inheritance keeps no holder list and its count
+ * is only changed by the logic in this directory.  On SMP, an uncontended
+ * mutex is therefore taken and released with one atomic update of
+ * semcount, without entering the critical section.  Every other update of
+ * semcount here must be atomic as well so that it does not race with that
+ * fast path.
+ *
+ * Without SMP, entering the critical section only disables local
+ * interrupts, so the fast path is not used and semcount is updated with
+ * plain accesses.  That keeps cores without sub-word atomics from calling
+ * into libatomic.
+ */
+
+#ifndef CONFIG_SMP
+#  define NXSEM_FASTPATH(s) false
+#elif defined(CONFIG_PRIORITY_INHERITANCE)
+#  define NXSEM_FASTPATH(s) \
+     (((s)->flags & (SEM_TYPE_MUTEX | SEM_PRIO_MASK)) == SEM_TYPE_MUTEX)
+#else
+#  define NXSEM_FASTPATH(s) (((s)->flags & SEM_TYPE_MUTEX) != 0)
+#endif
+
+#ifdef CONFIG_SMP
+#  define nxsem_count_inc(s) \
+     __atomic_fetch_add(&(s)->semcount, 1, __ATOMIC_RELEASE)
+#  define nxsem_count_dec(s) \
+     __atomic_fetch_sub(&(s)->semcount, 1, __ATOMIC_ACQUIRE)
+#  define nxsem_count_cmpxchg(s,o,n) \
+     __atomic_compare_exchange_n(&(s)->semcount, (o), (n), false, \
+                                 __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)
+#else
+#  define nxsem_count_inc(s) ((s)->semcount++)
+#  define nxsem_count_dec(s) ((s)->semcount--)
+#endif
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsem_count_cmpxchg
+ *
+ * Description:
+ *   Replace the count of the semaphore with 'count' if it is still '*old'.
+ *   Otherwise return the current count in '*old'.  Without SMP this is
+ *   only called from within the critical section.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_SMP
+static inline bool nxsem_count_cmpxchg(FAR sem_t *sem, FAR int16_t *old,
+                                       int16_t count)
+{
+  if (sem->semcount != *old)
+    {
+      *old = sem->semcount;
+      return false;
+    }
+
+  sem->semcount = count;
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
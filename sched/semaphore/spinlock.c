@@ -73,8 +73,16 @@ void spin_lock(FAR volatile spinlock_t *lock)
 
   while (up_testset(lock) == SP_LOCKED)
     {
-      SP_DSB();
-      SP_WFE();
+      /* Wait until the lock looks free before trying the test-and-set
+       * again so that the waiting CPUs only read the cache line.
+       */
+
+      do
+        {
+          SP_DSB();
+          SP_WFE();
+        }
+      while (*lock == SP_LOCKED);
     }
 
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
@@ -111,8 +119,16 @@ void spin_lock_wo_note(FAR volatile spinlock_t *lock)
 {
   while (up_testset(lock) == SP_LOCKED)
     {
-      SP_DSB();
-      SP_WFE();
+      /* Wait until the lock looks free before trying the test-and-set
+       * again so that the waiting CPUs only read the cache line.
+       */
+
+      do
+        {
+          SP_DSB();
+          SP_WFE();
+        }
+      while (*lock == SP_LOCKED);
     }
 
   SP_DMB();
@@ -384,4 +400,433 @@ void spin_clrbit(FAR volatile cpu_set_t *set, unsigned int cpu,
 }
 #endif
 
+/****************************************************************************
+ * Name: ticket_lock
+ *
+ * Description:
+ *   Take a ticket and loop until the ticket spinlock is granted to it.
+ *   Waiters acquire the lock in FIFO order.
+ *
+ *   This implementation is non-reentrant and is prone to deadlocks in
+ *   the case that any logic on the same CPU attempts to take the lock
+ *   more than once.
+ *
+ * Input Parameters:
+ *   lock - A reference to the ticket spinlock object to lock.
+ *
+ * Returned Value:
+ *   None.  When the function returns, the spinlock was successfully locked
+ *   by this CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_TICKET_SPINLOCK
+void ticket_lock(FAR ticketlock_t *lock)
+{
+  uint16_t ticket;
+
+  ticket = __atomic_fetch_add(&lock->tickets.next, 1, __ATOMIC_RELAXED);
+
+  while (__atomic_load_n(&lock->tickets.owner, __ATOMIC_ACQUIRE) != ticket)
+    {
+      SP_DSB();
+      SP_WFE();
+    }
+
+  SP_DMB();
+}
+
+/****************************************************************************
+ * Name: ticket_trylock
+ *
+ * Description:
+ *   Try once to lock the ticket spinlock.  Do not wait if the spinlock is
+ *   already locked or has waiters.
+ *
+ * Input Parameters:
+ *   lock - A reference to the ticket spinlock object to lock.
+ *
+ * Returned Value:
+ *   SP_LOCKED   - Failure, the spinlock was already locked
+ *   SP_UNLOCKED - Success, the spinlock was successfully locked
+ *
+ ****************************************************************************/
+
+spinlock_t ticket_trylock(FAR ticketlock_t *lock)
+{
+  ticketlock_t old;
+  ticketlock_t new;
+
+  old.value = __atomic_load_n(&lock->value, __ATOMIC_RELAXED);
+  if (old.tickets.owner != old.tickets.next)
+    {
+      SP_DSB();
+      return SP_LOCKED;
+    }
+
+  /* Take the next ticket only if nobody else took one in the meantime */
+
+  new = old;
+  new.tickets.next++;
+
+  if (!__atomic_compare_exchange_n(&lock->value, &old.value, new.value,
+                                   false, __ATOMIC_ACQUIRE,
+                                   __ATOMIC_RELAXED))
+    {
+      SP_DSB();
+      return SP_LOCKED;
+    }
+
+  SP_DMB();
+  return SP_UNLOCKED;
+}
+
+/****************************************************************************
+ * Name: ticket_unlock
+ *
+ * Description:
+ *   Release the ticket spinlock, granting it to the next waiter.
+ *
+ * Input Parameters:
+ *   lock - A reference to the ticket spinlock object to unlock.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void ticket_unlock(FAR ticketlock_t *lock)
+{
+  /* Only the holder modifies the owner field */
+
+  SP_DMB();
+  __atomic_store_n(&lock->tickets.owner, lock->tickets.owner + 1,
+                   __ATOMIC_RELEASE);
+  SP_DSB();
+  SP_SEV();
+}
+#endif /* CONFIG_TICKET_SPINLOCK */
+
+/****************************************************************************
+ * Name: mcs_lock
+ *
+ * Description:
+ *   Queue behind the current holder and waiters of the MCS spinlock and
+ *   loop until the lock is handed over.  Waiters acquire the lock in FIFO
+ *   order and each spins on its own queue node.
+ *
+ *   This implementation is non-reentrant and is prone to deadlocks in
+ *   the case that any logic on the same CPU attempts to take the lock
+ *   more than once.
+ *
+ * Input Parameters:
+ *   lock - A reference to the MCS spinlock object to lock.
+ *   node - The queue node of the caller.  It must remain valid until the
+ *          matching mcs_unlock() returns.
+ *
+ * Returned Value:
+ *   None.  When the function returns, the spinlock was successfully locked
+ *   by this CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MCS_SPINLOCK
+void mcs_lock(FAR mcslock_t *lock, FAR struct mcs_node_s *node)
+{
+  FAR struct mcs_node_s *prev;
+
+  node->next   = NULL;
+  node->locked = 1;
+
+  prev = __atomic_exchange_n(lock, node, __ATOMIC_ACQ_REL);
+  if (prev != NULL)
+    {
+      /* Link behind the previous tail and wait for it to hand over */
+
+      __atomic_store_n(&prev->next, node, __ATOMIC_RELEASE);
+
+      while (__atomic_load_n(&node->locked, __ATOMIC_ACQUIRE) != 0)
+        {
+          SP_DSB();
+          SP_WFE();
+        }
+    }
+
+  SP_DMB();
+}
+
+/****************************************************************************
+ * Name: mcs_trylock
+ *
+ * Description:
+ *   Try once to lock the MCS spinlock.  Do not wait if the spinlock is
+ *   already locked.
+ *
+ * Input Parameters:
+ *   lock - A reference to the MCS spinlock object to lock.
+ *   node - The queue node of the caller.
+ *
+ * Returned Value:
+ *   SP_LOCKED   - Failure, the spinlock was already locked
+ *   SP_UNLOCKED - Success, the spinlock was successfully locked
+ *
+ ****************************************************************************/
+
+spinlock_t mcs_trylock(FAR mcslock_t *lock, FAR struct mcs_node_s *node)
+{
+  FAR struct mcs_node_s *old = NULL;
+
+  node->next   = NULL;
+  node->locked = 0;
+
+  if (!__atomic_compare_exchange_n(lock, &old, node, false,
+                                   __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+      SP_DSB();
+      return SP_LOCKED;
+    }
+
+  SP_DMB();
+  return SP_UNLOCKED;
+}
+
+/****************************************************************************
+ * Name: mcs_unlock
+ *
+ * Description:
+ *   Release the MCS spinlock, handing it over to the next waiter.
+ *
+ * Input Parameters:
+ *   lock - A reference to the MCS spinlock object to unlock.
+ *   node - The queue node that was passed to mcs_lock() or mcs_trylock().
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void mcs_unlock(FAR mcslock_t *lock, FAR struct mcs_node_s *node)
+{
+  FAR struct mcs_node_s *next;
+
+  SP_DMB();
+
+  next = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+  if (next == NULL)
+    {
+      FAR struct mcs_node_s *old = node;
+
+      /* No known waiter, release the lock if we are still the tail */
+
+      if (__atomic_compare_exchange_n(lock, &old, NULL, false,
+                                      __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        {
+          return;
+        }
+
+      /* A waiter has swapped itself in but has not linked yet */
+
+      while ((next = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE)) ==
+             NULL)
+        {
+          SP_DSB();
+        }
+    }
+
+  __atomic_store_n(&next->locked, 0, __ATOMIC_RELEASE);
+  SP_DSB();
+  SP_SEV();
+}
+#endif /* CONFIG_MCS_SPINLOCK */
+
+/****************************************************************************
+ * Name: read_lock
+ *
+ * Description:
+ *   Loop until the read-write spinlock is taken for reading.  Any number
+ *   of readers may hold the lock at the same time, but not while a writer
+ *   holds it or waits for it.  A CPU must therefore not take the lock for
+ *   reading again while it already holds it.
+ *
+ * Input Parameters:
+ *   lock - A reference to the read-write spinlock object to lock.
+ *
+ * Returned Value:
+ *   None.  When the function returns, the spinlock was successfully locked
+ *   for reading by this CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RW_SPINLOCK
+void read_lock(FAR volatile rwlock_t *lock)
+{
+  while (!read_trylock(lock))
+    {
+      /* Wait for the writers to leave without writing the cache line */
+
+      do
+        {
+          SP_DSB();
+          SP_WFE();
+        }
+      while (*lock < 0 || (*lock & RW_SP_WRITE_WAITING) != 0);
+    }
+}
+
+/****************************************************************************
+ * Name: read_trylock
+ *
+ * Description:
+ *   Try once to take the read-write spinlock for reading.
+ *
+ * Input Parameters:
+ *   lock - A reference to the read-write spinlock object to lock.
+ *
+ * Returned Value:
+ *   true  - Success, the spinlock was locked for reading
+ *   false - Failure, the spinlock is held or awaited by a writer
+ *
+ ****************************************************************************/
+
+bool read_trylock(FAR volatile rwlock_t *lock)
+{
+  rwlock_t old = __atomic_load_n(lock, __ATOMIC_RELAXED);
+
+  /* Retry if another reader changed the count under us */
+
+  while (old >= 0 && (old & RW_SP_WRITE_WAITING) == 0)
+    {
+      if (__atomic_compare_exchange_n(lock, &old, old + 1, false,
+                                      __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+          SP_DMB();
+          return true;
+        }
+    }
+
+  SP_DSB();
+  return false;
+}
+
+/****************************************************************************
+ * Name: read_unlock
+ *
+ * Description:
+ *   Release a read-write spinlock held for reading.
+ *
+ * Input Parameters:
+ *   lock - A reference to the read-write spinlock object to unlock.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void read_unlock(FAR volatile rwlock_t *lock)
+{
+  DEBUGASSERT(*lock > 0 &&
+              (*lock & ~RW_SP_WRITE_WAITING) >= RW_SP_READ_LOCKED);
+
+  SP_DMB();
+  __atomic_fetch_sub(lock, 1, __ATOMIC_RELEASE);
+  SP_DSB();
+  SP_SEV();
+}
+
+/****************************************************************************
+ * Name: write_lock
+ *
+ * Description:
+ *   Loop until the read-write spinlock is taken for writing.  A writer
+ *   keeps new readers out and waits until there are neither readers nor
+ *   another writer.
+ *
+ * Input Parameters:
+ *   lock - A reference to the read-write spinlock object to lock.
+ *
+ * Returned Value:
+ *   None.  When the function returns, the spinlock was successfully locked
+ *   for writing by this CPU.
+ *
+ ****************************************************************************/
+
+void write_lock(FAR volatile rwlock_t *lock)
+{
+  while (!write_trylock(lock))
+    {
+      /* Keep new readers out.  This does not change a lock held by a
+       * writer, RW_SP_WRITE_LOCKED already has every bit set.
+       */
+
+      __atomic_fetch_or(lock, RW_SP_WRITE_WAITING, __ATOMIC_RELAXED);
+
+      /* Wait for the lock to be released without writing the cache line */
+
+      do
+        {
+          SP_DSB();
+          SP_WFE();
+        }
+      while (*lock != RW_SP_UNLOCKED && *lock != RW_SP_WRITE_WAITING);
+    }
+}
+
+/****************************************************************************
+ * Name: write_trylock
+ *
+ * Description:
+ *   Try once to take the read-write spinlock for writing.
+ *
+ * Input Parameters:
+ *   lock - A reference to the read-write spinlock object to lock.
+ *
+ * Returned Value:
+ *   true  - Success, the spinlock was locked for writing
+ *   false - Failure, the spinlock is held by readers or a writer
+ *
+ ****************************************************************************/
+
+bool write_trylock(FAR volatile rwlock_t *lock)
+{
+  rwlock_t old = __atomic_load_n(lock, __ATOMIC_RELAXED);
+
+  /* The lock is free if there are no readers, even if a writer waits */
+
+  if ((old == RW_SP_UNLOCKED || old == RW_SP_WRITE_WAITING) &&
+      __atomic_compare_exchange_n(lock, &old, RW_SP_WRITE_LOCKED, false,
+                                  __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+      SP_DMB();
+      return true;
+    }
+
+  SP_DSB();
+  return false;
+}
+
+/****************************************************************************
+ * Name: write_unlock
+ *
+ * Description:
+ *   Release a read-write spinlock held for writing.
+ *
+ * Input Parameters:
+ *   lock - A reference to the read-write spinlock object to unlock.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void write_unlock(FAR volatile rwlock_t *lock)
+{
+  DEBUGASSERT(*lock == RW_SP_WRITE_LOCKED);
+
+  SP_DMB();
+  __atomic_store_n(lock, RW_SP_UNLOCKED, __ATOMIC_RELEASE);
+  SP_DSB();
+  SP_SEV();
+}
+#endif /* CONFIG_RW_SPINLOCK */
+
 #endif /* CONFIG_SPINLOCK */
@@ -39,6 +39,83 @@
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: wd_dequeue
+ *
+ * Description:
+ *   Remove an active watchdog from the timer queue without marking it
+ *   inactive.
+ *
+ * Input Parameters:
+ *   wdog - The active watchdog to remove
+ *
+ * Returned Value:
+ *   true if the watchdog was at the head of the timer queue.
+ *
+ * Assumptions:
+ *   The caller holds the watchdog lock (see wd_lock()).
+ *
+ ****************************************************************************/
+
+bool wd_dequeue(FAR struct wdog_s *wdog)
+{
+#ifdef CONFIG_WDOG_RBTREE
+  bool head = (wdog == g_wdactivehead);
+
+  /* Remove the watchdog from the timer tree */
+
+  wd_remove(wdog);
+  return head;
+#else
+  FAR struct wdog_s *curr;
+  FAR struct wdog_s *prev;
+
+  /* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
+   * to do this because there are additional operations that need to be
+   * done.
+   */
+
+  prev = NULL;
+  curr = (FAR struct wdog_s *)g_wdactivelist.head;
+
+  while ((curr) && (curr != wdog))
+    {
+      prev = curr;
+      curr = curr->next;
+    }
+
+  /* Check if the watchdog was found in the list.  If not, then an OS
+   * error has occurred because the watchdog is marked active!
+   */
+
+  DEBUGASSERT(curr);
+
+  /* If there is a watchdog in the timer queue after the one that
+   * is being canceled, then it inherits the remaining ticks.
+   */
+
+  if (curr->next)
+    {
+      curr->next->lag += curr->lag;
+    }
+
+  /* Now, remove the watchdog from the timer queue */
+
+  if (prev)
+    {
+      /* Remove the watchdog from mid- or end-of-queue */
+
+      sq_remafter((FAR sq_entry_t *)prev, &g_wdactivelist);
+      return false;
+    }
+
+  /* Remove the watchdog at the head of the queue */
+
+  sq_remfirst(&g_wdactivelist);
+  return true;
+#endif
+}
+
 /****************************************************************************
  * Name: wd_cancel
  *
@@ -46,6 +123,10 @@
  *   This function cancels a currently running watchdog timer. Watchdog
  *   timers may be canceled from the interrupt level.
  *
+ *   If the watchdog function is being called on another CPU, wd_cancel()
+ *   waits for it to return, so the watchdog and its argument may be freed
+ *   or reused afterwards.
+ *
  * Input Parameters:
  *   wdog - ID of the watchdog to cancel.
  *
@@ -57,8 +138,10 @@
 
 int wd_cancel(FAR struct wdog_s *wdog)
 {
-  FAR struct wdog_s *curr;
-  FAR struct wdog_s *prev;
+#if defined(CONFIG_SMP) && !defined(CONFIG_SCHED_TICKLESS)
+  irqstate_t csflags = 0;
+  bool csection = false;
+#endif
   irqstate_t flags;
   int ret = -EINVAL;
 
@@ -66,7 +149,23 @@ int wd_cancel(FAR struct wdog_s *wdog)
    * cancellation is complete
    */
 
-  flags = enter_critical_section();
+  flags = wd_lock();
+
+#if defined(CONFIG_SMP) && !defined(CONFIG_SCHED_TICKLESS)
+  /* Watchdog functions run within the critical section but without the
+   * watchdog lock.  If the function of this watchdog is running, enter
+   * the critical section too.  That waits for the function to return,
+   * unless it is this CPU that is running it.
+   */
+
+  if (wdog != NULL && wdog == g_wdrunning)
+    {
+      wd_unlock(flags);
+      csflags  = enter_critical_section();
+      csection = true;
+      flags    = wd_lock();
+    }
+#endif
 
   /* Make sure that the watchdog is initialized (non-NULL) and is still
    * active.
@@ -74,53 +173,13 @@ int wd_cancel(FAR struct wdog_s *wdog)
 
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
-      /* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
-       * to do this because there are additional operations that need to be
-       * done.
+      /* Remove the watchdog from the timer queue.  Reassess the interval
+       * timer that will generate the next interval event if the earliest
+       * watchdog was removed.
        */
 
-      prev = NULL;
-      curr = (FAR struct wdog_s *)g_wdactivelist.head;
-
-      while ((curr) && (curr != wdog))
+      if (wd_dequeue(wdog))
         {
-          prev = curr;
-          curr = curr->next;
-        }
-
-      /* Check if the watchdog was found in the list.  If not, then an OS
-       * error has occurred because the watchdog is marked active!
-       */
-
-      DEBUGASSERT(curr);
-
-      /* If there is a watchdog in the timer queue after the one that
-       * is being canceled, then it inherits the remaining ticks.
-       */
-
-      if (curr->next)
-        {
-          curr->next->lag += curr->lag;
-        }
-
-      /* Now, remove the watchdog from the timer queue */
-
-      if (prev)
-        {
-          /* Remove the watchdog from mid- or end-of-queue */
-
-          sq_remafter((FAR sq_entry_t *)prev, &g_wdactivelist);
-        }
-      else
-        {
-          /* Remove the watchdog at the head of the queue */
-
-          sq_remfirst(&g_wdactivelist);
-
-          /* Reassess the interval timer that will generate the next
-           * interval event.
-           */
-
           nxsched_reassess_timer();
         }
 
@@ -133,6 +192,14 @@ int wd_cancel(FAR struct wdog_s *wdog)
       ret = OK;
     }
 
-  leave_critical_section(flags);
+  wd_unlock(flags);
+
+#if defined(CONFIG_SMP) && !defined(CONFIG_SCHED_TICKLESS)
+  if (csection)
+    {
+      leave_critical_section(csflags);
+    }
+#endif
+
   return ret;
 }
@@ -56,9 +56,17 @@ sclock_t wd_gettime(FAR struct wdog_s *wdog)
 
   /* Verify the wdog */
 
-  flags = enter_critical_section();
+  flags = wd_lock();
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_RBTREE
+      /* The remaining time follows directly from the expiration time */
+
+      sclock_t delay = wdog->expired - g_wdtickbase - wd_elapse();
+
+      wd_unlock(flags);
+      return delay;
+#else
       /* Traverse the watchdog list accumulating lag times until we find the
        * wdog that we are looking for
        */
@@ -74,12 +82,13 @@ sclock_t wd_gettime(FAR struct wdog_s *wdog)
           if (curr == wdog)
             {
               delay -= wd_elapse();
-              leave_critical_section(flags);
+              wd_unlock(flags);
               return delay;
             }
         }
+#endif
     }
 
-  leave_critical_section(flags);
+  wd_unlock(flags);
   return 0;
 }
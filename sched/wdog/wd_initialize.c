@@ -32,21 +32,69 @@
  * Public Data
  ****************************************************************************/
 
+#ifdef CONFIG_WDOG_RBTREE
+/* The g_wdactivetree data structure is a red-black tree ordered by watchdog
+ * expiration time and g_wdactivehead caches its leftmost (earliest) node.
+ */
+
+struct wdog_tree_s g_wdactivetree = RB_INITIALIZER(&g_wdactivetree);
+FAR struct wdog_s *g_wdactivehead;
+#else
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 sq_queue_t g_wdactivelist;
+#endif
 
 /* This is wdog tickbase, for wd_gettime() may called many times
  * between 2 times of wd_timer(), we use it to update wd_gettime().
  */
 
-#ifdef CONFIG_SCHED_TICKLESS
+#if defined(CONFIG_SCHED_TICKLESS) || defined(CONFIG_WDOG_RBTREE)
 clock_t g_wdtickbase;
 #endif
 
+#if defined(CONFIG_SMP) && !defined(CONFIG_SCHED_TICKLESS)
+/* This spinlock protects the active watchdog queue (see wd_lock()) */
+
+spinlock_t g_wdspinlock = SP_UNLOCKED;
+
+/* The watchdog whose function is running (see wd_cancel()) */
+
+FAR struct wdog_s *g_wdrunning;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_RBTREE
+/****************************************************************************
+ * Name: wd_compare
+ *
+ * Description:
+ *   Order two watchdogs by expiration time.  Zero is never returned for
+ *   distinct watchdogs: a watchdog being inserted sorts after any active
+ *   watchdog with the same expiration time so that they expire in FIFO
+ *   order.
+ *
+ ****************************************************************************/
+
+static int wd_compare(FAR struct wdog_s *wdog1, FAR struct wdog_s *wdog2)
+{
+  if (wdog1 == wdog2)
+    {
+      return 0;
+    }
+
+  return wd_before(wdog1, wdog2) ? -1 : 1;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
+
+RB_GENERATE(wdog_tree_s, wdog_s, node, wd_compare);
+#endif
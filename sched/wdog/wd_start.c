@@ -80,19 +80,54 @@
  *   Check if the timer for the watchdog at the head of list is ready to
  *   run. If so, remove the watchdog from the list and execute it.
  *
+ *   The watchdog lock is released while each watchdog function runs so
+ *   that the function may restart or cancel watchdogs.
+ *
  * Input Parameters:
- *   None
+ *   flags - The interrupt state returned when the watchdog lock was taken
  *
  * Returned Value:
  *   None
  *
+ * Assumptions:
+ *   The caller holds the watchdog lock (see wd_lock()).
+ *
  ****************************************************************************/
 
-static inline void wd_expiration(void)
+static inline void wd_expiration(irqstate_t flags)
 {
   FAR struct wdog_s *wdog;
+  wdparm_t arg;
   wdentry_t func;
 
+#ifdef CONFIG_WDOG_RBTREE
+  /* Process the earliest watchdog as well as any other watchdogs that
+   * became ready to run at this time
+   */
+
+  while ((wdog = g_wdactivehead) != NULL &&
+         (sclock_t)(wdog->expired - g_wdtickbase) <= 0)
+    {
+      /* Remove the watchdog from the tree */
+
+      wd_remove(wdog);
+
+      /* Indicate that the watchdog is no longer active. */
+
+      func = wdog->func;
+      arg  = wdog->arg;
+      wdog->func = NULL;
+
+      /* Execute the watchdog function */
+
+      up_setpicbase(wdog->picbase);
+      wd_setrunning(wdog);
+      wd_unlock(flags);
+      CALL_FUNC(func, arg);
+      flags = wd_lock();
+      wd_setrunning(NULL);
+    }
+#else
   /* Process the watchdog at the head of the list as well as any
    * other watchdogs that became ready to run at this time
    */
@@ -116,13 +151,19 @@ static inline void wd_expiration(void)
       /* Indicate that the watchdog is no longer active. */
 
       func = wdog->func;
+      arg  = wdog->arg;
       wdog->func = NULL;
 
       /* Execute the watchdog function */
 
       up_setpicbase(wdog->picbase);
-      CALL_FUNC(func, wdog->arg);
+      wd_setrunning(wdog);
+      wd_unlock(flags);
+      CALL_FUNC(func, arg);
+      flags = wd_lock();
+      wd_setrunning(NULL);
     }
+#endif
 }
 
 /****************************************************************************
@@ -168,10 +209,12 @@ static inline void wd_expiration(void)
 int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
              wdentry_t wdentry, wdparm_t arg)
 {
+#ifndef CONFIG_WDOG_RBTREE
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
   FAR struct wdog_s *next;
   sclock_t now;
+#endif
   irqstate_t flags;
 
   /* Verify the wdog and setup parameters */
@@ -184,13 +227,13 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
   /* Check if the watchdog has been started. If so, stop it.
    * NOTE:  There is a race condition here... the caller may receive
    * the watchdog between the time that wd_start is called and
-   * the critical section is established.
+   * the watchdog lock is taken.
    */
 
-  flags = enter_critical_section();
-  if (WDOG_ISACTIVE(wdog))
+  flags = wd_lock();
+  if (WDOG_ISACTIVE(wdog) && wd_dequeue(wdog))
     {
-      wd_cancel(wdog);
+      nxsched_reassess_timer();
     }
 
   /* Save the data in the watchdog structure */
@@ -233,6 +276,21 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
   nxsched_cancel_timer();
 #endif
 
+#ifdef CONFIG_WDOG_RBTREE
+#ifdef CONFIG_SCHED_TICKLESS
+  if (g_wdactivehead == NULL)
+    {
+      /* Update clock tickbase */
+
+      g_wdtickbase = clock_systime_ticks();
+    }
+#endif
+
+  /* Record the absolute expiration time and add the watchdog to the tree */
+
+  wdog->expired = g_wdtickbase + delay;
+  wd_insert(wdog);
+#else
   /* Do the easy case first -- when the watchdog timer queue is empty. */
 
   if (g_wdactivelist.head == NULL)
@@ -326,6 +384,7 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
   /* Put the lag into the watchdog structure and mark it as active. */
 
   wdog->lag = delay;
+#endif
 
 #ifdef CONFIG_SCHED_TICKLESS
   /* Resume the interval timer that will generate the next interval event.
@@ -336,7 +395,7 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
   nxsched_resume_timer();
 #endif
 
-  leave_critical_section(flags);
+  wd_unlock(flags);
   return OK;
 }
 
@@ -369,14 +428,20 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
 #ifdef CONFIG_SCHED_TICKLESS
 unsigned int wd_timer(int ticks, bool noswitches)
 {
+#ifndef CONFIG_WDOG_RBTREE
   FAR struct wdog_s *wdog;
-  unsigned int ret;
   int decr;
+#endif
+  irqstate_t flags;
+  unsigned int ret;
+
+  flags = wd_lock();
 
   /* Update clock tickbase */
 
   g_wdtickbase += ticks;
 
+#ifndef CONFIG_WDOG_RBTREE
   /* Check if there are any active watchdogs to process */
 
   wdog = (FAR struct wdog_s *)g_wdactivelist.head;
@@ -393,18 +458,26 @@ unsigned int wd_timer(int ticks, bool noswitches)
 
       wdog = wdog->next;
     }
+#endif
 
   /* Check if the watchdog at the head of the list is ready to run */
 
   if (!noswitches)
     {
-      wd_expiration();
+      wd_expiration(flags);
     }
 
   /* Return the delay for the next watchdog to expire */
 
+#ifdef CONFIG_WDOG_RBTREE
+  ret = g_wdactivehead ?
+        MAX((sclock_t)(g_wdactivehead->expired - g_wdtickbase), 1) : 0;
+#else
   ret = g_wdactivelist.head ?
         MAX(((FAR struct wdog_s *)g_wdactivelist.head)->lag, 1) : 0;
+#endif
+
+  wd_unlock(flags);
 
   /* Return the delay for the next watchdog to expire */
 
@@ -414,6 +487,16 @@ unsigned int wd_timer(int ticks, bool noswitches)
 #else
 void wd_timer(void)
 {
+  irqstate_t flags;
+
+  flags = wd_lock();
+
+#ifdef CONFIG_WDOG_RBTREE
+  /* Advance the tickbase and run any watchdogs that have expired */
+
+  g_wdtickbase++;
+  wd_expiration(flags);
+#else
   /* Check if there are any active watchdogs to process */
 
   if (g_wdactivelist.head)
@@ -424,7 +507,10 @@ void wd_timer(void)
 
       /* Check if the watchdog at the head of the list is ready to run */
 
-      wd_expiration();
+      wd_expiration(flags);
     }
+#endif
+
+  wd_unlock(flags);
 }
 #endif /* CONFIG_SCHED_TICKLESS */
@@ -32,7 +32,9 @@
 
 #include <nuttx/compiler.h>
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
 #include <nuttx/queue.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/wdog.h>
 
 /****************************************************************************
@@ -56,6 +58,47 @@
 #  define wd_elapse() (0)
 #endif
 
+/* Watchdog expiration times are compared as signed differences so that the
+ * ordering remains correct when the tick counter wraps around.
+ */
+
+#ifdef CONFIG_WDOG_RBTREE
+#  define wd_before(a, b) ((sclock_t)((a)->expired - (b)->expired) < 0)
+#endif
+
+/* In the SMP case the active watchdog queue is protected by its own
+ * spinlock so that starting and cancelling timers does not contend for the
+ * global critical section.  Tickless mode still needs the critical section
+ * because changing the queue head also reprograms the interval timer.
+ */
+
+#if defined(CONFIG_SMP) && !defined(CONFIG_SCHED_TICKLESS)
+#  define wd_lock()        spin_lock_irqsave(&g_wdspinlock)
+#  define wd_unlock(flags) spin_unlock_irqrestore(&g_wdspinlock, flags)
+#else
+#  define wd_lock()        enter_critical_section()
+#  define wd_unlock(flags) leave_critical_section(flags)
+#endif
+
+/* Watchdog functions are called without the watchdog lock.  In the SMP
+ * case wd_cancel() then needs to know which watchdog function is running
+ * (see g_wdrunning).
+ */
+
+#if defined(CONFIG_SMP) && !defined(CONFIG_SCHED_TICKLESS)
+#  define wd_setrunning(w) (g_wdrunning = (w))
+#else
+#  define wd_setrunning(w)
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_RBTREE
+RB_HEAD(wdog_tree_s, wdog_s);
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -68,25 +111,120 @@ extern "C"
 #define EXTERN extern
 #endif
 
+#ifdef CONFIG_WDOG_RBTREE
+/* The g_wdactivetree data structure is a red-black tree ordered by watchdog
+ * expiration time and g_wdactivehead caches its leftmost (earliest) node.
+ * When watchdog timers expire, they are removed from the tree and their
+ * functions are called.
+ */
+
+extern struct wdog_tree_s g_wdactivetree;
+extern FAR struct wdog_s *g_wdactivehead;
+#else
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 extern sq_queue_t g_wdactivelist;
+#endif
 
 /* This is wdog tickbase, for wd_gettime() may called many times
  * between 2 times of wd_timer(), we use it to update wd_gettime().
+ * The red-black tree also uses it as the time origin for the absolute
+ * expiration ticks.
  */
 
-#ifdef CONFIG_SCHED_TICKLESS
+#if defined(CONFIG_SCHED_TICKLESS) || defined(CONFIG_WDOG_RBTREE)
 extern clock_t g_wdtickbase;
 #endif
 
+#if defined(CONFIG_SMP) && !defined(CONFIG_SCHED_TICKLESS)
+/* This spinlock protects the active watchdog queue (see wd_lock()) */
+
+extern spinlock_t g_wdspinlock;
+
+/* The watchdog whose function is running.  Watchdog functions are called
+ * within the critical section, so there is at most one.  Protected by the
+ * watchdog lock.
+ */
+
+extern FAR struct wdog_s *g_wdrunning;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
+#ifdef CONFIG_WDOG_RBTREE
+RB_PROTOTYPE(wdog_tree_s, wdog_s, node, wd_compare);
+
+/****************************************************************************
+ * Name: wd_insert
+ *
+ * Description:
+ *   Insert a watchdog into the active watchdog tree, keeping the cached
+ *   earliest watchdog up to date.  Watchdogs with the same expiration time
+ *   expire in the order they were inserted.
+ *
+ * Assumptions:
+ *   The caller holds the watchdog lock (see wd_lock()).
+ *
+ ****************************************************************************/
+
+static inline void wd_insert(FAR struct wdog_s *wdog)
+{
+  RB_INSERT(wdog_tree_s, &g_wdactivetree, wdog);
+
+  if (g_wdactivehead == NULL || wd_before(wdog, g_wdactivehead))
+    {
+      g_wdactivehead = wdog;
+    }
+}
+
+/****************************************************************************
+ * Name: wd_remove
+ *
+ * Description:
+ *   Remove a watchdog from the active watchdog tree, keeping the cached
+ *   earliest watchdog up to date.
+ *
+ * Assumptions:
+ *   The caller holds the watchdog lock (see wd_lock()).
+ *
+ ****************************************************************************/
+
+static inline void wd_remove(FAR struct wdog_s *wdog)
+{
+  if (wdog == g_wdactivehead)
+    {
+      g_wdactivehead = RB_NEXT(wdog_tree_s, &g_wdactivetree, wdog);
+    }
+
+  RB_REMOVE(wdog_tree_s, &g_wdactivetree, wdog);
+}
+#endif
+
+/****************************************************************************
+ * Name: wd_dequeue
+ *
+ * Description:
+ *   Remove an active watchdog from the timer queue without marking it
+ *   inactive.
+ *
+ * Input Parameters:
+ *   wdog - The active watchdog to remove
+ *
+ * Returned Value:
+ *   true if the watchdog was at the head of the timer queue.
+ *
+ * Assumptions:
+ *   The caller holds the watchdog lock (see wd_lock()).
+ *
+ ****************************************************************************/
+
+bool wd_dequeue(FAR struct wdog_s *wdog);
+
 /****************************************************************************
  * Name: wd_timer
  *